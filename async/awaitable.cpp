@@ -0,0 +1,48 @@
+#include "awaitable.hpp"
+
+#include "misc/critical_section.hpp"
+
+namespace Async {
+    namespace {
+        /**
+         * @brief   Return register address as big endian bytes
+         */
+        Byte_vector Address_bytes(uint16_t address, uint8_t address_size){
+            Byte_vector bytes(address_size);
+            for (uint8_t i = 0; i < address_size; i++) {
+                bytes[i] = static_cast<uint8_t>(address >> (8 * (address_size - 1 - i)));
+            }
+            return bytes;
+        }
+    }
+
+    Task<std::optional<Byte_vector>> Read(I2C_device &device, uint16_t address, uint8_t address_size, unsigned int length){
+        // Result is stored before test, GCC 12 builds invalid frame for co_await of temporary in condition
+        bool addressed = co_await I2C_transmit(device.Master(), device.Address(), Address_bytes(address, address_size));
+        if (!addressed) {
+            co_return std::nullopt;
+        }
+        co_return co_await I2C_receive(device.Master(), device.Address(), length);
+    }
+
+    Task<bool> Write(I2C_device &device, uint16_t address, uint8_t address_size, Byte_vector data){
+        Byte_vector frame = Address_bytes(address, address_size);
+        frame.insert(frame.end(), data.begin(), data.end());
+        co_return co_await I2C_transmit(device.Master(), device.Address(), std::move(frame));
+    }
+
+    bool Line::Start(){
+        // Line received between check and registration of callback would not be notified
+        Critical_section section;
+        if (line.Line_available(delimiter)) {
+            return false;
+        }
+        line.Line_notification(delimiter, this);
+        return true;
+    }
+
+    Serial_line::Text Line::await_resume(){
+        line.Line_notification(delimiter, nullptr);
+        return line.Read(delimiter);
+    }
+}
@@ -0,0 +1,207 @@
+/**
+ * @file awaitable.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <optional>
+#include <string_view>
+
+#include "async/scheduler.hpp"
+#include "async/task.hpp"
+#include "i2c/i2c_device.hpp"
+#include "rtc/rtc_timer.hpp"
+#include "spi/spi_device.hpp"
+#include "uart/serial_line.hpp"
+
+/**
+ * @brief   Awaitables of drivers, operations are started in interrupt or DMA mode and coroutine is suspended until completion
+ *          Awaitable must be awaited directly (co_await Async::Sleep_for(wheel, 10)), it lives in frame of coroutine
+ *          Example of one-shot measurement of TMP117 without blocking:
+ *              Async::Task<std::optional<int16_t>> Measure(I2C_device &sensor, RTC_timer_wheel &wheel){
+ *                  Byte_vector one_shot = {0x0c, 0x00};
+ *                  bool configured = co_await Async::Write(sensor, 0x01, 1, one_shot);
+ *                  if (!configured) {
+ *                      co_return std::nullopt;
+ *                  }
+ *                  co_await Async::Sleep_for(wheel, 16);
+ *                  auto data = co_await Async::Read(sensor, 0x00, 1, 2);
+ *                  if (!data) {
+ *                      co_return std::nullopt;
+ *                  }
+ *                  co_return static_cast<int16_t>(((*data)[0] << 8) | (*data)[1]);
+ *              }
+ */
+namespace Async {
+    /**
+     * @brief   Transmit data to I2C device in interrupt mode
+     *          co_await returns true if data were acknowledged
+     */
+    class I2C_transmit : public Completion<bool> {
+    private:
+        const I2C_master &master;
+        uint8_t address;
+        Byte_vector data;
+
+        bool Start() override { return master.Transmit_IT(address, data.data(), data.size(), this); };
+
+    public:
+        /**
+         * @brief Construct a new I2C_transmit object
+         *
+         * @param master    Bus of device
+         * @param address   Address of device in 8-bit format
+         * @param data      Data to transmit
+         */
+        I2C_transmit(const I2C_master &master, uint8_t address, Byte_vector data) :
+            master(master), address(address), data(std::move(data))
+        { }
+
+        bool await_resume() const { return result; };
+    };
+
+    /**
+     * @brief   Receive data from I2C device in interrupt mode
+     *          co_await returns received data, empty if transfer failed
+     */
+    class I2C_receive : public Completion<bool> {
+    private:
+        const I2C_master &master;
+        uint8_t address;
+        Byte_vector data;
+
+        bool Start() override { return master.Receive_IT(address, data.data(), data.size(), this); };
+
+    public:
+        /**
+         * @brief Construct a new I2C_receive object
+         *
+         * @param master    Bus of device
+         * @param address   Address of device in 8-bit format
+         * @param length    Number of bytes to receive
+         */
+        I2C_receive(const I2C_master &master, uint8_t address, unsigned int length) :
+            master(master), address(address), data(length)
+        { }
+
+        std::optional<Byte_vector> await_resume(){
+            if (!result) {
+                return {};
+            }
+            return std::move(data);
+        };
+    };
+
+    /**
+     * @brief   Read registers of I2C device, address is transmitted and then data are received
+     *
+     * @param device        I2C device
+     * @param address       Address of first register
+     * @param address_size  Size of register address in bytes, transmitted as big endian
+     * @param length        Number of bytes to read
+     * @return Task<std::optional<Byte_vector>>   Received data, empty if transfer failed
+     */
+    Task<std::optional<Byte_vector>> Read(I2C_device &device, uint16_t address, uint8_t address_size, unsigned int length);
+
+    /**
+     * @brief   Write registers of I2C device in one transfer
+     *
+     * @param device        I2C device
+     * @param address       Address of first register
+     * @param address_size  Size of register address in bytes, transmitted as big endian
+     * @param data          Data to write
+     * @return Task<bool>   True if all data were acknowledged
+     */
+    Task<bool> Write(I2C_device &device, uint16_t address, uint8_t address_size, Byte_vector data);
+
+    /**
+     * @brief   Read registers of SPI device by DMA
+     *          co_await returns received data, empty if transfer failed
+     */
+    class SPI_read : public Completion<bool> {
+    private:
+        SPI_device &device;
+        uint16_t address;
+        uint8_t address_size;
+        uint16_t length;
+
+        bool Start() override { return device.Read_DMA(address, address_size, length, this); };
+
+    public:
+        /**
+         * @brief Construct a new SPI_read object
+         *
+         * @param device        SPI device
+         * @param address       Address of first register
+         * @param address_size  Size of register address in bytes
+         * @param length        Number of bytes to read
+         */
+        SPI_read(SPI_device &device, uint16_t address, uint8_t address_size, uint16_t length) :
+            device(device), address(address), address_size(address_size), length(length)
+        { }
+
+        std::optional<Byte_vector> await_resume() const {
+            if (!result) {
+                return {};
+            }
+            return Byte_vector(device.Data(), device.Data() + length);
+        };
+    };
+
+    /**
+     * @brief   Wait for line terminated by delimiter
+     *          co_await returns line including delimiter, coroutine is not suspended if line is already received
+     */
+    class Line : public Completion<void> {
+    private:
+        Serial_line &line;
+        Serial_line::Delimiter delimiter;
+
+        bool Start() override;
+
+    public:
+        /**
+         * @brief Construct a new Line object
+         *
+         * @param line      Serial line, its notification callback is used while coroutine waits
+         * @param delimiter Delimiter which borders line
+         */
+        Line(Serial_line &line, std::string_view delimiter = "\r\n") :
+            line(line), delimiter(delimiter)
+        { }
+
+        Serial_line::Text await_resume();
+    };
+
+    /**
+     * @brief   Suspend coroutine for given time, MCU can sleep meanwhile
+     *          Coroutine continues after RTC_timer_wheel::Dispatch() handles expiration
+     */
+    class Sleep_for : public Completion<void> {
+    private:
+        RTC_timer_wheel &wheel;
+        uint32_t delay;
+        RTC_timer timer;
+
+        bool Start() override {
+            wheel.Start(timer, delay);
+            return true;
+        };
+
+    public:
+        /**
+         * @brief Construct a new Sleep_for object
+         *
+         * @param wheel Timer wheel driven by RTC
+         * @param delay Delay in ms, rounded up to ticks of wheel
+         */
+        Sleep_for(RTC_timer_wheel &wheel, uint32_t delay) :
+            wheel(wheel), delay(delay), timer(this)
+        { }
+
+        void await_resume() const noexcept { };
+    };
+}
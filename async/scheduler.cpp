@@ -0,0 +1,46 @@
+#include "scheduler.hpp"
+
+#include "misc/critical_section.hpp"
+#include "power/run_loop.hpp"
+
+namespace Async {
+    bool Scheduler::Ready(std::coroutine_handle<> handle){
+        {
+            Critical_section section;
+            if (static_cast<uint16_t>(head - tail) >= size) {
+                return false;
+            }
+            ready[head & (size - 1)] = handle;
+            head = head + 1;
+        }
+        if (loop) {
+            loop->Wake();
+        }
+        return true;
+    }
+
+    bool Scheduler::Spawn(Task<void> &&task){
+        std::coroutine_handle<> handle = task.Detach();
+        if (!handle) {
+            return false;
+        }
+        return Ready(handle);
+    }
+
+    unsigned int Scheduler::Run(){
+        uint16_t end = head;
+        unsigned int count = 0;
+        while (tail != end) {
+            std::coroutine_handle<> handle = ready[tail & (size - 1)];
+            tail = tail + 1;
+            handle.resume();
+            count++;
+        }
+        return count;
+    }
+
+    bool Scheduler::Attach(Run_loop &loop){
+        Scheduler::loop = &loop;
+        return loop.Register(&poller);
+    }
+}
@@ -0,0 +1,177 @@
+/**
+ * @file scheduler.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <coroutine>
+#include <cstdint>
+
+#include "async/task.hpp"
+#include "misc/invocation_wrapper.hpp"
+
+/**
+ * @brief   Size of queue of ready coroutines, power of two
+ *          Every coroutine is queued at most once, so queue never overflows if it is not smaller than pool of frames
+ */
+#ifndef HALUP_ASYNC_READY
+#define HALUP_ASYNC_READY 32
+#endif
+
+class Run_loop;
+
+namespace Async {
+    /**
+     * @brief   Resumes coroutines from main loop
+     *          Completion callbacks of drivers are invoked from IRQ, they only mark waiting coroutine as ready,
+     *              coroutine continues when Run() is called from main loop, so drivers are never called from IRQ by coroutine
+     *          Scheduler can be polled by Run_loop, loop is woken when coroutine becomes ready:
+     *              Async::Scheduler::Attach(loop);
+     *              Async::Scheduler::Spawn(Measure(sensor));
+     *              while (true) { loop.Iterate(); }
+     */
+    class Scheduler {
+    public:
+        static constexpr uint16_t size = HALUP_ASYNC_READY;
+
+        static_assert((size & (size - 1)) == 0, "Size of ready queue must be power of two");
+        static_assert(size >= Frame_pool::frames, "Ready queue must be able to hold every coroutine of pool");
+
+    private:
+        static inline std::coroutine_handle<> ready[size] = {};
+
+        /**
+         * @brief   Indexes of queue, head is written by Ready() (IRQ), tail by Run() (main loop)
+         */
+        static inline volatile uint16_t head = 0;
+        static inline volatile uint16_t tail = 0;
+
+        /**
+         * @brief   Loop which is woken when coroutine becomes ready, can be nullptr
+         */
+        static inline Run_loop *loop = nullptr;
+
+        /**
+         * @brief   Task of Run_loop which runs scheduler
+         */
+        class Poller : public Invocation_wrapper_base<bool, void> {
+        public:
+            bool Invoke() const override { return Run() > 0; };
+        };
+
+        static inline Poller poller;
+
+    public:
+        /**
+         * @brief   Mark coroutine as ready to continue, can be called from IRQ
+         *
+         * @return false    Queue is full
+         */
+        static bool Ready(std::coroutine_handle<> handle);
+
+        /**
+         * @brief   Start coroutine which is not owned by application, frame is released after it finishes
+         *
+         * @return false    Task is invalid (pool of frames is exhausted)
+         */
+        static bool Spawn(Task<void> &&task);
+
+        /**
+         * @brief   Resume coroutines which were ready at the time of call, must be called from main loop
+         *          Coroutines which become ready meanwhile are resumed by next call
+         *
+         * @return unsigned int Number of resumed coroutines
+         */
+        static unsigned int Run();
+
+        /**
+         * @brief   Return true if no coroutine is ready
+         */
+        static bool Idle(){ return head == tail; };
+
+        /**
+         * @brief   Register scheduler as task of run loop, loop is woken by Ready()
+         *
+         * @return false    Loop has no space for task
+         */
+        static bool Attach(Run_loop &loop);
+    };
+
+    /**
+     * @brief   Base of awaitables completed by callback of driver, callback resumes coroutine through Scheduler
+     *          Derived awaitable starts operation in Start(), operation must invoke Invoke() with result once
+     *
+     * @tparam Arg  Type of result passed to callback
+     */
+    template <typename Arg>
+    class Completion : public Invocation_wrapper_base<void, Arg> {
+    protected:
+        mutable std::coroutine_handle<> waiting;
+        mutable Arg result{};
+        mutable volatile bool done = false;
+
+        /**
+         * @brief   Start operation, callback of operation is this object
+         *
+         * @return false    Operation could not be started, coroutine continues with default result
+         */
+        virtual bool Start() = 0;
+
+    public:
+        void Invoke(Arg arg) const override {
+            result = arg;
+            done = true;
+            if (waiting) {
+                Scheduler::Ready(waiting);
+            }
+        }
+
+        bool await_ready() const noexcept { return false; };
+
+        bool await_suspend(std::coroutine_handle<> handle){
+            waiting = handle;
+            return Start();
+        }
+    };
+
+    /**
+     * @brief   Completion without result
+     */
+    template <>
+    class Completion<void> : public Invocation_wrapper_base<void, void> {
+    protected:
+        mutable std::coroutine_handle<> waiting;
+        mutable volatile bool done = false;
+
+        virtual bool Start() = 0;
+
+    public:
+        void Invoke() const override {
+            done = true;
+            if (waiting) {
+                Scheduler::Ready(waiting);
+            }
+        }
+
+        bool await_ready() const noexcept { return false; };
+
+        bool await_suspend(std::coroutine_handle<> handle){
+            waiting = handle;
+            return Start();
+        }
+    };
+
+    /**
+     * @brief   Let other ready coroutines run, coroutine continues by next Scheduler::Run()
+     */
+    struct Yield {
+        bool await_ready() const noexcept { return false; };
+
+        void await_suspend(std::coroutine_handle<> handle) const { Scheduler::Ready(handle); };
+
+        void await_resume() const noexcept { };
+    };
+}
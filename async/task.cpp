@@ -0,0 +1,37 @@
+#include "task.hpp"
+
+#include "misc/critical_section.hpp"
+
+namespace Async {
+    void *Frame_pool::Allocate(size_t size) noexcept {
+
+        if (size > frame_size) {
+            failures++;
+            return nullptr;
+        }
+        Critical_section section;
+        for (size_t i = 0; i < frames; i++) {
+            if (used & (1UL << i)) {
+                continue;
+            }
+            used |= 1UL << i;
+            uint8_t count = __builtin_popcount(used);
+            if (count > peak) {
+                peak = count;
+            }
+            return storage[i];
+        }
+        failures++;
+        return nullptr;
+    }
+
+    void Frame_pool::Release(void *frame) noexcept {
+        size_t index = (static_cast<uint8_t *>(frame) - &storage[0][0]) / frame_size;
+        Critical_section section;
+        used &= ~(1UL << index);
+    }
+
+    uint8_t Frame_pool::Used(){
+        return __builtin_popcount(used);
+    }
+}
@@ -0,0 +1,305 @@
+/**
+ * @file task.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#if __cplusplus < 202002L
+#error "Coroutines of halup require C++20 (-std=c++20)"
+#endif
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief   Number of coroutine frames in static pool, at most 32
+ */
+#ifndef HALUP_ASYNC_FRAMES
+#define HALUP_ASYNC_FRAMES 8
+#endif
+
+/**
+ * @brief   Size of one coroutine frame in bytes, coroutine with larger frame cannot be created
+ */
+#ifndef HALUP_ASYNC_FRAME_SIZE
+#define HALUP_ASYNC_FRAME_SIZE 512
+#endif
+
+namespace Async {
+    /**
+     * @brief   Static pool of coroutine frames, coroutines never allocate from heap
+     *          Creation of coroutine fails when pool is exhausted or frame is too large, Task is then invalid
+     */
+    class Frame_pool {
+    public:
+        static constexpr size_t frames = HALUP_ASYNC_FRAMES;
+        static constexpr size_t frame_size = HALUP_ASYNC_FRAME_SIZE;
+
+        static_assert(frames > 0 && frames <= 32, "Pool of coroutine frames must have 1 to 32 frames");
+
+    private:
+        alignas(std::max_align_t) static inline uint8_t storage[frames][frame_size];
+
+        /**
+         * @brief   Bitmap of used frames
+         */
+        static inline uint32_t used = 0;
+
+        /**
+         * @brief   Maximal number of frames used at once
+         */
+        static inline uint8_t peak = 0;
+
+        /**
+         * @brief   Number of refused allocations
+         */
+        static inline uint32_t failures = 0;
+
+    public:
+        /**
+         * @brief   Return free frame, nullptr if pool is exhausted or size is larger than frame
+         */
+        static void *Allocate(size_t size) noexcept;
+
+        /**
+         * @brief   Return frame to pool
+         */
+        static void Release(void *frame) noexcept;
+
+        /**
+         * @brief   Return number of used frames
+         */
+        static uint8_t Used();
+
+        static uint8_t Peak(){ return peak; };
+
+        static uint32_t Failures(){ return failures; };
+    };
+
+    template <typename T = void>
+    class Task;
+
+    namespace Detail {
+        /**
+         * @brief   Part of promise independent of type of result
+         *          Coroutine starts suspended, at final suspension it resumes awaiting coroutine (symmetric transfer)
+         *              or destroys itself if it was detached
+         */
+        struct Promise_base {
+            /**
+             * @brief   Coroutine which awaits result of this coroutine
+             */
+            std::coroutine_handle<> continuation;
+
+            /**
+             * @brief   Coroutine is not owned by Task, frame is released after completion
+             */
+            bool detached = false;
+
+            /**
+             * @brief   Coroutine was already resumed from initial suspension
+             */
+            bool started = false;
+
+            struct Final {
+                bool await_ready() const noexcept { return false; };
+
+                template <typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                    Promise_base &promise = handle.promise();
+                    if (promise.continuation) {
+                        return promise.continuation;
+                    }
+                    if (promise.detached) {
+                        handle.destroy();
+                    }
+                    return std::noop_coroutine();
+                };
+
+                void await_resume() const noexcept { };
+            };
+
+            static void *operator new(size_t size) noexcept { return Frame_pool::Allocate(size); };
+
+            static void operator delete(void *frame) noexcept { Frame_pool::Release(frame); };
+
+            std::suspend_always initial_suspend() const noexcept { return {}; };
+
+            Final final_suspend() const noexcept { return {}; };
+
+            /**
+             * @brief   Library is used without exceptions, exception escaping coroutine is fatal
+             */
+            void unhandled_exception() const noexcept { std::terminate(); };
+        };
+
+        template <typename T>
+        struct Promise : Promise_base {
+            std::optional<T> value;
+
+            Task<T> get_return_object() noexcept;
+
+            static Task<T> get_return_object_on_allocation_failure() noexcept;
+
+            template <typename U>
+            void return_value(U &&result){ value.emplace(std::forward<U>(result)); };
+        };
+
+        template <>
+        struct Promise<void> : Promise_base {
+            Task<void> get_return_object() noexcept;
+
+            static Task<void> get_return_object_on_allocation_failure() noexcept;
+
+            void return_void() const noexcept { };
+        };
+    }
+
+    /**
+     * @brief   Coroutine which returns value of type T, frame is allocated from Frame_pool
+     *          Coroutine starts when task is awaited by other coroutine, by Start() or when it is passed to Scheduler::Spawn()
+     *          Example:
+     *              Async::Task<std::optional<float>> Measure(TMP117 &sensor);
+     *              auto temperature = co_await Measure(sensor);
+     *
+     * @tparam T    Type of result, void for coroutines without result
+     */
+    template <typename T>
+    class Task {
+    public:
+        using promise_type = Detail::Promise<T>;
+        using handle_type = std::coroutine_handle<promise_type>;
+
+    private:
+        handle_type handle;
+
+    public:
+        Task() = default;
+
+        explicit Task(handle_type handle) :
+            handle(handle)
+        { }
+
+        Task(Task &&other) noexcept :
+            handle(std::exchange(other.handle, nullptr))
+        { }
+
+        Task &operator=(Task &&other) noexcept {
+            if (this != &other) {
+                if (handle) {
+                    handle.destroy();
+                }
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+
+        ~Task(){
+            if (handle) {
+                handle.destroy();
+            }
+        }
+
+        /**
+         * @brief   Return false if frame of coroutine could not be allocated
+         */
+        bool Valid() const { return static_cast<bool>(handle); };
+
+        /**
+         * @brief   Return true if coroutine finished, invalid task is never done
+         */
+        bool Done() const { return handle && handle.done(); };
+
+        /**
+         * @brief   Run coroutine until its first suspension, task must stay alive until it is done
+         *          Task which was already started or awaited is not resumed again
+         */
+        void Start(){
+            if (handle && !handle.promise().started) {
+                handle.promise().started = true;
+                handle.resume();
+            }
+        }
+
+        /**
+         * @brief   Return result of finished coroutine
+         */
+        template <typename U = T, typename = std::enable_if_t<!std::is_void_v<U>>>
+        const std::optional<U> &Result() const { return handle.promise().value; };
+
+        /**
+         * @brief   Release ownership of coroutine, frame is released by coroutine after it finishes
+         *
+         * @return std::coroutine_handle<>  Handle of coroutine, empty for invalid task
+         */
+        std::coroutine_handle<> Detach(){
+            if (!handle) {
+                return {};
+            }
+            handle.promise().detached = true;
+            return std::exchange(handle, nullptr);
+        }
+
+        /**
+         * @brief   Awaiting coroutine is suspended until task finishes
+         *          Awaiting of invalid task finishes immediately with default value of result
+         */
+        auto operator co_await() && noexcept {
+            struct Awaiter {
+                handle_type handle;
+
+                bool await_ready() const noexcept { return !handle || handle.done(); };
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                    handle.promise().continuation = awaiting;
+                    if (handle.promise().started) {  // Already running, awaiting coroutine is resumed at its end
+                        return std::noop_coroutine();
+                    }
+                    handle.promise().started = true;
+                    return handle;
+                };
+
+                T await_resume(){
+                    if constexpr (!std::is_void_v<T>) {
+                        if (!handle || !handle.promise().value) {
+                            return T{};
+                        }
+                        return std::move(*handle.promise().value);
+                    }
+                };
+            };
+            return Awaiter{handle};
+        }
+    };
+
+    namespace Detail {
+        template <typename T>
+        Task<T> Promise<T>::get_return_object() noexcept {
+            return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+        }
+
+        template <typename T>
+        Task<T> Promise<T>::get_return_object_on_allocation_failure() noexcept {
+            return Task<T>();
+        }
+
+        inline Task<void> Promise<void>::get_return_object() noexcept {
+            return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+        }
+
+        inline Task<void> Promise<void>::get_return_object_on_allocation_failure() noexcept {
+            return Task<void>();
+        }
+    }
+}
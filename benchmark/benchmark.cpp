@@ -0,0 +1,199 @@
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+
+#include "host/virtual_clock.hpp"
+
+void *operator new(std::size_t size){
+    Benchmark::allocations++;
+    Benchmark::allocated += size;
+    void *pointer = std::malloc(size ? size : 1);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void *operator new[](std::size_t size){
+    return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept{
+    if (pointer) {
+        Benchmark::deallocations++;
+    }
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept{
+    operator delete(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept{
+    operator delete(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept{
+    operator delete(pointer);
+}
+
+Benchmark::Benchmark(uint32_t batch_size, uint32_t batches) :
+    batch_size(std::max<uint32_t>(batch_size, 1)), batches(std::max<uint32_t>(batches, 1))
+{ }
+
+void Benchmark::Register(const std::string &name, std::function<void()> operation, std::function<void(uint32_t)> prepare){
+    cases.push_back({name, std::move(operation), std::move(prepare)});
+}
+
+std::vector<Benchmark::Result> Benchmark::Run(const std::string &filter){
+    std::vector<Result> results;
+    for (auto &benchmark_case : cases) {
+        if (filter.empty() || benchmark_case.name.find(filter) != std::string::npos) {
+            results.push_back(Measure(benchmark_case));
+        }
+    }
+    return results;
+}
+
+Simulated_I2C_bus::Statistics Benchmark::Bus_stats() const {
+    Simulated_I2C_bus::Statistics total;
+    for (auto bus : buses) {
+        total.transactions += bus->Stats().transactions;
+        total.bytes += bus->Stats().bytes;
+        total.busy_time += bus->Stats().busy_time;
+    }
+    return total;
+}
+
+Benchmark::Result Benchmark::Measure(const Case &benchmark_case){
+    using clock = std::chrono::steady_clock;
+
+    // Warm up, first operations can fill caches and lazy initialized state
+    if (benchmark_case.prepare) {
+        benchmark_case.prepare(batch_size);
+    }
+    for (uint32_t i = 0; i < batch_size; i++) {
+        benchmark_case.operation();
+    }
+
+    Result result;
+    result.name = benchmark_case.name;
+    double total_time = 0;
+    double min_time = 0;
+    uint64_t allocations_total = 0;
+    uint64_t allocated_total = 0;
+    Simulated_I2C_bus::Statistics bus_total;
+    uint64_t serial_total = 0;
+    uint64_t elapsed_total = 0;
+    Run_loop::Statistics loop_total;
+
+    for (uint32_t batch = 0; batch < batches; batch++) {
+        if (benchmark_case.prepare) {
+            benchmark_case.prepare(batch_size);
+        }
+        Simulated_I2C_bus::Statistics bus_start = Bus_stats();
+        uint64_t serial_start = uart ? uart->Stats().transmitted : 0;
+        uint64_t allocations_start = allocations;
+        uint64_t allocated_start = allocated;
+        uint64_t elapsed_start = Virtual_clock::Now();
+        for (auto loop : loops) {
+            loop->Reset_statistics();
+        }
+
+        auto start = clock::now();
+        for (uint32_t i = 0; i < batch_size; i++) {
+            benchmark_case.operation();
+        }
+        auto end = clock::now();
+
+        elapsed_total += Virtual_clock::Now() - elapsed_start;
+        allocations_total += allocations - allocations_start;
+        allocated_total += allocated - allocated_start;
+        Simulated_I2C_bus::Statistics bus_end = Bus_stats();
+        bus_total.transactions += bus_end.transactions - bus_start.transactions;
+        bus_total.bytes += bus_end.bytes - bus_start.bytes;
+        bus_total.busy_time += bus_end.busy_time - bus_start.busy_time;
+        if (uart) {
+            serial_total += uart->Stats().transmitted - serial_start;
+        }
+        for (auto loop : loops) {
+            const Run_loop::Statistics &statistics = loop->Stats();
+            for (uint8_t i = 0; i < Power_control::states; i++) {
+                loop_total.time[i] += statistics.time[i];
+            }
+            loop_total.deadline_wakeups += statistics.deadline_wakeups;
+            loop_total.wake_latency_total += statistics.wake_latency_total;
+            loop_total.wake_latency_max = std::max(loop_total.wake_latency_max, statistics.wake_latency_max);
+        }
+        double batch_time = std::chrono::duration<double, std::nano>(end - start).count();
+        total_time += batch_time;
+        min_time = (batch == 0) ? batch_time : std::min(min_time, batch_time);
+    }
+
+    double operations = static_cast<double>(batch_size) * batches;
+    result.iterations = batch_size * batches;
+    result.time = total_time / operations;
+    result.time_min = min_time / batch_size;
+    result.allocations = allocations_total / operations;
+    result.allocated = allocated_total / operations;
+    result.transactions = bus_total.transactions / operations;
+    result.bus_bytes = bus_total.bytes / operations;
+    result.bus_time = bus_total.busy_time / operations;
+    result.serial_bytes = serial_total / operations;
+    result.elapsed = elapsed_total / operations;
+
+    uint64_t accounted = 0;
+    for (uint8_t i = 0; i < Power_control::states; i++) {
+        accounted += loop_total.time[i];
+    }
+    if (accounted > 0) {
+        result.run_share = static_cast<double>(loop_total.time[static_cast<uint8_t>(Run_loop::State::Run)]) / accounted;
+        result.sleep_share = static_cast<double>(loop_total.time[static_cast<uint8_t>(Run_loop::State::Sleep)]) / accounted;
+        result.stop_share = static_cast<double>(loop_total.time[static_cast<uint8_t>(Run_loop::State::Stop)]) / accounted;
+    }
+    if (loop_total.deadline_wakeups > 0) {
+        result.wake_latency = static_cast<double>(loop_total.wake_latency_total) / loop_total.deadline_wakeups;
+    }
+    result.wake_latency_max = loop_total.wake_latency_max;
+    return result;
+}
+
+void Benchmark::Print_table(std::ostream &output, const std::vector<Result> &results){
+    char line[320];
+    std::snprintf(line, sizeof(line), "%-36s %10s %10s %8s %9s %7s %8s %10s %10s %8s %6s %7s %6s %8s %8s\n",
+        "case", "ns/op", "min ns/op", "allocs", "alloc B", "i2c tr", "i2c B", "i2c ns", "sim ns", "uart B",
+        "run %", "sleep %", "stop %", "wake us", "wake max");
+    output << line;
+    for (auto &result : results) {
+        std::snprintf(line, sizeof(line), "%-36s %10.1f %10.1f %8.2f %9.1f %7.2f %8.2f %10.0f %10.0f %8.2f %6.2f %7.2f %6.2f %8.1f %8.0f\n",
+            result.name.c_str(), result.time, result.time_min, result.allocations, result.allocated,
+            result.transactions, result.bus_bytes, result.bus_time, result.elapsed, result.serial_bytes,
+            result.run_share * 100, result.sleep_share * 100, result.stop_share * 100, result.wake_latency, result.wake_latency_max);
+        output << line;
+    }
+}
+
+void Benchmark::Print_json(std::ostream &output, const std::vector<Result> &results){
+    char line[640];
+    output << "{\n  \"unit\": {\"time\": \"ns/op\", \"bus_time\": \"ns/op\", \"elapsed\": \"ns/op\", \"allocated\": \"B/op\", \"wake_latency\": \"us\"},\n  \"cases\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result &result = results[i];
+        std::snprintf(line, sizeof(line),
+            "    {\"name\": \"%s\", \"iterations\": %u, \"time\": %.2f, \"time_min\": %.2f, "
+            "\"allocations\": %.3f, \"allocated\": %.1f, \"transactions\": %.3f, \"bus_bytes\": %.3f, "
+            "\"bus_time\": %.1f, \"elapsed\": %.1f, \"serial_bytes\": %.3f, "
+            "\"run_share\": %.4f, \"sleep_share\": %.4f, \"stop_share\": %.4f, \"wake_latency\": %.1f, \"wake_latency_max\": %.0f}%s\n",
+            result.name.c_str(), result.iterations, result.time, result.time_min,
+            result.allocations, result.allocated, result.transactions, result.bus_bytes,
+            result.bus_time, result.elapsed, result.serial_bytes,
+            result.run_share, result.sleep_share, result.stop_share, result.wake_latency, result.wake_latency_max,
+            (i + 1 < results.size()) ? "," : "");
+        output << line;
+    }
+    output << "  ]\n}\n";
+}
@@ -0,0 +1,151 @@
+/**
+ * @file benchmark.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "host/simulated_i2c.hpp"
+#include "host/simulated_uart.hpp"
+#include "power/run_loop.hpp"
+
+/**
+ * @brief   Benchmark runner for host build (MCU_FAMILY_HOST)
+ *          Every case is measured in wall time per operation and in costs which do not depend on host:
+ *              heap allocations, bytes and transactions on simulated bus, modeled bus time and elapsed simulated time
+ *          Statistics of observed run loops are reported as share of time in power states and latency of wake up by deadline
+ *          Linking of benchmark.cpp replaces global operator new and delete to count allocations
+ */
+class Benchmark {
+public:
+    /**
+     * @brief   Measured case
+     */
+    struct Case {
+        std::string name;
+
+        /**
+         * @brief   Measured operation
+         */
+        std::function<void()> operation;
+
+        /**
+         * @brief   Optional preparation of state for given number of operations, is not measured
+         */
+        std::function<void(uint32_t)> prepare;
+    };
+
+    /**
+     * @brief   Result of case, all costs are per one operation
+     */
+    struct Result {
+        std::string name;
+        uint32_t iterations     = 0;
+        double time             = 0;  // Mean wall time in ns
+        double time_min         = 0;  // Wall time of fastest batch in ns
+        double allocations      = 0;
+        double allocated        = 0;  // Bytes
+        double transactions     = 0;  // I2C transactions of all buses
+        double bus_bytes        = 0;  // I2C bytes including address
+        double bus_time         = 0;  // Modeled I2C time of all buses in ns
+        double elapsed          = 0;  // Virtual_clock time in ns, shorter than bus time when buses run concurrently
+        double serial_bytes     = 0;  // Bytes transmitted by UART
+        double run_share        = 0;  // Duty cycle of run loop, share of accounted time spent in Run state
+        double sleep_share      = 0;  // Share of accounted time spent in Sleep state
+        double stop_share       = 0;  // Share of accounted time spent in Stop state
+        double wake_latency     = 0;  // Mean delay of wake up by deadline in us
+        double wake_latency_max = 0;  // Maximal delay of wake up by deadline in us
+    };
+
+    /**
+     * @brief   Counters of heap, updated by replaced operator new and delete
+     */
+    static inline uint64_t allocations = 0;
+    static inline uint64_t allocated = 0;
+    static inline uint64_t deallocations = 0;
+
+private:
+    std::vector<Case> cases;
+
+    /**
+     * @brief   Observed simulated peripherals
+     */
+    std::vector<Simulated_I2C_bus *> buses;
+    Simulated_UART *uart = nullptr;
+    std::vector<Run_loop *> loops;
+
+    /**
+     * @brief   Number of operations in one measured batch and number of batches
+     */
+    uint32_t batch_size;
+    uint32_t batches;
+
+    /**
+     * @brief   Return sum of statistics of observed buses
+     */
+    Simulated_I2C_bus::Statistics Bus_stats() const;
+
+    /**
+     * @brief   Measure one case
+     */
+    Result Measure(const Case &benchmark_case);
+
+public:
+    /**
+     * @brief Construct a new Benchmark object
+     *
+     * @param batch_size    Number of operations in one measured batch
+     * @param batches       Number of batches of every case
+     */
+    Benchmark(uint32_t batch_size = 1000, uint32_t batches = 10);
+
+    /**
+     * @brief   Observe simulated I2C bus, statistics of all observed buses are summed and reported with every case
+     */
+    void Observe(Simulated_I2C_bus &bus){ buses.push_back(&bus); };
+
+    /**
+     * @brief   Observe simulated UART, transmitted bytes are reported with every case
+     */
+    void Observe(Simulated_UART &uart){ this->uart = &uart; };
+
+    /**
+     * @brief   Observe run loop, statistics of all observed loops are reset before every batch and summed
+     */
+    void Observe(Run_loop &loop){ loops.push_back(&loop); };
+
+    /**
+     * @brief   Register case
+     *
+     * @param name      Unique name of case
+     * @param operation Measured operation
+     * @param prepare   Preparation of state for given number of operations, is not measured
+     */
+    void Register(const std::string &name, std::function<void()> operation, std::function<void(uint32_t)> prepare = nullptr);
+
+    /**
+     * @brief   Run cases whose name contains filter
+     *
+     * @param filter    Substring of names of cases, empty runs all cases
+     * @return std::vector<Result>  Results of cases in order of registration
+     */
+    std::vector<Result> Run(const std::string &filter = "");
+
+    /**
+     * @brief   Print results as aligned table
+     */
+    static void Print_table(std::ostream &output, const std::vector<Result> &results);
+
+    /**
+     * @brief   Print results as JSON, suitable for comparison between commits
+     */
+    static void Print_json(std::ostream &output, const std::vector<Result> &results);
+};
@@ -0,0 +1,147 @@
+#include "sample_decoder.hpp"
+
+#include <algorithm>
+
+using namespace Sample_codec;
+
+void Sample_decoder::Feed(const uint8_t *data, size_t length){
+    this->data.insert(this->data.end(), data, data + length);
+
+    while (position < this->data.size()) {
+        const uint8_t *start = this->data.data() + position;
+        size_t available = this->data.size() - position;
+        if (start[0] != block_tag) {
+            position++;
+            skipped++;
+            continue;
+        }
+        if (available < header_size) {
+            return;
+        }
+
+        Header header;
+        bool valid = Read_header(start, available, header) &&
+                     header.payload_length <= Payload_max(header.channels, header.count);
+        if (valid && available < header_size + header.payload_length) {
+            return;
+        }
+
+        std::vector<int32_t> decoded;
+        if (valid && Decode_block(start, available, header, decoded)) {
+            blocks.push_back(Block{header, position});
+            samples += header.count;
+            position += header_size + header.payload_length;
+        } else {
+            // Tag can be part of damaged block or of data, search for next one
+            if (valid) {
+                damaged++;
+            }
+            position++;
+            skipped++;
+        }
+    }
+}
+
+size_t Sample_decoder::Decode_block(const uint8_t *data, size_t length, Header &header, std::vector<int32_t> &output){
+    if (!Read_header(data, length, header) || length < header_size + header.payload_length) {
+        return 0;
+    }
+    const uint8_t *payload = data + header_size;
+    const uint8_t *end = payload + header.payload_length;
+    if (Block_crc(data, header.payload_length) != header.crc) {
+        return 0;
+    }
+
+    uint8_t channels = header.channels;
+    size_t base = output.size();
+    output.resize(base + static_cast<size_t>(header.count) * channels);
+    int32_t *samples = output.data() + base;
+
+    const uint8_t *input = payload;
+    uint32_t value;
+    for (uint8_t channel = 0; channel < channels; channel++) {
+        if (!Read_varint(input, end, value)) {
+            output.resize(base);
+            return 0;
+        }
+        samples[channel] = Unzigzag(value);
+    }
+
+    if (header.encoding == Encoding::Varint) {
+        for (size_t sample = 1; sample < header.count; sample++) {
+            for (uint8_t channel = 0; channel < channels; channel++) {
+                if (!Read_varint(input, end, value)) {
+                    output.resize(base);
+                    return 0;
+                }
+                uint32_t previous = static_cast<uint32_t>(samples[(sample - 1) * channels + channel]);
+                samples[sample * channels + channel] = static_cast<int32_t>(previous + static_cast<uint32_t>(Unzigzag(value)));
+            }
+        }
+    } else {
+        for (uint8_t channel = 0; channel < channels; channel++) {
+            if (input >= end || *input > 32) {
+                output.resize(base);
+                return 0;
+            }
+            uint8_t width = *input++;
+            size_t bytes = (static_cast<size_t>(width) * (header.count - 1) + 7) / 8;
+            if (static_cast<size_t>(end - input) < bytes) {
+                output.resize(base);
+                return 0;
+            }
+            uint64_t accumulator = 0;
+            uint8_t bits = 0;
+            uint64_t mask = (uint64_t(1) << width) - 1;
+            for (size_t sample = 1; sample < header.count; sample++) {
+                while (bits < width) {
+                    accumulator |= static_cast<uint64_t>(*input++) << bits;
+                    bits += 8;
+                }
+                value = static_cast<uint32_t>(accumulator & mask);
+                accumulator >>= width;
+                bits -= width;
+                uint32_t previous = static_cast<uint32_t>(samples[(sample - 1) * channels + channel]);
+                samples[sample * channels + channel] = static_cast<int32_t>(previous + static_cast<uint32_t>(Unzigzag(value)));
+            }
+            // Data of next channel start at byte boundary, remaining bits are padding
+        }
+    }
+
+    if (input != end) {
+        output.resize(base);
+        return 0;
+    }
+    return header_size + header.payload_length;
+}
+
+std::vector<int32_t> Sample_decoder::Read(uint32_t first, uint32_t count) const{
+    std::vector<int32_t> output;
+    uint64_t last = static_cast<uint64_t>(first) + count;
+    for (const Block &block : blocks) {
+        uint64_t block_first = block.header.index;
+        uint64_t block_last = block_first + block.header.count;
+        if (block_last <= first || block_first >= last) {
+            continue;
+        }
+
+        Header header;
+        std::vector<int32_t> decoded;
+        Decode_block(data.data() + block.offset, data.size() - block.offset, header, decoded);
+        size_t channels = header.channels;
+        size_t from = std::max<uint64_t>(first, block_first) - block_first;
+        size_t to = std::min(last, block_last) - block_first;
+        output.insert(output.end(), decoded.begin() + from * channels, decoded.begin() + to * channels);
+    }
+    return output;
+}
+
+std::vector<int32_t> Sample_decoder::Read_all() const{
+    std::vector<int32_t> output;
+    output.reserve(samples * Channels());
+    for (const Block &block : blocks) {
+        Header header;
+        Decode_block(data.data() + block.offset, data.size() - block.offset, header, output);
+    }
+    return output;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file sample_decoder.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "codec/sample_format.hpp"
+
+/**
+ * @brief   Host side decoder of sample streams compressed by Sample_encoder
+ *          Data can be fed in arbitrary fragments, complete blocks are verified by CRC and indexed
+ *          Samples are decoded on demand, only blocks which contain requested range are decoded (random access)
+ *          Damaged blocks are skipped, decoder resynchronizes on next block tag
+ */
+class Sample_decoder {
+public:
+    /**
+     * @brief   Valid block of stream
+     */
+    struct Block {
+        Sample_codec::Header header;
+        size_t offset;      // Position of header in stored data
+    };
+
+private:
+    /**
+     * @brief   Data of stream which were fed into decoder
+     */
+    std::vector<uint8_t> data;
+
+    /**
+     * @brief   Position of first byte which was not parsed yet
+     */
+    size_t position = 0;
+
+    /**
+     * @brief   Valid blocks ordered as they were received
+     */
+    std::vector<Block> blocks;
+
+    /**
+     * @brief   Number of bytes which do not belong to any valid block
+     */
+    uint32_t skipped = 0;
+
+    /**
+     * @brief   Number of blocks with valid header, but invalid payload
+     */
+    uint32_t damaged = 0;
+
+    /**
+     * @brief   Number of samples in valid blocks
+     */
+    uint64_t samples = 0;
+
+public:
+    /**
+     * @brief   Feed received bytes into decoder
+     *
+     * @param data      Received data
+     * @param length    Number of received bytes
+     */
+    void Feed(const uint8_t *data, size_t length);
+
+    /**
+     * @brief   Decode block
+     *
+     * @param data      Data starting by header of block
+     * @param length    Number of bytes available
+     * @param header    Header of block
+     * @param output    Decoded samples are appended, interleaved by channels
+     * @return size_t   Size of block, 0 if data do not start by valid block
+     */
+    static size_t Decode_block(const uint8_t *data, size_t length, Sample_codec::Header &header, std::vector<int32_t> &output);
+
+    /**
+     * @brief   Decode range of samples, only blocks which contain range are decoded
+     *
+     * @param first         Index of first sample
+     * @param count         Number of samples
+     * @return std::vector<int32_t> Samples interleaved by channels, samples missing in stream are not included
+     */
+    std::vector<int32_t> Read(uint32_t first, uint32_t count) const;
+
+    /**
+     * @brief   Decode all samples of stream
+     */
+    std::vector<int32_t> Read_all() const;
+
+    /**
+     * @brief   Return valid blocks of stream
+     */
+    const std::vector<Block> &Blocks() const { return blocks; };
+
+    /**
+     * @brief   Return number of channels of stream, 0 if no block was received
+     */
+    uint8_t Channels() const { return blocks.empty() ? 0 : blocks.front().header.channels; };
+
+    /**
+     * @brief   Return number of samples in valid blocks
+     */
+    uint64_t Samples() const { return samples; };
+
+    /**
+     * @brief   Return number of bytes of stream which were fed into decoder
+     */
+    size_t Size() const { return data.size(); };
+
+    /**
+     * @brief   Return number of bytes which do not belong to any valid block
+     */
+    uint32_t Skipped() const { return skipped; };
+
+    /**
+     * @brief   Return number of blocks with valid header, but invalid payload
+     */
+    uint32_t Damaged() const { return damaged; };
+};
@@ -0,0 +1,107 @@
+#include "sample_encoder.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace Sample_codec;
+
+namespace {
+    /**
+     * @brief   Return zigzag difference of sample value to previous sample, wrapping arithmetic keeps coding lossless
+     */
+    uint32_t Difference(const int32_t *samples, uint8_t channels, size_t sample, uint8_t channel){
+        uint32_t current = static_cast<uint32_t>(samples[sample * channels + channel]);
+        uint32_t previous = static_cast<uint32_t>(samples[(sample - 1) * channels + channel]);
+        return Zigzag(static_cast<int32_t>(current - previous));
+    }
+}
+
+Sample_encoder::Sample_encoder(uint8_t channels, uint16_t block_samples, bool packing) :
+    channels(std::clamp<uint8_t>(channels, 1, HALUP_CODEC_CHANNELS)),
+    block_samples(std::clamp<uint16_t>(block_samples, 1, HALUP_CODEC_BLOCK)),
+    packing(packing)
+{ }
+
+void Sample_encoder::Add(const int32_t *values){
+    std::memcpy(samples + count * channels, values, channels * sizeof(int32_t));
+    count++;
+    if (count >= block_samples) {
+        Flush();
+    }
+}
+
+void Sample_encoder::Flush(){
+    if (count == 0) {
+        return;
+    }
+    size_t length = Encode(samples, count, channels, index, packing, block);
+    index += count;
+    count = 0;
+    blocks++;
+    encoded_bytes += length;
+    if (callback) {
+        callback->Invoke(Block{block, length});
+    }
+}
+
+size_t Sample_encoder::Encode(const int32_t *samples, uint16_t count, uint8_t channels, uint32_t index, bool packing, uint8_t *output){
+    // Sizes of both encodings are calculated first, only smaller one is written
+    size_t base_size = 0;
+    for (uint8_t channel = 0; channel < channels; channel++) {
+        base_size += Varint_size(Zigzag(samples[channel]));
+    }
+    size_t varint_size = base_size;
+    uint8_t widths[HALUP_CODEC_CHANNELS] = {};
+    for (size_t sample = 1; sample < count; sample++) {
+        for (uint8_t channel = 0; channel < channels; channel++) {
+            uint32_t difference = Difference(samples, channels, sample, channel);
+            varint_size += Varint_size(difference);
+            widths[channel] = std::max(widths[channel], Bit_width(difference));
+        }
+    }
+    size_t packed_size = base_size;
+    for (uint8_t channel = 0; channel < channels; channel++) {
+        packed_size += 1 + (static_cast<size_t>(widths[channel]) * (count - 1) + 7) / 8;
+    }
+    Encoding encoding = (packing && packed_size < varint_size) ? Encoding::Packed : Encoding::Varint;
+
+    uint8_t *payload = output + header_size;
+    uint8_t *position = payload;
+    for (uint8_t channel = 0; channel < channels; channel++) {
+        position = Write_varint(position, Zigzag(samples[channel]));
+    }
+    if (encoding == Encoding::Varint) {
+        for (size_t sample = 1; sample < count; sample++) {
+            for (uint8_t channel = 0; channel < channels; channel++) {
+                position = Write_varint(position, Difference(samples, channels, sample, channel));
+            }
+        }
+    } else {
+        for (uint8_t channel = 0; channel < channels; channel++) {
+            uint8_t width = widths[channel];
+            *position++ = width;
+            // Bits are accumulated from least significant and written by whole bytes
+            uint64_t accumulator = 0;
+            uint8_t bits = 0;
+            for (size_t sample = 1; sample < count; sample++) {
+                accumulator |= static_cast<uint64_t>(Difference(samples, channels, sample, channel)) << bits;
+                bits += width;
+                while (bits >= 8) {
+                    *position++ = static_cast<uint8_t>(accumulator);
+                    accumulator >>= 8;
+                    bits -= 8;
+                }
+            }
+            if (bits > 0) {
+                *position++ = static_cast<uint8_t>(accumulator);
+            }
+        }
+    }
+
+    uint16_t payload_length = position - payload;
+    Header header{encoding, channels, count, index, payload_length, 0};
+    Write_header(output, header);
+    header.crc = Block_crc(output, payload_length);
+    Write_header(output, header);
+    return header_size + payload_length;
+}
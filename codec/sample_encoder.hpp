@@ -0,0 +1,179 @@
+/**
+ * @file sample_encoder.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "codec/sample_format.hpp"
+#include "misc/invocation_wrapper.hpp"
+
+/**
+ * @brief   Maximal number of channels of one sample
+ */
+#ifndef HALUP_CODEC_CHANNELS
+#define HALUP_CODEC_CHANNELS 3
+#endif
+
+/**
+ * @brief   Maximal number of samples in one block
+ */
+#ifndef HALUP_CODEC_BLOCK
+#define HALUP_CODEC_BLOCK 64
+#endif
+
+/**
+ * @brief   Streaming compression of sensor samples by delta, zigzag and varint coding (see codec/sample_format.hpp)
+ *          Samples are collected into block, full block is encoded and passed to callback,
+ *              which stores it into memory or sends it over serial line, block is valid only during callback
+ *          Every block is encoded by varint and by bit packing, smaller encoding is used if packing is enabled
+ *              Sample_encoder encoder(3, 32);
+ *              encoder.Register(&store_block);
+ *              encoder.Add_samples(accelerometer.Drain());
+ *              encoder.Flush();                        // Encode incomplete block, for example before sleep
+ */
+class Sample_encoder {
+public:
+    /**
+     * @brief   Encoded block including header
+     */
+    struct Block {
+        const uint8_t *data;
+        size_t length;
+    };
+
+    /**
+     * @brief   Size of buffer which fits block of maximal size
+     */
+    static constexpr size_t block_max = Sample_codec::header_size + Sample_codec::Payload_max(HALUP_CODEC_CHANNELS, HALUP_CODEC_BLOCK);
+
+    static_assert(Sample_codec::Payload_max(HALUP_CODEC_CHANNELS, HALUP_CODEC_BLOCK) <= UINT16_MAX, "Payload length must fit into header");
+
+private:
+    uint8_t channels;
+
+    /**
+     * @brief   Number of samples in full block
+     */
+    uint16_t block_samples;
+
+    /**
+     * @brief   Use bit packing when it is smaller than varint
+     */
+    bool packing;
+
+    /**
+     * @brief   Samples of block which is collected, interleaved by channels
+     */
+    int32_t samples[HALUP_CODEC_CHANNELS * HALUP_CODEC_BLOCK];
+
+    /**
+     * @brief   Number of samples in current block
+     */
+    uint16_t count = 0;
+
+    /**
+     * @brief   Index of first sample of current block
+     */
+    uint32_t index = 0;
+
+    /**
+     * @brief   Encoded block
+     */
+    uint8_t block[block_max];
+
+    Invocation_wrapper_base<void, Block> *callback = nullptr;
+
+    /**
+     * @brief   Statistics of encoded data
+     */
+    uint32_t blocks = 0;
+    uint64_t encoded_bytes = 0;
+
+public:
+    /**
+     * @brief Construct a new Sample_encoder object
+     *
+     * @param channels      Number of values of one sample, at most HALUP_CODEC_CHANNELS
+     * @param block_samples Number of samples in block, at most HALUP_CODEC_BLOCK
+     *                      Longer blocks compress better, shorter allow finer random access
+     * @param packing       Use bit packing if it is smaller than varint
+     */
+    Sample_encoder(uint8_t channels, uint16_t block_samples = HALUP_CODEC_BLOCK, bool packing = true);
+
+    /**
+     * @brief   Register callback which receives encoded blocks
+     *
+     * @param callback  Callback, nullptr disables output of blocks
+     */
+    void Register(Invocation_wrapper_base<void, Block> *callback){ this->callback = callback; };
+
+    /**
+     * @brief   Add sample, full block is encoded and passed to callback
+     *
+     * @param values    Values of all channels
+     */
+    void Add(const int32_t *values);
+
+    /**
+     * @brief   Add sample of integers, for example [X,Y,Z] of accelerometer
+     *          Values over number of channels are ignored, missing channels are zero
+     */
+    template <typename T, size_t N>
+    void Add(const std::array<T, N> &values){
+        int32_t converted[HALUP_CODEC_CHANNELS] = {};
+        for (size_t i = 0; i < std::min<size_t>(N, channels); i++) {
+            converted[i] = static_cast<int32_t>(values[i]);
+        }
+        Add(converted);
+    }
+
+    /**
+     * @brief   Add batch of samples, for example FIFO of accelerometer
+     */
+    template <typename Container_T>
+    void Add_samples(const Container_T &batch){
+        for (const auto &sample : batch) {
+            Add(sample);
+        }
+    }
+
+    /**
+     * @brief   Encode incomplete block and pass it to callback, next block starts with next sample
+     */
+    void Flush();
+
+    /**
+     * @brief   Encode block of samples into buffer
+     *
+     * @param samples   Samples interleaved by channels
+     * @param count     Number of samples, at least one
+     * @param channels  Number of channels
+     * @param index     Index of first sample stored in header
+     * @param packing   Use bit packing if it is smaller than varint
+     * @param output    Buffer of at least header_size + Payload_max(channels, count) bytes
+     * @return size_t   Size of block
+     */
+    static size_t Encode(const int32_t *samples, uint16_t count, uint8_t channels, uint32_t index, bool packing, uint8_t *output);
+
+    /**
+     * @brief   Return index of next sample
+     */
+    uint32_t Index() const { return index + count; };
+
+    /**
+     * @brief   Return number of encoded blocks
+     */
+    uint32_t Blocks() const { return blocks; };
+
+    /**
+     * @brief   Return number of bytes of encoded blocks
+     */
+    uint64_t Encoded_bytes() const { return encoded_bytes; };
+};
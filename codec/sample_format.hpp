@@ -0,0 +1,197 @@
+/**
+ * @file sample_format.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "protocol/crc.hpp"
+
+/**
+ * @brief   Format of compressed sample streams shared by Sample_encoder on target and Sample_decoder on host side
+ *          Stream is sequence of independent blocks, every block can be decoded alone (random access by sample index)
+ *          Block: header, payload
+ *              Header:  tag (1B), encoding (1B), channels (1B), sample count (2B), index of first sample (4B),
+ *                       payload length (2B), CRC16 (2B) of header from encoding to payload length and of payload,
+ *                       multibyte values are little-endian
+ *              Payload: first sample as zigzag varints, then differences of following samples to previous ones
+ *                  Varint: zigzag varint of every difference, samples are interleaved
+ *                  Packed: for every channel width of difference in bits (1B) and zigzag differences of channel
+ *                          packed LSB first by that width, data of every channel start at byte boundary
+ *          Slowly changing signals (temperature) have small differences, so most of them take one byte or few bits
+ */
+namespace Sample_codec {
+    /**
+     * @brief   Tag of block, used to find start of block in damaged stream
+     */
+    inline constexpr uint8_t block_tag = 0xc5;
+
+    /**
+     * @brief   Encoding of differences in payload of block
+     */
+    enum class Encoding: uint8_t {
+        Varint = 0,
+        Packed = 1,
+    };
+
+    /**
+     * @brief   Size of block header in bytes
+     */
+    inline constexpr size_t header_size = 13;
+
+    /**
+     * @brief   Maximal size of value encoded as varint in bytes
+     */
+    inline constexpr size_t varint_max = 5;
+
+    /**
+     * @brief   Header of block
+     */
+    struct Header {
+        Encoding encoding;
+        uint8_t channels;
+        uint16_t count;
+        uint32_t index;
+        uint16_t payload_length;
+        uint16_t crc;
+    };
+
+    /**
+     * @brief   Map signed value to unsigned, small magnitudes of both signs become small numbers
+     *          0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3
+     */
+    constexpr uint32_t Zigzag(int32_t value){
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    }
+
+    constexpr int32_t Unzigzag(uint32_t value){
+        return static_cast<int32_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    /**
+     * @brief   Return number of bytes of value encoded as varint
+     */
+    constexpr size_t Varint_size(uint32_t value){
+        size_t size = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            size++;
+        }
+        return size;
+    }
+
+    /**
+     * @brief   Write value as varint, 7 bits per byte from least significant, highest bit marks continuation
+     *
+     * @return uint8_t*     Position after written value
+     */
+    inline uint8_t *Write_varint(uint8_t *output, uint32_t value){
+        while (value >= 0x80) {
+            *output++ = static_cast<uint8_t>(value) | 0x80;
+            value >>= 7;
+        }
+        *output++ = static_cast<uint8_t>(value);
+        return output;
+    }
+
+    /**
+     * @brief   Read varint
+     *
+     * @param input     Position of value, moved after value
+     * @param end       End of data
+     * @param value     Decoded value
+     * @return false    Value is truncated or longer than 5 bytes
+     */
+    inline bool Read_varint(const uint8_t *&input, const uint8_t *end, uint32_t &value){
+        value = 0;
+        for (size_t i = 0; i < varint_max && input < end; i++) {
+            uint8_t byte = *input++;
+            value |= static_cast<uint32_t>(byte & 0x7f) << (7 * i);
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief   Return number of bits needed for value, 0 for zero
+     */
+    constexpr uint8_t Bit_width(uint32_t value){
+        uint8_t width = 0;
+        while (value != 0) {
+            value >>= 1;
+            width++;
+        }
+        return width;
+    }
+
+    /**
+     * @brief   Return maximal size of payload of block
+     *
+     * @param channels  Number of channels
+     * @param count     Number of samples
+     */
+    constexpr size_t Payload_max(size_t channels, size_t count){
+        return channels * varint_max * count;
+    }
+
+    /**
+     * @brief   Write header of block
+     *
+     * @param output    Buffer of at least header_size bytes
+     */
+    inline void Write_header(uint8_t *output, const Header &header){
+        output[0] = block_tag;
+        output[1] = static_cast<uint8_t>(header.encoding);
+        output[2] = header.channels;
+        output[3] = header.count & 0xff;
+        output[4] = header.count >> 8;
+        for (int i = 0; i < 4; i++) {
+            output[5 + i] = (header.index >> (8 * i)) & 0xff;
+        }
+        output[9] = header.payload_length & 0xff;
+        output[10] = header.payload_length >> 8;
+        output[11] = header.crc & 0xff;
+        output[12] = header.crc >> 8;
+    }
+
+    /**
+     * @brief   Calculate CRC of block, covers header without tag and CRC and payload
+     *          Damaged index or channels would otherwise place samples of valid payload to wrong position
+     *
+     * @param block             Block starting by header
+     * @param payload_length    Length of payload
+     */
+    inline uint16_t Block_crc(const uint8_t *block, uint16_t payload_length){
+        uint16_t crc = CRC::CRC16(block + 1, header_size - 3);
+        return CRC::CRC16_update(crc, block + header_size, payload_length);
+    }
+
+    /**
+     * @brief   Read header of block
+     *
+     * @return false    Data do not start by valid header
+     */
+    inline bool Read_header(const uint8_t *input, size_t length, Header &header){
+        if (length < header_size || input[0] != block_tag || input[1] > static_cast<uint8_t>(Encoding::Packed) ||
+            input[2] == 0) {
+            return false;
+        }
+        header.encoding = static_cast<Encoding>(input[1]);
+        header.channels = input[2];
+        header.count = input[3] | input[4] << 8;
+        header.index = 0;
+        for (int i = 0; i < 4; i++) {
+            header.index |= static_cast<uint32_t>(input[5 + i]) << (8 * i);
+        }
+        header.payload_length = input[9] | input[10] << 8;
+        header.crc = input[11] | input[12] << 8;
+        return header.count > 0;
+    }
+}
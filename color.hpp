@@ -1,68 +1,299 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
 #include <string>
-#include <map>
-#include <functional>
+#include <string_view>
+#include <utility>
 
 namespace dye {
-    // Map for ANSI color codes
-    inline std::map<std::string, std::string> ColorMap = {
-        {"reset", "\033[0m"},
-        {"bold", "\033[1m"},
-        {"underline", "\033[4m"},
-        {"black", "\033[30m"},
-        {"red", "\033[31m"},
-        {"green", "\033[32m"},
-        {"yellow", "\033[33m"},
-        {"blue", "\033[34m"},
-        {"magenta", "\033[35m"},
-        {"cyan", "\033[36m"},
-        {"white", "\033[37m"},
-        {"light_black", "\033[90m"},
-        {"light_red", "\033[91m"},
-        {"light_green", "\033[92m"},
-        {"light_yellow", "\033[93m"},
-        {"light_blue", "\033[94m"},
-        {"light_magenta", "\033[95m"},
-        {"light_cyan", "\033[96m"},
-        {"light_white", "\033[97m"}
+    /**
+     * @brief   ANSI styles and colors, value of every style is its SGR parameter
+     */
+    enum class Style : uint8_t {
+        Reset         = 0,
+        Bold          = 1,
+        Underline     = 4,
+        Black         = 30,
+        Red           = 31,
+        Green         = 32,
+        Yellow        = 33,
+        Blue          = 34,
+        Magenta       = 35,
+        Cyan          = 36,
+        White         = 37,
+        Light_black   = 90,
+        Light_red     = 91,
+        Light_green   = 92,
+        Light_yellow  = 93,
+        Light_blue    = 94,
+        Light_magenta = 95,
+        Light_cyan    = 96,
+        Light_white   = 97
     };
 
-    // Function to apply ANSI color codes
-    inline std::string colorize(const std::string& style, const std::string& input) {
-        auto style_iter = ColorMap.find(style);
-        if (style_iter != ColorMap.end()) {
-            return style_iter->second + input + ColorMap["reset"];
-        } else {
-            return input; // Return input unchanged if style is not found
+    /**
+     * @brief   Escape sequence of given styles composed at compile time
+     *          Multiple styles are merged into one sequence, for example Bold + Red -> "\033[1;31m"
+     *
+     * @tparam styles   Styles which are applied by sequence, at least one is required
+     */
+    template <Style... styles>
+    struct Sequence {
+        static_assert(sizeof...(styles) > 0, "Escape sequence requires at least one style");
+
+    private:
+        static constexpr size_t Digits(Style style){
+            return static_cast<uint8_t>(style) >= 10 ? 2 : 1;
+        }
+
+        static constexpr size_t length = 3 + (Digits(styles) + ...) + (sizeof...(styles) - 1);
+
+        static constexpr std::array<char, length> Build(){
+            std::array<char, length> output{};
+            size_t index = 0;
+            output[index++] = '\033';
+            output[index++] = '[';
+            for (Style style : {styles...}) {
+                uint8_t parameter = static_cast<uint8_t>(style);
+                if (index > 2) {
+                    output[index++] = ';';
+                }
+                if (parameter >= 10) {
+                    output[index++] = static_cast<char>('0' + parameter / 10);
+                }
+                output[index++] = static_cast<char>('0' + parameter % 10);
+            }
+            output[index] = 'm';
+            return output;
+        }
+
+        static constexpr std::array<char, length> code = Build();
+
+    public:
+        /**
+         * @brief   Escape sequence as view to static storage, not terminated by null
+         */
+        static constexpr std::string_view view{code.data(), code.size()};
+    };
+
+    /**
+     * @brief   Escape sequence which returns terminal into default style
+     */
+    inline constexpr std::string_view Reset_code = Sequence<Style::Reset>::view;
+
+    /**
+     * @brief   Write styled text into buffer of caller, no allocation is performed
+     *          Output is not terminated by null
+     *
+     * @param code      Escape sequence of style
+     * @param buffer    Target buffer
+     * @param capacity  Size of target buffer
+     * @param input     Text to style
+     * @return size_t   Number of written characters, 0 if styled text does not fit into buffer
+     */
+    constexpr size_t Write(std::string_view code, char *buffer, size_t capacity, std::string_view input){
+        size_t length = code.size() + input.size() + Reset_code.size();
+        if (length > capacity) {
+            return 0;
+        }
+        size_t index = 0;
+        for (std::string_view part : {code, input, Reset_code}) {
+            for (char character : part) {
+                buffer[index++] = character;
+            }
+        }
+        return length;
+    }
+
+    /**
+     * @brief   Pass styled text to sink in three parts (style, text, reset), no allocation is performed
+     *
+     * @tparam sink_T   Callable object which accepts std::string_view, for example lambda sending data to Serial_line
+     * @param code      Escape sequence of style
+     * @param sink      Receiver of styled text
+     * @param input     Text to style
+     */
+    template <typename sink_T>
+    void Write(std::string_view code, sink_T &&sink, std::string_view input){
+        sink(code);
+        sink(input);
+        sink(Reset_code);
+    }
+
+    /**
+     * @brief   Style or color which can be applied to text, all escape sequences are resolved at compile time
+     *          Styles can be composed by operator +, for example bold + red
+     *
+     * @tparam styles   Styles which are applied to text
+     */
+    template <Style... styles>
+    struct Dye {
+        /**
+         * @brief   Escape sequence which is inserted before text
+         */
+        static constexpr std::string_view code = Sequence<styles...>::view;
+
+#ifndef HALUP_NO_HEAP
+        /**
+         * @brief   Return styled copy of text, only one allocation of output string is performed
+         *
+         * @param input         Text to style
+         * @return std::string  Styled text
+         */
+        std::string operator()(std::string_view input) const {
+            std::string output;
+            output.reserve(code.size() + input.size() + Reset_code.size());
+            output.append(code).append(input).append(Reset_code);
+            return output;
+        }
+#endif
+
+        /**
+         * @brief   Write styled text into buffer of caller, see dye::Write
+         */
+        constexpr size_t operator()(char *buffer, size_t capacity, std::string_view input) const {
+            return Write(code, buffer, capacity, input);
+        }
+
+        /**
+         * @brief   Pass styled text to sink, see dye::Write
+         */
+        template <typename sink_T>
+        void operator()(sink_T &&sink, std::string_view input) const {
+            Write(code, std::forward<sink_T>(sink), input);
+        }
+    };
+
+    /**
+     * @brief   Compose two styles into one, resulting escape sequence is created at compile time
+     */
+    template <Style... lhs_styles, Style... rhs_styles>
+    constexpr Dye<lhs_styles..., rhs_styles...> operator+(Dye<lhs_styles...>, Dye<rhs_styles...>){
+        return {};
+    }
+
+    /**
+     * @brief   Name of style used for lookup of style by string
+     */
+    struct Style_name {
+        std::string_view name;
+        Style style;
+    };
+
+    // Table of names of ANSI color codes
+    inline constexpr std::array<Style_name, 19> Style_names = {{
+        {"reset", Style::Reset},
+        {"bold", Style::Bold},
+        {"underline", Style::Underline},
+        {"black", Style::Black},
+        {"red", Style::Red},
+        {"green", Style::Green},
+        {"yellow", Style::Yellow},
+        {"blue", Style::Blue},
+        {"magenta", Style::Magenta},
+        {"cyan", Style::Cyan},
+        {"white", Style::White},
+        {"light_black", Style::Light_black},
+        {"light_red", Style::Light_red},
+        {"light_green", Style::Light_green},
+        {"light_yellow", Style::Light_yellow},
+        {"light_blue", Style::Light_blue},
+        {"light_magenta", Style::Light_magenta},
+        {"light_cyan", Style::Light_cyan},
+        {"light_white", Style::Light_white}
+    }};
+
+    /**
+     * @brief   Find style by its name
+     *
+     * @param name                  Name of style, for example "light_red"
+     * @return std::optional<Style> Style if name is known, otherwise empty optional
+     */
+    constexpr std::optional<Style> Find_style(std::string_view name){
+        for (const auto &entry : Style_names) {
+            if (entry.name == name) {
+                return entry.style;
+            }
+        }
+        return {};
+    }
+
+    /**
+     * @brief   Escape sequence of style selected at runtime
+     *          Sequences are stored in static table, no sequence is build at runtime
+     *
+     * @param style             Style of sequence
+     * @return std::string_view Escape sequence of style
+     */
+    constexpr std::string_view Code(Style style){
+        switch (style) {
+            case Style::Reset:         return Dye<Style::Reset>::code;
+            case Style::Bold:          return Dye<Style::Bold>::code;
+            case Style::Underline:     return Dye<Style::Underline>::code;
+            case Style::Black:         return Dye<Style::Black>::code;
+            case Style::Red:           return Dye<Style::Red>::code;
+            case Style::Green:         return Dye<Style::Green>::code;
+            case Style::Yellow:        return Dye<Style::Yellow>::code;
+            case Style::Blue:          return Dye<Style::Blue>::code;
+            case Style::Magenta:       return Dye<Style::Magenta>::code;
+            case Style::Cyan:          return Dye<Style::Cyan>::code;
+            case Style::White:         return Dye<Style::White>::code;
+            case Style::Light_black:   return Dye<Style::Light_black>::code;
+            case Style::Light_red:     return Dye<Style::Light_red>::code;
+            case Style::Light_green:   return Dye<Style::Light_green>::code;
+            case Style::Light_yellow:  return Dye<Style::Light_yellow>::code;
+            case Style::Light_blue:    return Dye<Style::Light_blue>::code;
+            case Style::Light_magenta: return Dye<Style::Light_magenta>::code;
+            case Style::Light_cyan:    return Dye<Style::Light_cyan>::code;
+            case Style::Light_white:   return Dye<Style::Light_white>::code;
+        }
+        return {};
+    }
+
+#ifndef HALUP_NO_HEAP
+    // Function to apply ANSI color codes, style is selected by name at runtime
+    inline std::string colorize(std::string_view style, std::string_view input) {
+        auto found_style = Find_style(style);
+        if (not found_style.has_value()) {
+            return std::string(input); // Return input unchanged if style is not found
         }
+        std::string_view code = Code(found_style.value());
+        std::string output;
+        output.reserve(code.size() + input.size() + Reset_code.size());
+        output.append(code).append(input).append(Reset_code);
+        return output;
     }
 
     // Factory function to create color/style functions dynamically
-    inline std::function<std::string(const std::string&)> make_color_function(const std::string& style) {
-        return [style](const std::string& input) {
+    inline auto make_color_function(std::string_view style) {
+        return [style = std::string(style)](std::string_view input) {
             return colorize(style, input);
         };
     }
+#endif
 
     // Aliases for commonly used colors and styles
-    const auto reset = make_color_function("reset");
-    const auto bold = make_color_function("bold");
-    const auto underline = make_color_function("underline");
-    const auto black = make_color_function("black");
-    const auto red = make_color_function("red");
-    const auto green = make_color_function("green");
-    const auto yellow = make_color_function("yellow");
-    const auto blue = make_color_function("blue");
-    const auto magenta = make_color_function("magenta");
-    const auto cyan = make_color_function("cyan");
-    const auto white = make_color_function("white");
-    const auto light_black = make_color_function("light_black");
-    const auto light_red = make_color_function("light_red");
-    const auto light_green = make_color_function("light_green");
-    const auto light_yellow = make_color_function("light_yellow");
-    const auto light_blue = make_color_function("light_blue");
-    const auto light_magenta = make_color_function("light_magenta");
-    const auto light_cyan = make_color_function("light_cyan");
-    const auto light_white = make_color_function("light_white");
+    inline constexpr Dye<Style::Reset>         reset{};
+    inline constexpr Dye<Style::Bold>          bold{};
+    inline constexpr Dye<Style::Underline>     underline{};
+    inline constexpr Dye<Style::Black>         black{};
+    inline constexpr Dye<Style::Red>           red{};
+    inline constexpr Dye<Style::Green>         green{};
+    inline constexpr Dye<Style::Yellow>        yellow{};
+    inline constexpr Dye<Style::Blue>          blue{};
+    inline constexpr Dye<Style::Magenta>       magenta{};
+    inline constexpr Dye<Style::Cyan>          cyan{};
+    inline constexpr Dye<Style::White>         white{};
+    inline constexpr Dye<Style::Light_black>   light_black{};
+    inline constexpr Dye<Style::Light_red>     light_red{};
+    inline constexpr Dye<Style::Light_green>   light_green{};
+    inline constexpr Dye<Style::Light_yellow>  light_yellow{};
+    inline constexpr Dye<Style::Light_blue>    light_blue{};
+    inline constexpr Dye<Style::Light_magenta> light_magenta{};
+    inline constexpr Dye<Style::Light_cyan>    light_cyan{};
+    inline constexpr Dye<Style::Light_white>   light_white{};
 }
@@ -18,4 +18,6 @@
 # include "stm32l4xx_hal.h"
 #elif defined(MCU_FAMILY_STM32_G0)
 # include "stm32g0xx_hal.h"
+#elif defined(MCU_FAMILY_HOST)
+# include "host/host_hal.hpp"
 #endif
@@ -0,0 +1,341 @@
+#include "host_hal.hpp"
+
+#include <algorithm>
+
+#include "host/virtual_clock.hpp"
+#include "host/simulated_gpio.hpp"
+#include "host/simulated_i2c.hpp"
+#include "host/simulated_rtc.hpp"
+#include "host/simulated_spi.hpp"
+#include "host/simulated_uart.hpp"
+#include "host/simulated_usb.hpp"
+
+/**
+ * @brief   Handle of RTC, on MCU is generated by CubeMX, application can define its own
+ */
+__attribute__((weak)) RTC_HandleTypeDef hrtc = {RTC, {}};
+
+/**
+ * @brief   Handle of USB device, application assigns simulated device to its Instance
+ */
+__attribute__((weak)) USBD_HandleTypeDef hUsbDeviceFS = {nullptr};
+
+// ----------------------------------------------------------------------------- Core
+
+namespace {
+    /**
+     * @brief   SysTick interrupt is enabled, it wakes core from WFI every ms
+     */
+    bool tick_running = true;
+}
+
+uint32_t HAL_GetTick(void){
+    return static_cast<uint32_t>(Virtual_clock::Now_ms());
+}
+
+void HAL_Delay(uint32_t delay){
+    Virtual_clock::Advance(static_cast<uint64_t>(delay) * 1000000);
+}
+
+void HAL_SuspendTick(void){
+    tick_running = false;
+}
+
+void HAL_ResumeTick(void){
+    tick_running = true;
+}
+
+uint32_t __get_PRIMASK(void){
+    return Virtual_clock::Masked() ? 1 : 0;
+}
+
+void __set_PRIMASK(uint32_t priMask){
+    Virtual_clock::Mask(priMask & 1);
+}
+
+void __disable_irq(void){
+    Virtual_clock::Mask(true);
+}
+
+void __enable_irq(void){
+    Virtual_clock::Mask(false);
+}
+
+uint32_t __get_IPSR(void){
+    // Number of active exception, simulated interrupts are reported as first external IRQ
+    return Virtual_clock::In_interrupt() ? 16 : 0;
+}
+
+void __WFI(void){
+    // Without other event core is woken by next SysTick, so loops waiting for timeout make progress
+    std::optional<uint64_t> tick;
+    if (tick_running) {
+        tick = (Virtual_clock::Now_ms() + 1) * 1000000;
+    }
+    Virtual_clock::Wait_for_interrupt(tick);
+}
+
+// ----------------------------------------------------------------------------- PWR
+
+void HAL_PWR_EnterSLEEPMode(uint32_t Regulator, uint8_t SLEEPEntry){
+    (void)Regulator;
+    (void)SLEEPEntry;
+    __WFI();
+}
+
+void HAL_PWR_EnterSTOPMode(uint32_t Regulator, uint8_t STOPEntry){
+    (void)Regulator;
+    (void)STOPEntry;
+    __WFI();
+}
+
+void HAL_PWREx_EnterSTOP2Mode(uint8_t STOPEntry){
+    (void)STOPEntry;
+    __WFI();
+}
+
+// ----------------------------------------------------------------------------- GPIO
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init){
+    (void)GPIOx;
+    (void)GPIO_Init;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState){
+    if (PinState == GPIO_PIN_SET) {
+        GPIOx->ODR = GPIOx->ODR | GPIO_Pin;
+    } else {
+        GPIOx->ODR = GPIOx->ODR & ~GPIO_Pin;
+    }
+    Simulated_GPIO::Drive(GPIOx, GPIO_Pin, PinState == GPIO_PIN_SET);
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin){
+    return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin){
+    HAL_GPIO_WritePin(GPIOx, GPIO_Pin, (GPIOx->ODR & GPIO_Pin) ? GPIO_PIN_RESET : GPIO_PIN_SET);
+}
+
+__attribute__((weak)) void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin){
+    (void)GPIO_Pin;
+}
+
+// ----------------------------------------------------------------------------- I2C
+
+namespace {
+    HAL_StatusTypeDef I2C_status(I2C_HandleTypeDef *hi2c, uint32_t error, uint32_t timeout){
+        hi2c->ErrorCode = error;
+        if (error & HAL_I2C_ERROR_TIMEOUT) {
+            // Peripheral waits for release of bus until timeout expires
+            Virtual_clock::Advance(static_cast<uint64_t>(std::min<uint32_t>(timeout, 1000)) * 1000000);
+            return HAL_TIMEOUT;
+        }
+        return (error == HAL_I2C_ERROR_NONE) ? HAL_OK : HAL_ERROR;
+    }
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c){
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c){
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout){
+    if (hi2c->Instance->Busy()) {
+        return HAL_BUSY;
+    }
+    return I2C_status(hi2c, hi2c->Instance->Transmit(DevAddress, pData, Size), Timeout);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout){
+    if (hi2c->Instance->Busy()) {
+        return HAL_BUSY;
+    }
+    return I2C_status(hi2c, hi2c->Instance->Receive(DevAddress, pData, Size), Timeout);
+}
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout){
+    if (hi2c->Instance->Busy()) {
+        return HAL_BUSY;
+    }
+    return I2C_status(hi2c, hi2c->Instance->Probe(DevAddress, Trials), Timeout);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size){
+    return hi2c->Instance->Transfer_IT(hi2c, DevAddress, pData, Size, false);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size){
+    return hi2c->Instance->Transfer_IT(hi2c, DevAddress, pData, Size, true);
+}
+
+__attribute__((weak)) void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c){
+    (void)hi2c;
+}
+
+__attribute__((weak)) void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c){
+    (void)hi2c;
+}
+
+__attribute__((weak)) void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c){
+    (void)hi2c;
+}
+
+// ----------------------------------------------------------------------------- SPI
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout){
+    (void)Timeout;
+    return hspi->Instance->Transfer(hspi, pData, nullptr, Size, false);
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout){
+    (void)Timeout;
+    return hspi->Instance->Transfer(hspi, nullptr, pData, Size, false);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size, uint32_t Timeout){
+    (void)Timeout;
+    return hspi->Instance->Transfer(hspi, pTxData, pRxData, Size, false);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size){
+    return hspi->Instance->Transfer(hspi, pTxData, pRxData, Size, true);
+}
+
+__attribute__((weak)) void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi){
+    (void)hspi;
+}
+
+__attribute__((weak)) void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi){
+    (void)hspi;
+}
+
+// ----------------------------------------------------------------------------- UART
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout){
+    (void)Timeout;
+    return huart->Instance->Transmit(huart, pData, Size, true);
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size){
+    return huart->Instance->Transmit(huart, pData, Size, false);
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size){
+    return huart->Instance->Transmit(huart, pData, Size, false);
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size){
+    return huart->Instance->Receive(huart, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size){
+    return huart->Instance->Receive(huart, pData, Size);
+}
+
+__attribute__((weak)) void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart){
+    (void)huart;
+}
+
+__attribute__((weak)) void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart){
+    (void)huart;
+}
+
+// ----------------------------------------------------------------------------- USB device
+
+uint8_t USBD_CDC_SetTxBuffer(USBD_HandleTypeDef *pdev, uint8_t *pbuff, uint32_t length){
+    if (pdev->Instance == nullptr) {
+        return USBD_FAIL;
+    }
+    pdev->Instance->Set_TX_buffer(pbuff, length);
+    return USBD_OK;
+}
+
+uint8_t USBD_CDC_SetRxBuffer(USBD_HandleTypeDef *pdev, uint8_t *pbuff){
+    if (pdev->Instance == nullptr) {
+        return USBD_FAIL;
+    }
+    pdev->Instance->Set_RX_buffer(pbuff);
+    return USBD_OK;
+}
+
+uint8_t USBD_CDC_TransmitPacket(USBD_HandleTypeDef *pdev){
+    return pdev->Instance ? pdev->Instance->Transmit() : USBD_FAIL;
+}
+
+uint8_t USBD_CDC_ReceivePacket(USBD_HandleTypeDef *pdev){
+    return pdev->Instance ? pdev->Instance->Receive() : USBD_FAIL;
+}
+
+__attribute__((weak)) int8_t CDC_Receive_FS(uint8_t *Buf, uint32_t *Len){
+    (void)Buf;
+    (void)Len;
+    return USBD_OK;
+}
+
+__attribute__((weak)) int8_t CDC_TransmitCplt_FS(uint8_t *Buf, uint32_t *Len, uint8_t epnum){
+    (void)Buf;
+    (void)Len;
+    (void)epnum;
+    return USBD_OK;
+}
+
+// ----------------------------------------------------------------------------- RTC
+
+HAL_StatusTypeDef HAL_RTC_Init(RTC_HandleTypeDef *hrtc){
+    hrtc->Instance->Init(hrtc);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_SetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format){
+    (void)Format;
+    hrtc->Instance->Set_time(hrtc, *sTime);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format){
+    (void)Format;
+    hrtc->Instance->Get_time(*sTime);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_SetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format){
+    (void)Format;
+    hrtc->Instance->Set_date(hrtc, *sDate);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format){
+    (void)Format;
+    hrtc->Instance->Get_date(*sDate);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_SetAlarm_IT(RTC_HandleTypeDef *hrtc, RTC_AlarmTypeDef *sAlarm, uint32_t Format){
+    (void)Format;
+    hrtc->Instance->Set_alarm(hrtc, *sAlarm);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetAlarm(RTC_HandleTypeDef *hrtc, RTC_AlarmTypeDef *sAlarm, uint32_t Alarm, uint32_t Format){
+    (void)Alarm;
+    (void)Format;
+    hrtc->Instance->Get_alarm(*sAlarm);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_DeactivateAlarm(RTC_HandleTypeDef *hrtc, uint32_t Alarm){
+    (void)Alarm;
+    hrtc->Instance->Deactivate_alarm();
+    return HAL_OK;
+}
+
+__attribute__((weak)) void HAL_RTC_AlarmAEventCallback(RTC_HandleTypeDef *hrtc){
+    (void)hrtc;
+}
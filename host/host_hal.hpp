@@ -0,0 +1,305 @@
+/**
+ * @file host_hal.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief   Simulated subset of STM32 HAL for host build (MCU_FAMILY_HOST)
+ *          Only part of HAL used by library is implemented, names and signatures are same as in STM32 HAL
+ *          Member Instance of handles points to simulated peripheral instead of registers:
+ *              Simulated_I2C_bus bus(400000);
+ *              I2C_HandleTypeDef hi2c1 = {&bus};
+ *          All peripherals share Virtual_clock, IRQ callbacks of HAL are invoked from events of clock
+ */
+
+class Simulated_I2C_bus;
+class Simulated_SPI_bus;
+class Simulated_UART;
+class Simulated_RTC;
+class Simulated_USB_CDC;
+
+typedef enum {
+    HAL_OK      = 0x00U,
+    HAL_ERROR   = 0x01U,
+    HAL_BUSY    = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+
+// ----------------------------------------------------------------------------- Core
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t delay);
+void HAL_SuspendTick(void);
+void HAL_ResumeTick(void);
+
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t priMask);
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_IPSR(void);
+void __WFI(void);
+
+// ----------------------------------------------------------------------------- PWR
+
+#define PWR_MAINREGULATOR_ON        0x00000000U
+#define PWR_LOWPOWERREGULATOR_ON    0x00004000U
+#define PWR_SLEEPENTRY_WFI          ((uint8_t)0x01)
+#define PWR_SLEEPENTRY_WFE          ((uint8_t)0x02)
+#define PWR_STOPENTRY_WFI           ((uint8_t)0x01)
+#define PWR_STOPENTRY_WFE           ((uint8_t)0x02)
+
+void HAL_PWR_EnterSLEEPMode(uint32_t Regulator, uint8_t SLEEPEntry);
+void HAL_PWR_EnterSTOPMode(uint32_t Regulator, uint8_t STOPEntry);
+void HAL_PWREx_EnterSTOP2Mode(uint8_t STOPEntry);
+
+// ----------------------------------------------------------------------------- GPIO
+
+/**
+ * @brief   Simulated port, IDR is level of pins (driven by ODR or by Simulated_GPIO::Drive),
+ *          RTSR/FTSR enable EXTI on rising/falling edge of pins
+ */
+typedef struct {
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t RTSR;
+    volatile uint32_t FTSR;
+} GPIO_TypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0U,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+/**
+ * @brief   Ports are stored in array, so addresses of ports are equidistant as on MCU
+ */
+extern GPIO_TypeDef host_gpio[8];
+
+#define GPIOA (&host_gpio[0])
+#define GPIOB (&host_gpio[1])
+#define GPIOC (&host_gpio[2])
+#define GPIOD (&host_gpio[3])
+#define GPIOE (&host_gpio[4])
+#define GPIOF (&host_gpio[5])
+#define GPIOG (&host_gpio[6])
+#define GPIOH (&host_gpio[7])
+
+#define GPIO_PIN_0   ((uint16_t)0x0001)
+#define GPIO_PIN_1   ((uint16_t)0x0002)
+#define GPIO_PIN_2   ((uint16_t)0x0004)
+#define GPIO_PIN_3   ((uint16_t)0x0008)
+#define GPIO_PIN_4   ((uint16_t)0x0010)
+#define GPIO_PIN_5   ((uint16_t)0x0020)
+#define GPIO_PIN_6   ((uint16_t)0x0040)
+#define GPIO_PIN_7   ((uint16_t)0x0080)
+#define GPIO_PIN_8   ((uint16_t)0x0100)
+#define GPIO_PIN_9   ((uint16_t)0x0200)
+#define GPIO_PIN_10  ((uint16_t)0x0400)
+#define GPIO_PIN_11  ((uint16_t)0x0800)
+#define GPIO_PIN_12  ((uint16_t)0x1000)
+#define GPIO_PIN_13  ((uint16_t)0x2000)
+#define GPIO_PIN_14  ((uint16_t)0x4000)
+#define GPIO_PIN_15  ((uint16_t)0x8000)
+#define GPIO_PIN_All ((uint16_t)0xFFFF)
+
+#define GPIO_MODE_INPUT             0x00000000U
+#define GPIO_MODE_OUTPUT_PP         0x00000001U
+#define GPIO_MODE_OUTPUT_OD         0x00000011U
+#define GPIO_MODE_AF_OD             0x00000012U
+#define GPIO_NOPULL                 0x00000000U
+#define GPIO_PULLUP                 0x00000001U
+#define GPIO_SPEED_FREQ_LOW         0x00000000U
+
+typedef struct {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+
+// ----------------------------------------------------------------------------- I2C
+
+#define HAL_I2C_ERROR_NONE      0x00000000U
+#define HAL_I2C_ERROR_BERR      0x00000001U
+#define HAL_I2C_ERROR_ARLO      0x00000002U
+#define HAL_I2C_ERROR_AF        0x00000004U
+#define HAL_I2C_ERROR_OVR       0x00000008U
+#define HAL_I2C_ERROR_TIMEOUT   0x00000020U
+
+typedef struct {
+    Simulated_I2C_bus *Instance;
+    volatile uint32_t ErrorCode;
+} I2C_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+// ----------------------------------------------------------------------------- SPI
+
+#define HAL_SPI_ERROR_NONE      0x00000000U
+#define HAL_SPI_ERROR_MODF      0x00000001U
+#define HAL_SPI_ERROR_OVR       0x00000004U
+#define HAL_SPI_ERROR_DMA       0x00000010U
+#define HAL_SPI_ERROR_FLAG      0x00000020U
+
+typedef struct {
+    Simulated_SPI_bus *Instance;
+    volatile uint32_t ErrorCode;
+} SPI_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size);
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi);
+
+// ----------------------------------------------------------------------------- UART
+
+#define HAL_UART_ERROR_NONE     0x00000000U
+#define HAL_UART_ERROR_ORE      0x00000008U
+
+typedef struct {
+    Simulated_UART *Instance;
+    volatile uint32_t ErrorCode;
+} UART_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+
+// ----------------------------------------------------------------------------- USB device (CDC class of USB device library)
+
+#define USBD_OK     0U
+#define USBD_BUSY   1U
+#define USBD_FAIL   3U
+
+typedef struct {
+    Simulated_USB_CDC *Instance;
+} USBD_HandleTypeDef;
+
+/**
+ * @brief   Handle of USB device, on MCU is generated by CubeMX in usb_device.c
+ */
+extern USBD_HandleTypeDef hUsbDeviceFS;
+
+uint8_t USBD_CDC_SetTxBuffer(USBD_HandleTypeDef *pdev, uint8_t *pbuff, uint32_t length);
+uint8_t USBD_CDC_SetRxBuffer(USBD_HandleTypeDef *pdev, uint8_t *pbuff);
+uint8_t USBD_CDC_TransmitPacket(USBD_HandleTypeDef *pdev);
+uint8_t USBD_CDC_ReceivePacket(USBD_HandleTypeDef *pdev);
+
+/**
+ * @brief   Callbacks of CDC interface, on MCU are part of usbd_cdc_if.c generated by CubeMX
+ */
+int8_t CDC_Receive_FS(uint8_t *Buf, uint32_t *Len);
+int8_t CDC_TransmitCplt_FS(uint8_t *Buf, uint32_t *Len, uint8_t epnum);
+
+// ----------------------------------------------------------------------------- RTC
+
+#define RTC_HOURFORMAT_24               0x00000000U
+#define RTC_OUTPUT_DISABLE              0x00000000U
+#define RTC_OUTPUT_REMAP_NONE           0x00000000U
+#define RTC_OUTPUT_POLARITY_HIGH        0x00000000U
+#define RTC_OUTPUT_TYPE_OPENDRAIN       0x00000000U
+#define RTC_DAYLIGHTSAVING_NONE         0x00000000U
+#define RTC_STOREOPERATION_RESET        0x00000000U
+#define RTC_FORMAT_BIN                  0x00000000U
+#define RTC_WEEKDAY_MONDAY              ((uint8_t)0x01)
+
+#define RTC_ALARMMASK_NONE              0x00000000U
+#define RTC_ALARMMASK_DATEWEEKDAY       0x80000000U
+#define RTC_ALARMMASK_HOURS             0x00800000U
+#define RTC_ALARMMASK_MINUTES           0x00008000U
+#define RTC_ALARMMASK_SECONDS           0x00000080U
+#define RTC_ALARMMASK_ALL               0x80808080U
+#define RTC_ALARMSUBSECONDMASK_ALL      0x00000000U
+#define RTC_ALARMSUBSECONDMASK_NONE     0x0F000000U
+#define RTC_ALARMDATEWEEKDAYSEL_DATE    0x00000000U
+#define RTC_ALARMDATEWEEKDAYSEL_WEEKDAY 0x40000000U
+#define RTC_ALARM_A                     0x00000100U
+
+typedef struct {
+    uint32_t HourFormat;
+    uint32_t AsynchPrediv;
+    uint32_t SynchPrediv;
+    uint32_t OutPut;
+    uint32_t OutPutRemap;
+    uint32_t OutPutPolarity;
+    uint32_t OutPutType;
+} RTC_InitTypeDef;
+
+typedef struct {
+    Simulated_RTC *Instance;
+    RTC_InitTypeDef Init;
+} RTC_HandleTypeDef;
+
+typedef struct {
+    uint8_t Hours;
+    uint8_t Minutes;
+    uint8_t Seconds;
+    uint8_t TimeFormat;
+    uint32_t SubSeconds;
+    uint32_t SecondFraction;
+    uint32_t DayLightSaving;
+    uint32_t StoreOperation;
+} RTC_TimeTypeDef;
+
+typedef struct {
+    uint8_t WeekDay;
+    uint8_t Month;
+    uint8_t Date;
+    uint8_t Year;
+} RTC_DateTypeDef;
+
+typedef struct {
+    RTC_TimeTypeDef AlarmTime;
+    uint32_t AlarmMask;
+    uint32_t AlarmSubSecondMask;
+    uint32_t AlarmDateWeekDaySel;
+    uint8_t AlarmDateWeekDay;
+    uint32_t Alarm;
+} RTC_AlarmTypeDef;
+
+/**
+ * @brief   RTC is only one per MCU, so it is simulated by single object
+ */
+extern Simulated_RTC host_rtc;
+
+#define RTC (&host_rtc)
+
+HAL_StatusTypeDef HAL_RTC_Init(RTC_HandleTypeDef *hrtc);
+HAL_StatusTypeDef HAL_RTC_SetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_SetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_SetAlarm_IT(RTC_HandleTypeDef *hrtc, RTC_AlarmTypeDef *sAlarm, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_GetAlarm(RTC_HandleTypeDef *hrtc, RTC_AlarmTypeDef *sAlarm, uint32_t Alarm, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_DeactivateAlarm(RTC_HandleTypeDef *hrtc, uint32_t Alarm);
+void HAL_RTC_AlarmAEventCallback(RTC_HandleTypeDef *hrtc);
@@ -0,0 +1,239 @@
+#include "simulated_devices.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+Simulated_TMP117::Simulated_TMP117(uint8_t address) :
+    Simulated_register_device(address, 1)
+{
+    registers.fill(0);
+    registers[0x00] = 0x8000;   // Temp_Result
+    registers[0x01] = 0x0220;   // Configuration
+    registers[0x02] = 0x6000;   // THigh_Limit
+    registers[0x03] = 0x8000;   // TLow_Limit
+    registers[0x0f] = 0x0117;   // Device_ID
+}
+
+uint8_t Simulated_TMP117::Load(uint32_t position){
+    uint8_t index = (position / 2) & 0x0f;
+    uint8_t value = (position % 2) ? (registers[index] & 0xff) : (registers[index] >> 8);
+    if (index == 0x01 && (position % 2)) {   // Data ready is cleared by read of configuration
+        registers[0x01] &= ~(1 << 13);
+    }
+    return value;
+}
+
+bool Simulated_TMP117::Store(uint32_t position, uint8_t value){
+    uint8_t index = (position / 2) & 0x0f;
+    if (index == 0x00 || index == 0x0f) {   // Read only registers
+        return true;
+    }
+    uint16_t mask = (position % 2) ? 0x00ff : 0xff00;
+    uint16_t shifted = (position % 2) ? value : (value << 8);
+    if (index == 0x01) {    // Flags of configuration are read only
+        mask &= ~0xe001;
+    }
+    registers[index] = (registers[index] & ~mask) | (shifted & mask);
+    return true;
+}
+
+void Simulated_TMP117::Temperature(float celsius){
+    registers[0x00] = static_cast<uint16_t>(static_cast<int16_t>(std::lround(celsius / 0.0078125f)));
+    registers[0x01] |= (1 << 13);
+}
+
+Simulated_LIS2DW12::Simulated_LIS2DW12(uint8_t address) :
+    Simulated_register_device(address, 1)
+{
+    registers[0x0f] = 0x44; // WHO_AM_I
+    registers[0x21] = 0x04; // CTRL2, IF_ADD_INC
+}
+
+uint32_t Simulated_LIS2DW12::Next(uint32_t position, bool write){
+    (void)write;
+    if (registers[0x21] & 0x04) {
+        if (position == 0x2d && Fifo_enabled()) { // Burst read of FIFO continues by next sample
+            return 0x28;
+        }
+        return (position + 1) & 0x3f;
+    }
+    return position;
+}
+
+uint8_t Simulated_LIS2DW12::Load(uint32_t position){
+    if (position == 0x2f) { // FIFO_SAMPLES: threshold flag, overrun flag, number of samples
+        uint8_t threshold = registers[0x2e] & 0x1f;
+        bool reached = Fifo_enabled() && threshold > 0 && fifo.size() >= threshold;
+        return (reached << 7) | (overrun << 6) | static_cast<uint8_t>(fifo.size());
+    }
+    if (Fifo_enabled() && position >= 0x28 && position <= 0x2d) {
+        if (fifo.empty()) {
+            return registers[position];
+        }
+        uint8_t value = fifo.front()[position - 0x28];
+        if (position == 0x2d) {
+            fifo.pop_front();
+            overrun = false;
+        }
+        return value;
+    }
+    uint8_t value = registers[position];
+    if (position == 0x2d) { // Data ready is cleared by read of last output register
+        registers[0x27] &= ~0x01;
+    }
+    return value;
+}
+
+bool Simulated_LIS2DW12::Store(uint32_t position, uint8_t value){
+    bool read_only = (position >= 0x0d && position <= 0x0f) || (position >= 0x26 && position <= 0x2d) || position == 0x2f;
+    if (not read_only) {
+        registers[position] = value;
+    }
+    if (position == 0x2e && !Fifo_enabled()) { // Bypass mode resets FIFO
+        fifo.clear();
+        overrun = false;
+    }
+    return true;
+}
+
+void Simulated_LIS2DW12::Acceleration(int16_t x, int16_t y, int16_t z){
+    int16_t axes[3] = {x, y, z};
+    std::array<uint8_t, 6> sample;
+    for (int i = 0; i < 3; i++) {
+        sample[i * 2] = static_cast<uint16_t>(axes[i]) & 0xff;
+        sample[i * 2 + 1] = static_cast<uint16_t>(axes[i]) >> 8;
+    }
+    std::copy(sample.begin(), sample.end(), registers.begin() + 0x28);
+    registers[0x27] |= 0x01;
+
+    if (!Fifo_enabled()) {
+        return;
+    }
+    if (fifo.size() < 32) {
+        fifo.push_back(sample);
+    } else if ((registers[0x2e] >> 5) == 0b110) { // Continuous mode overwrites oldest sample
+        fifo.pop_front();
+        fifo.push_back(sample);
+        overrun = true;
+    } else {    // FIFO mode stops collecting when full
+        overrun = true;
+    }
+}
+
+Simulated_M24xx::Simulated_M24xx(uint8_t address, uint32_t size, uint32_t page_size, uint64_t write_time) :
+    Simulated_register_device(address, 2, write_time),
+    memory(size, 0xff),
+    page_size(page_size)
+{ }
+
+uint32_t Simulated_M24xx::Next(uint32_t position, bool write){
+    if (write) {    // Roll over inside of page
+        return (position & ~(page_size - 1)) | ((position + 1) & (page_size - 1));
+    }
+    return (position + 1) % memory.size();
+}
+
+bool Simulated_M24xx::Store(uint32_t position, uint8_t value){
+    memory[position] = value;
+    return true;
+}
+
+Simulated_ST25DV::Simulated_ST25DV(uint32_t memory_size, uint64_t password, uint8_t address, uint8_t system_address) :
+    Simulated_register_device(address, 2, 5000000),
+    system_address(system_address),
+    memory(memory_size, 0x00),
+    password(password)
+{
+    uint16_t blocks = memory_size / 4 - 1;
+    system[0x14] = blocks & 0xff;                   // MEM_SIZE
+    system[0x15] = blocks >> 8;
+    system[0x16] = 0x03;                            // BLK_SIZE
+    system[0x17] = (memory_size > 512) ? 0x26 : 0x24;   // IC_REF
+    system[0x1e] = 0x02;                            // MANUF_CODE
+    system[0x1f] = 0xe0;
+    system[0x20] = 0x11;                            // IC_REV
+}
+
+bool Simulated_ST25DV::Acknowledge(uint8_t address){
+    if ((address & 0xfe) == system_address) {
+        return Simulated_register_device::Acknowledge(this->address);
+    }
+    return Simulated_register_device::Acknowledge(address);
+}
+
+uint16_t Simulated_ST25DV::Write(uint8_t address, const uint8_t *data, uint16_t length){
+    system_area = ((address & 0xfe) == system_address);
+    return Simulated_register_device::Write(address, data, length);
+}
+
+void Simulated_ST25DV::Read(uint8_t address, uint8_t *data, uint16_t length){
+    system_area = ((address & 0xfe) == system_address);
+    Simulated_register_device::Read(address, data, length);
+}
+
+uint8_t Simulated_ST25DV::Load(uint32_t position){
+    if (system_area) {
+        return (position < system.size()) ? system[position] : 0x00;
+    }
+    if (position < memory.size()) {
+        return memory[position];
+    } else if (position >= dynamic_start && position < mailbox_start) {
+        uint8_t value = dynamic[position - dynamic_start];
+        if (position == dynamic_start + 5) {    // IT_STS is cleared by read
+            dynamic[5] = 0;
+        }
+        return value;
+    } else if (position >= mailbox_start && position < mailbox_start + mailbox_size) {
+        return mailbox[position - mailbox_start];
+    }
+    return 0x00;
+}
+
+bool Simulated_ST25DV::Store(uint32_t position, uint8_t value){
+    if (system_area) {
+        if (position >= password_start && position < password_start + password_length) {
+            password_buffer[position - password_start] = value;
+            return true;
+        }
+        if (position < system.size() && Session_open() && position < 0x14) {
+            system[position] = value;
+            return true;
+        }
+        return false;
+    }
+    if (position < memory.size()) {
+        memory[position] = value;
+        return true;
+    } else if (position >= dynamic_start && position < mailbox_start) {
+        uint8_t index = position - dynamic_start;
+        if (index == 4 || index == 5 || index == 7) {   // I2C_SSO, IT_STS and MB_LEN are read only
+            return false;
+        }
+        dynamic[index] = value;
+        return true;
+    } else if (position >= mailbox_start && position < mailbox_start + mailbox_size) {
+        mailbox[position - mailbox_start] = value;
+        dynamic[7] = position - mailbox_start;
+        return true;
+    }
+    return false;
+}
+
+void Simulated_ST25DV::Written(uint32_t position, uint16_t length){
+    if (system_area && position == password_start) {
+        write_pending = false;  // Password is not stored into EEPROM
+        if (length != password_length) {
+            return;
+        }
+        uint64_t first = 0;
+        uint64_t second = 0;
+        for (int i = 0; i < 8; i++) {
+            first |= static_cast<uint64_t>(password_buffer[i]) << (i * 8);
+            second |= static_cast<uint64_t>(password_buffer[i + 9]) << (i * 8);
+        }
+        bool valid = (password_buffer[8] == 0x09) && (first == password) && (second == password);
+        dynamic[4] = valid ? 0x01 : 0x00;
+    } else if (not system_area && position >= dynamic_start) {
+        write_pending = false;  // Dynamic registers and mailbox are volatile
+    }
+}
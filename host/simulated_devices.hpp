@@ -0,0 +1,210 @@
+/**
+ * @file simulated_devices.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "host/simulated_i2c.hpp"
+
+/**
+ * @brief   Model of TMP117 temperature sensor, 16-bit registers are transmitted MSB first
+ *          Data ready flag is set by new temperature and cleared by read of configuration register
+ */
+class Simulated_TMP117 : public Simulated_register_device {
+private:
+    std::array<uint16_t, 16> registers;
+
+    uint32_t Position(uint32_t register_address) override { return (register_address & 0x0f) * 2; };
+
+    uint8_t Load(uint32_t position) override;
+
+    bool Store(uint32_t position, uint8_t value) override;
+
+public:
+    /**
+     * @brief Construct a new Simulated_TMP117 object
+     *
+     * @param address   Address of sensor in 8-bit format
+     */
+    Simulated_TMP117(uint8_t address = 0x90);
+
+    /**
+     * @brief   Set result of conversion
+     *
+     * @param celsius   Temperature in Celsius
+     */
+    void Temperature(float celsius);
+
+    /**
+     * @brief   Return value of register
+     */
+    uint16_t Register(uint8_t index) const { return registers[index & 0x0f]; };
+};
+
+/**
+ * @brief   Model of LIS2DW12 accelerometer, register address is incremented if IF_ADD_INC of CTRL2 is set
+ *          When FIFO is enabled by FIFO_CTRL, samples are queued (32 samples), output registers show oldest sample,
+ *              read of OUT_Z_H removes it and address rolls over to OUT_X_L
+ */
+class Simulated_LIS2DW12 : public Simulated_register_device {
+private:
+    std::array<uint8_t, 0x40> registers = {};
+
+    /**
+     * @brief   Samples in FIFO, bytes of output registers OUT_X_L to OUT_Z_H
+     */
+    std::deque<std::array<uint8_t, 6>> fifo;
+
+    /**
+     * @brief   FIFO overrun flag, sample was lost since FIFO was enabled
+     */
+    bool overrun = false;
+
+    /**
+     * @brief   Return true if FIFO is enabled (FMODE of FIFO_CTRL is not bypass)
+     */
+    bool Fifo_enabled() const { return registers[0x2e] & 0xe0; };
+
+    uint32_t Position(uint32_t register_address) override { return register_address & 0x3f; };
+
+    uint32_t Next(uint32_t position, bool write) override;
+
+    uint8_t Load(uint32_t position) override;
+
+    bool Store(uint32_t position, uint8_t value) override;
+
+public:
+    /**
+     * @brief Construct a new Simulated_LIS2DW12 object
+     *
+     * @param address   Address of sensor in 8-bit format
+     */
+    Simulated_LIS2DW12(uint8_t address = 0x32);
+
+    /**
+     * @brief   Set new sample of acceleration, sets data ready flag in STATUS
+     *
+     * @param x Raw value of axis X
+     * @param y Raw value of axis Y
+     * @param z Raw value of axis Z
+     */
+    void Acceleration(int16_t x, int16_t y, int16_t z);
+
+    /**
+     * @brief   Return value of register
+     */
+    uint8_t Register(uint8_t index) const { return registers[index & 0x3f]; };
+
+    /**
+     * @brief   Return number of samples in FIFO
+     */
+    std::size_t Fifo_level() const { return fifo.size(); };
+};
+
+/**
+ * @brief   Model of M24xx EEPROM with 16-bit memory address
+ *          Write rolls over at page boundary, device does not acknowledge during write cycle (5 ms)
+ */
+class Simulated_M24xx : public Simulated_register_device {
+private:
+    std::vector<uint8_t> memory;
+
+    uint32_t page_size;
+
+    uint32_t Position(uint32_t register_address) override { return register_address % memory.size(); };
+
+    uint32_t Next(uint32_t position, bool write) override;
+
+    uint8_t Load(uint32_t position) override { return memory[position]; };
+
+    bool Store(uint32_t position, uint8_t value) override;
+
+public:
+    /**
+     * @brief Construct a new Simulated_M24xx object
+     *
+     * @param address       Address of memory in 8-bit format
+     * @param size          Size of memory in bytes
+     * @param page_size     Size of page in bytes, must be power of two
+     * @param write_time    Duration of write cycle in ns
+     */
+    Simulated_M24xx(uint8_t address = 0xa0, uint32_t size = 4096, uint32_t page_size = 32, uint64_t write_time = 5000000);
+
+    /**
+     * @brief   Direct access to content of memory
+     */
+    std::vector<uint8_t> &Memory(){ return memory; };
+};
+
+/**
+ * @brief   Model of ST25DV0xK NFC tag with user memory, dynamic registers and mailbox on user address
+ *              and system configuration on system address
+ *          System configuration can be written only in open I2C security session (I2C_SSO),
+ *              which is opened by presentation of correct password
+ */
+class Simulated_ST25DV : public Simulated_register_device {
+public:
+    static constexpr uint16_t dynamic_start = 0x2000;
+    static constexpr uint16_t mailbox_start = 0x2008;
+    static constexpr uint16_t mailbox_size = 256;
+    static constexpr uint16_t password_start = 0x0900;
+    static constexpr uint16_t password_length = 17;
+
+private:
+    uint8_t system_address;
+
+    /**
+     * @brief   True if actual transaction is addressed to system area
+     */
+    bool system_area = false;
+
+    std::vector<uint8_t> memory;
+    std::array<uint8_t, 0x28> system = {};
+    std::array<uint8_t, 8> dynamic = {};
+    std::array<uint8_t, mailbox_size> mailbox = {};
+    std::array<uint8_t, password_length> password_buffer = {};
+
+    uint64_t password;
+
+    uint8_t Load(uint32_t position) override;
+
+    bool Store(uint32_t position, uint8_t value) override;
+
+    void Written(uint32_t position, uint16_t length) override;
+
+public:
+    /**
+     * @brief Construct a new Simulated_ST25DV object
+     *
+     * @param memory_size       Size of user memory in bytes
+     * @param password          I2C password
+     * @param address           Address of user memory in 8-bit format
+     * @param system_address    Address of system area in 8-bit format
+     */
+    Simulated_ST25DV(uint32_t memory_size = 512, uint64_t password = 0, uint8_t address = 0xa6, uint8_t system_address = 0xae);
+
+    bool Acknowledge(uint8_t address) override;
+
+    uint16_t Write(uint8_t address, const uint8_t *data, uint16_t length) override;
+
+    void Read(uint8_t address, uint8_t *data, uint16_t length) override;
+
+    /**
+     * @brief   Return true if I2C security session is open
+     */
+    bool Session_open() const { return dynamic[4] & 0x01; };
+
+    /**
+     * @brief   Direct access to content of user memory
+     */
+    std::vector<uint8_t> &Memory(){ return memory; };
+};
@@ -0,0 +1,45 @@
+#include "simulated_gpio.hpp"
+
+#include "host/virtual_clock.hpp"
+
+GPIO_TypeDef host_gpio[8] = {};
+
+void Simulated_GPIO::Drive(GPIO_TypeDef *port, uint16_t pin, bool level){
+    uint32_t previous = port->IDR;
+    port->IDR = level ? (previous | pin) : (previous & ~pin);
+    uint32_t rising = ~previous & port->IDR & port->RTSR;
+    uint32_t falling = previous & ~port->IDR & port->FTSR;
+    if ((rising | falling) & pin) {
+        HAL_GPIO_EXTI_Callback(pin);
+    }
+    if ((previous ^ port->IDR) & pin) {
+        for (auto &entry : watches) {
+            if (entry.port == port && (entry.pin & pin)) {
+                entry.watcher(level);
+            }
+        }
+    }
+}
+
+void Simulated_GPIO::Watch(GPIO_TypeDef *port, uint16_t pin, Watcher watcher){
+    watches.push_back({port, pin, std::move(watcher)});
+}
+
+void Simulated_GPIO::Drive_at(uint64_t time, GPIO_TypeDef *port, uint16_t pin, bool level){
+    Virtual_clock::Schedule(time, [port, pin, level](){ Drive(port, pin, level); });
+}
+
+void Simulated_GPIO::Interrupt(GPIO_TypeDef *port, uint16_t pin, bool rising, bool falling){
+    port->RTSR = rising ? (port->RTSR | pin) : (port->RTSR & ~pin);
+    port->FTSR = falling ? (port->FTSR | pin) : (port->FTSR & ~pin);
+}
+
+void Simulated_GPIO::Reset(){
+    for (auto &port : host_gpio) {
+        port.IDR = 0;
+        port.ODR = 0;
+        port.RTSR = 0;
+        port.FTSR = 0;
+    }
+    watches.clear();
+}
@@ -0,0 +1,85 @@
+/**
+ * @file simulated_gpio.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "host/host_hal.hpp"
+
+/**
+ * @brief   External side of simulated GPIO ports, drives inputs of MCU
+ *          Edge on pin with enabled EXTI (RTSR/FTSR of port) invokes HAL_GPIO_EXTI_Callback
+ *          Simulated peripherals can watch changes of level of pins driven by MCU
+ */
+class Simulated_GPIO {
+public:
+    /**
+     * @brief   Function called with new level of watched pin
+     */
+    using Watcher = std::function<void(bool)>;
+
+private:
+    struct Watch_entry {
+        GPIO_TypeDef *port;
+        uint16_t pin;
+        Watcher watcher;
+    };
+
+    static inline std::vector<Watch_entry> watches;
+
+public:
+    /**
+     * @brief   Drive level of pin by external device
+     *
+     * @param port  Port of pin (GPIOA, GPIOB, ...)
+     * @param pin   Mask of pin (GPIO_PIN_x)
+     * @param level Logic level
+     */
+    static void Drive(GPIO_TypeDef *port, uint16_t pin, bool level);
+
+    /**
+     * @brief   Schedule change of level of pin, for example interrupt line of sensor
+     *
+     * @param time  Time of change in ns of Virtual_clock
+     * @param port  Port of pin
+     * @param pin   Mask of pin
+     * @param level Logic level
+     */
+    static void Drive_at(uint64_t time, GPIO_TypeDef *port, uint16_t pin, bool level);
+
+    /**
+     * @brief   Enable EXTI on edges of pin
+     *
+     * @param port      Port of pin
+     * @param pin       Mask of pin
+     * @param rising    Interrupt on rising edge
+     * @param falling   Interrupt on falling edge
+     */
+    static void Interrupt(GPIO_TypeDef *port, uint16_t pin, bool rising, bool falling);
+
+    /**
+     * @brief   Call watcher on every change of level of pin
+     *
+     * @param port      Port of pin
+     * @param pin       Mask of pin
+     * @param watcher   Function called with new level
+     */
+    static void Watch(GPIO_TypeDef *port, uint16_t pin, Watcher watcher);
+
+    /**
+     * @brief   Return level driven by MCU on output
+     */
+    static bool Output(GPIO_TypeDef *port, uint16_t pin){ return port->ODR & pin; };
+
+    /**
+     * @brief   Reset all ports
+     */
+    static void Reset();
+};
@@ -0,0 +1,192 @@
+#include "simulated_i2c.hpp"
+
+#include <algorithm>
+
+#include "host/simulated_gpio.hpp"
+#include "host/virtual_clock.hpp"
+
+bool Simulated_register_device::Acknowledge(uint8_t address){
+    return Simulated_I2C_device::Acknowledge(address) && (Virtual_clock::Now() >= busy_until);
+}
+
+uint16_t Simulated_register_device::Write(uint8_t address, const uint8_t *data, uint16_t length){
+    (void)address;
+    uint16_t index = 0;
+    if (length >= address_size) {
+        uint32_t register_address = 0;
+        for (; index < address_size; index++) {
+            register_address = (register_address << 8) | data[index];
+        }
+        pointer = Position(register_address);
+    } else {    // Incomplete address, pointer is not changed
+        return length;
+    }
+
+    uint32_t start = pointer;
+    for (; index < length; index++) {
+        if (not Store(pointer, data[index])) {
+            break;
+        }
+        pointer = Next(pointer, true);
+    }
+    if (index > address_size) {
+        write_pending = (write_time > 0);
+        Written(start, index - address_size);
+    }
+    return index;
+}
+
+void Simulated_register_device::Read(uint8_t address, uint8_t *data, uint16_t length){
+    (void)address;
+    for (uint16_t i = 0; i < length; i++) {
+        data[i] = Load(pointer);
+        pointer = Next(pointer, false);
+    }
+}
+
+void Simulated_register_device::Stop(){
+    if (write_pending) {
+        busy_until = Virtual_clock::Now() + write_time;
+        write_pending = false;
+    }
+}
+
+Simulated_I2C_bus::Simulated_I2C_bus(uint32_t speed) :
+    speed(speed)
+{ }
+
+void Simulated_I2C_bus::Attach(Simulated_I2C_device &device){
+    if (std::find(devices.begin(), devices.end(), &device) == devices.end()) {
+        devices.push_back(&device);
+    }
+}
+
+void Simulated_I2C_bus::Detach(Simulated_I2C_device &device){
+    devices.erase(std::remove(devices.begin(), devices.end(), &device), devices.end());
+}
+
+Simulated_I2C_device *Simulated_I2C_bus::Find(uint8_t address){
+    for (auto device : devices) {
+        if (device->Acknowledge(address)) {
+            return device;
+        }
+    }
+    return nullptr;
+}
+
+uint64_t Simulated_I2C_bus::Duration(uint32_t bytes) const{
+    // Start and stop condition + 9 bits (data and ACK) per byte
+    return (2 + 9ULL * bytes) * 1000000000ULL / speed;
+}
+
+void Simulated_I2C_bus::Transfer(uint32_t bytes){
+    uint64_t duration = Duration(bytes);
+    statistics.transactions++;
+    statistics.bytes += bytes;
+    statistics.busy_time += duration;
+    if (background) {
+        background_time += duration;
+    } else {
+        Virtual_clock::Advance(duration);
+    }
+}
+
+HAL_StatusTypeDef Simulated_I2C_bus::Transfer_IT(I2C_HandleTypeDef *hi2c, uint8_t address, uint8_t *data, uint16_t length, bool receive){
+    if (it_busy) {
+        return HAL_BUSY;
+    }
+    background = true;
+    background_time = 0;
+    uint32_t error = receive ? Receive(address, data, length) : Transmit(address, data, length);
+    background = false;
+    it_busy = true;
+    Virtual_clock::Schedule_after(background_time, [this, hi2c, error, receive](){
+        it_busy = false;
+        hi2c->ErrorCode = error;
+        if (error != HAL_I2C_ERROR_NONE) {
+            HAL_I2C_ErrorCallback(hi2c);
+        } else if (receive) {
+            HAL_I2C_MasterRxCpltCallback(hi2c);
+        } else {
+            HAL_I2C_MasterTxCpltCallback(hi2c);
+        }
+    });
+    return HAL_OK;
+}
+
+void Simulated_I2C_bus::Lines(GPIO_TypeDef *scl_port, uint16_t scl_pin, GPIO_TypeDef *sda_port, uint16_t sda_pin){
+    this->sda_port = sda_port;
+    this->sda_pin = sda_pin;
+    Simulated_GPIO::Drive(scl_port, scl_pin, true);
+    Simulated_GPIO::Drive(sda_port, sda_pin, !Held());
+    Simulated_GPIO::Watch(scl_port, scl_pin, [this](bool level){
+        if (level && held_clocks > 0 && --held_clocks == 0) {
+            Simulated_GPIO::Drive(this->sda_port, this->sda_pin, true);
+        }
+    });
+    // Open drain, slave keeps SDA low even if MCU releases it
+    Simulated_GPIO::Watch(sda_port, sda_pin, [this](bool level){
+        if (level && Held()) {
+            Simulated_GPIO::Drive(this->sda_port, this->sda_pin, false);
+        }
+    });
+}
+
+void Simulated_I2C_bus::Hold_SDA(uint8_t clocks){
+    held_clocks = clocks;
+    if (sda_port) {
+        Simulated_GPIO::Drive(sda_port, sda_pin, !Held());
+    }
+}
+
+uint32_t Simulated_I2C_bus::Transmit(uint8_t address, const uint8_t *data, uint16_t length){
+    if (Held()) {
+        return HAL_I2C_ERROR_TIMEOUT;
+    }
+    Simulated_I2C_device *device = Find(address);
+    if (device == nullptr) {
+        statistics.nacks++;
+        Transfer(1);
+        return HAL_I2C_ERROR_AF;
+    }
+    uint16_t acknowledged = device->Write(address, data, length);
+    // Master stops transfer after first not acknowledged byte
+    Transfer(1 + std::min<uint16_t>(acknowledged + 1, length));
+    device->Stop();
+    if (acknowledged < length) {
+        statistics.nacks++;
+        return HAL_I2C_ERROR_AF;
+    }
+    return HAL_I2C_ERROR_NONE;
+}
+
+uint32_t Simulated_I2C_bus::Receive(uint8_t address, uint8_t *data, uint16_t length){
+    if (Held()) {
+        return HAL_I2C_ERROR_TIMEOUT;
+    }
+    Simulated_I2C_device *device = Find(address);
+    if (device == nullptr) {
+        statistics.nacks++;
+        Transfer(1);
+        return HAL_I2C_ERROR_AF;
+    }
+    device->Read(address, data, length);
+    Transfer(1 + length);
+    device->Stop();
+    return HAL_I2C_ERROR_NONE;
+}
+
+uint32_t Simulated_I2C_bus::Probe(uint8_t address, uint32_t trials){
+    if (Held()) {
+        return HAL_I2C_ERROR_TIMEOUT;
+    }
+    for (uint32_t trial = 0; trial < trials; trial++) {
+        bool present = Find(address) != nullptr;
+        Transfer(1);
+        if (present) {
+            return HAL_I2C_ERROR_NONE;
+        }
+        statistics.nacks++;
+    }
+    return HAL_I2C_ERROR_AF;
+}
@@ -0,0 +1,335 @@
+/**
+ * @file simulated_i2c.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "host/host_hal.hpp"
+
+/**
+ * @brief   Device connected to Simulated_I2C_bus
+ *          Addresses are in 8-bit format (7-bit address shifted to left) as in HAL and drivers
+ */
+class Simulated_I2C_device {
+protected:
+    /**
+     * @brief   Address of device in 8-bit format
+     */
+    uint8_t address;
+
+public:
+    /**
+     * @brief Construct a new Simulated_I2C_device object
+     *
+     * @param address   Address of device in 8-bit format
+     */
+    Simulated_I2C_device(uint8_t address) :
+        address(address)
+    { }
+
+    virtual ~Simulated_I2C_device() = default;
+
+    /**
+     * @brief   Address phase of transaction
+     *
+     * @param address   Address transmitted by master
+     * @return true     Device acknowledges address
+     * @return false    Address does not belong to device or device is busy
+     */
+    virtual bool Acknowledge(uint8_t address){ return (address & 0xfe) == this->address; };
+
+    /**
+     * @brief   Data of write transaction, is invoked after address was acknowledged
+     *
+     * @param address   Address transmitted by master
+     * @param data      Received data
+     * @param length    Number of bytes
+     * @return uint16_t Number of acknowledged bytes, lower than length if device NACKed
+     */
+    virtual uint16_t Write(uint8_t address, const uint8_t *data, uint16_t length) = 0;
+
+    /**
+     * @brief   Data of read transaction, is invoked after address was acknowledged
+     *
+     * @param address   Address transmitted by master
+     * @param data      Buffer for transmitted data
+     * @param length    Number of bytes
+     */
+    virtual void Read(uint8_t address, uint8_t *data, uint16_t length) = 0;
+
+    /**
+     * @brief   Stop condition at the end of transaction addressed to device
+     */
+    virtual void Stop(){ };
+};
+
+/**
+ * @brief   Device with internal address pointer, which is set by first bytes of write transaction
+ *          Model of sensors and memories: register (memory) address is followed by data,
+ *              read transaction continues from pointer, pointer is incremented after every byte
+ *          Optional write cycle time models EEPROM, device does not acknowledge address until write is finished
+ */
+class Simulated_register_device : public Simulated_I2C_device {
+protected:
+    /**
+     * @brief   Size of register address in bytes, transmitted as big endian
+     */
+    uint8_t address_size;
+
+    /**
+     * @brief   Internal position of pointer
+     */
+    uint32_t pointer = 0;
+
+    /**
+     * @brief   Duration of internal write cycle in ns, 0 for devices without write cycle
+     */
+    uint64_t write_time;
+
+    /**
+     * @brief   Time until which is device busy by write cycle
+     */
+    uint64_t busy_until = 0;
+
+    /**
+     * @brief   True if data were written during actual transaction, write cycle starts by stop condition
+     */
+    bool write_pending = false;
+
+    /**
+     * @brief   Convert register address received from master to internal position
+     */
+    virtual uint32_t Position(uint32_t register_address){ return register_address; };
+
+    /**
+     * @brief   Return position following given position
+     *
+     * @param position  Actual position
+     * @param write     True during write transaction
+     */
+    virtual uint32_t Next(uint32_t position, bool write){
+        (void)write;
+        return position + 1;
+    };
+
+    /**
+     * @brief   Return byte at position
+     */
+    virtual uint8_t Load(uint32_t position) = 0;
+
+    /**
+     * @brief   Store byte at position
+     *
+     * @return true     Byte is acknowledged
+     * @return false    Byte is not acknowledged, for example write protected area
+     */
+    virtual bool Store(uint32_t position, uint8_t value) = 0;
+
+    /**
+     * @brief   Invoked after write transaction which contained data
+     *
+     * @param position  Position of first written byte
+     * @param length    Number of written bytes
+     */
+    virtual void Written(uint32_t position, uint16_t length){
+        (void)position;
+        (void)length;
+    };
+
+public:
+    /**
+     * @brief Construct a new Simulated_register_device object
+     *
+     * @param address       Address of device in 8-bit format
+     * @param address_size  Size of register address in bytes
+     * @param write_time    Duration of write cycle in ns
+     */
+    Simulated_register_device(uint8_t address, uint8_t address_size = 1, uint64_t write_time = 0) :
+        Simulated_I2C_device(address), address_size(address_size), write_time(write_time)
+    { }
+
+    /**
+     * @brief   Return size of register address in bytes
+     */
+    uint8_t Address_size() const { return address_size; };
+
+    bool Acknowledge(uint8_t address) override;
+
+    uint16_t Write(uint8_t address, const uint8_t *data, uint16_t length) override;
+
+    void Read(uint8_t address, uint8_t *data, uint16_t length) override;
+
+    void Stop() override;
+};
+
+/**
+ * @brief   Simulated I2C bus, instance of I2C_HandleTypeDef on host
+ *          Duration of transactions is modeled by speed of bus and added to Virtual_clock,
+ *              so performance of drivers can be compared in time and number of transactions
+ */
+class Simulated_I2C_bus {
+public:
+    /**
+     * @brief   Counters of bus activity
+     */
+    struct Statistics {
+        uint32_t transactions = 0;
+        uint32_t nacks        = 0;
+        uint64_t bytes        = 0;
+        uint64_t busy_time    = 0;  // ns
+    };
+
+private:
+    /**
+     * @brief   Speed of bus in Hz
+     */
+    uint32_t speed;
+
+    /**
+     * @brief   Devices connected to bus
+     */
+    std::vector<Simulated_I2C_device *> devices;
+
+    Statistics statistics;
+
+    /**
+     * @brief   Number of SCL clocks until slave releases SDA, 0 if bus is free
+     */
+    uint8_t held_clocks = 0;
+
+    /**
+     * @brief   SDA line of bus, driven low while bus is held
+     */
+    GPIO_TypeDef *sda_port = nullptr;
+    uint16_t sda_pin = 0;
+
+    /**
+     * @brief   True while transfer in interrupt mode is executed, duration is accumulated instead of advancing clock
+     */
+    bool background = false;
+    uint64_t background_time = 0;
+
+    /**
+     * @brief   True until interrupt transfer is completed by callback
+     */
+    bool it_busy = false;
+
+    /**
+     * @brief   Return device which acknowledges address, nullptr if there is none
+     */
+    Simulated_I2C_device *Find(uint8_t address);
+
+    /**
+     * @brief   Move Virtual_clock by duration of transferred bits
+     *
+     * @param bytes Number of bytes including address
+     */
+    void Transfer(uint32_t bytes);
+
+public:
+    /**
+     * @brief Construct a new Simulated_I2C_bus object
+     *
+     * @param speed Speed of bus in Hz
+     */
+    Simulated_I2C_bus(uint32_t speed = 100000);
+
+    /**
+     * @brief   Connect device to bus
+     */
+    void Attach(Simulated_I2C_device &device);
+
+    /**
+     * @brief   Disconnect device from bus, device stops responding
+     */
+    void Detach(Simulated_I2C_device &device);
+
+    /**
+     * @brief   Change speed of bus
+     *
+     * @param speed Speed of bus in Hz
+     */
+    void Speed(uint32_t speed){ this->speed = speed; };
+
+    /**
+     * @brief   Return speed of bus in Hz
+     */
+    uint32_t Speed() const { return speed; };
+
+    /**
+     * @brief   Return duration of transaction in ns
+     *
+     * @param bytes Number of bytes including address
+     */
+    uint64_t Duration(uint32_t bytes) const;
+
+    /**
+     * @brief   Write transaction
+     *
+     * @return uint32_t HAL_I2C_ERROR_NONE, HAL_I2C_ERROR_AF or HAL_I2C_ERROR_TIMEOUT
+     */
+    uint32_t Transmit(uint8_t address, const uint8_t *data, uint16_t length);
+
+    /**
+     * @brief   Read transaction
+     *
+     * @return uint32_t HAL_I2C_ERROR_NONE, HAL_I2C_ERROR_AF or HAL_I2C_ERROR_TIMEOUT
+     */
+    uint32_t Receive(uint8_t address, uint8_t *data, uint16_t length);
+
+    /**
+     * @brief   Address only transactions until device acknowledges or trials are exhausted
+     *
+     * @return uint32_t HAL_I2C_ERROR_NONE, HAL_I2C_ERROR_AF or HAL_I2C_ERROR_TIMEOUT
+     */
+    uint32_t Probe(uint8_t address, uint32_t trials);
+
+    /**
+     * @brief   Transfer in interrupt mode, HAL callback is invoked from event of clock after duration of transfer
+     *          Data are exchanged with device at start of transfer
+     *
+     * @param receive   Read transaction instead of write
+     * @return HAL_StatusTypeDef    HAL_BUSY if interrupt transfer is in progress
+     */
+    HAL_StatusTypeDef Transfer_IT(I2C_HandleTypeDef *hi2c, uint8_t address, uint8_t *data, uint16_t length, bool receive);
+
+    /**
+     * @brief   Return true if interrupt transfer is in progress
+     */
+    bool Busy() const { return it_busy; };
+
+    /**
+     * @brief   Connect bus to GPIO pins used for recovery of bus
+     *          Rising edges on SCL clock out slave which holds SDA
+     */
+    void Lines(GPIO_TypeDef *scl_port, uint16_t scl_pin, GPIO_TypeDef *sda_port, uint16_t sda_pin);
+
+    /**
+     * @brief   Simulate slave which holds SDA low, for example after reset of MCU during read
+     *          Transfers fail with HAL_I2C_ERROR_TIMEOUT until slave is released
+     *
+     * @param clocks    Number of SCL clocks after which slave releases SDA
+     */
+    void Hold_SDA(uint8_t clocks);
+
+    /**
+     * @brief   Return true if SDA is held by slave
+     */
+    bool Held() const { return held_clocks > 0; };
+
+    /**
+     * @brief   Return counters of bus activity
+     */
+    const Statistics &Stats() const { return statistics; };
+
+    /**
+     * @brief   Reset counters of bus activity
+     */
+    void Reset_statistics(){ statistics = Statistics(); };
+};
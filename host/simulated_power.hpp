@@ -0,0 +1,86 @@
+/**
+ * @file simulated_power.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include "power/power_control.hpp"
+#include "host/virtual_clock.hpp"
+#include "misc/invocation_wrapper.hpp"
+#include "rtc/rtc.hpp"
+
+/**
+ * @brief   Power control for host build, sleeping moves Virtual_clock to next deadline or simulated interrupt
+ *          Wake up latency of every state is added to time, so latency and duty cycle of Run_loop can be measured
+ *          Run_loop with RTC_timer_wheel needs time base of RTC (same as STM32_power), expirations of timers are in its monotonic time
+ */
+class Simulated_power : public Power_control {
+private:
+    /**
+     * @brief   Wake up latency of states in us
+     */
+    uint32_t latency[Power_control::states] = {0, 1, 15};
+
+    /**
+     * @brief   RTC which provides time base, Virtual_clock is used if null
+     */
+    RTC_internal *rtc = nullptr;
+
+public:
+    Simulated_power() = default;
+
+    /**
+     * @brief Construct a new Simulated_power object with time base of RTC
+     *
+     * @param rtc   Initialized RTC, which also drives RTC_timer_wheel of run loop
+     */
+    Simulated_power(RTC_internal &rtc) :
+        rtc(&rtc)
+    { }
+
+    /**
+     * @brief   Set wake up latency of state
+     *
+     * @param state     Power state
+     * @param duration  Latency in us
+     */
+    void Wake_latency(State state, uint32_t duration){ latency[static_cast<uint8_t>(state)] = duration; };
+
+    /**
+     * @brief   Schedule simulated interrupt, for example EXTI of sensor or received byte of UART
+     *
+     * @param time  Time of interrupt in us of Virtual_clock
+     * @param irq   Handler of interrupt
+     */
+    void Schedule(uint64_t time, Invocation_wrapper_base<void, void> *irq){
+        Virtual_clock::Schedule(time * 1000, [irq](){ irq->Invoke(); });
+    };
+
+    /**
+     * @brief   Invoke handlers of interrupts which are due
+     *
+     * @return unsigned int Number of invoked handlers
+     */
+    unsigned int Process_events(){ return Virtual_clock::Process(); };
+
+    /**
+     * @brief   Return number of scheduled interrupts
+     */
+    size_t Scheduled() const { return Virtual_clock::Scheduled(); };
+
+    uint64_t Now() override { return rtc ? rtc->Monotonic() * 1000 : Virtual_clock::Now_us(); };
+
+    void Enter(State state, std::optional<uint64_t> deadline) override {
+        std::optional<uint64_t> wake;
+        if (deadline.has_value()) {
+            // Deadline is converted from time base into Virtual_clock
+            uint64_t now = Now();
+            wake = Virtual_clock::Now() + (deadline.value() > now ? deadline.value() - now : 0) * 1000;
+        }
+        Virtual_clock::Wait_for_interrupt(wake);
+        Virtual_clock::Advance(latency[static_cast<uint8_t>(state)] * 1000ULL);
+    };
+};
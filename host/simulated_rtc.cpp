@@ -0,0 +1,157 @@
+#include "simulated_rtc.hpp"
+
+#include "host/virtual_clock.hpp"
+#include "rtc/rtc.hpp"
+
+Simulated_RTC host_rtc;
+
+void Simulated_RTC::Calendar(uint64_t time){
+    calendar_base = time;
+    clock_base = Virtual_clock::Now();
+    Program_alarm();
+}
+
+uint64_t Simulated_RTC::Calendar() const{
+    return calendar_base + (Virtual_clock::Now() - clock_base);
+}
+
+void Simulated_RTC::Init(RTC_HandleTypeDef *hrtc){
+    handle = hrtc;
+    sync_prediv = hrtc->Init.SynchPrediv;
+}
+
+void Simulated_RTC::Set_time(RTC_HandleTypeDef *hrtc, const RTC_TimeTypeDef &time){
+    handle = hrtc;
+    // Setting of time resets subseconds
+    uint64_t date = Calendar() / day * day;
+    Calendar(date + (time.Hours * 3600ULL + time.Minutes * 60ULL + time.Seconds) * second);
+}
+
+void Simulated_RTC::Get_time(RTC_TimeTypeDef &time) const{
+    uint64_t calendar = Calendar();
+    uint64_t second_of_day = calendar % day / second;
+    uint64_t step = calendar % second * (sync_prediv + 1) / second;
+    time.Hours = second_of_day / 3600;
+    time.Minutes = second_of_day / 60 % 60;
+    time.Seconds = second_of_day % 60;
+    time.TimeFormat = 0;
+    time.SubSeconds = sync_prediv - step;
+    time.SecondFraction = sync_prediv;
+    time.DayLightSaving = RTC_DAYLIGHTSAVING_NONE;
+    time.StoreOperation = RTC_STOREOPERATION_RESET;
+}
+
+void Simulated_RTC::Set_date(RTC_HandleTypeDef *hrtc, const RTC_DateTypeDef &date){
+    handle = hrtc;
+    uint64_t days = RTC_internal::Days_from_civil(2000 + date.Year, date.Month, date.Date);
+    Calendar(days * day + Calendar() % day);
+}
+
+void Simulated_RTC::Get_date(RTC_DateTypeDef &date) const{
+    int32_t year;
+    uint32_t month;
+    uint32_t day_of_month;
+    int32_t days = Calendar() / day;
+    RTC_internal::Civil_from_days(days, year, month, day_of_month);
+    date.Year = year - 2000;
+    date.Month = month;
+    date.Date = day_of_month;
+    date.WeekDay = (days + 3) % 7 + 1;  // 1.1.1970 was Thursday, Monday is 1
+}
+
+void Simulated_RTC::Set_alarm(RTC_HandleTypeDef *hrtc, const RTC_AlarmTypeDef &alarm){
+    handle = hrtc;
+    this->alarm = alarm;
+    alarm_enabled = true;
+    Program_alarm();
+}
+
+void Simulated_RTC::Deactivate_alarm(){
+    alarm_enabled = false;
+    Program_alarm();
+}
+
+void Simulated_RTC::Epoch(uint64_t epoch){
+    Calendar(epoch * 1000000);
+}
+
+std::optional<uint64_t> Simulated_RTC::Next_alarm(uint64_t after) const{
+    uint32_t steps = sync_prediv + 1;
+    uint8_t compared_bits = (alarm.AlarmSubSecondMask >> 24) & 0x0f;
+    uint32_t subsecond_mask = (compared_bits >= 15) ? 0x7fff : ((1U << compared_bits) - 1);
+    uint64_t limit = after + 32 * day;
+
+    // Candidate seconds are skipped by largest mismatching field
+    uint64_t candidate = after / second;
+    while (candidate * second < limit) {
+        uint64_t second_of_day = candidate % (day / second);
+        uint64_t days = candidate / (day / second);
+        if (not (alarm.AlarmMask & RTC_ALARMMASK_DATEWEEKDAY)) {
+            bool match;
+            if (alarm.AlarmDateWeekDaySel == RTC_ALARMDATEWEEKDAYSEL_WEEKDAY) {
+                match = ((days + 3) % 7 + 1) == alarm.AlarmDateWeekDay;
+            } else {
+                int32_t year;
+                uint32_t month;
+                uint32_t day_of_month;
+                RTC_internal::Civil_from_days(days, year, month, day_of_month);
+                match = day_of_month == alarm.AlarmDateWeekDay;
+            }
+            if (not match) {
+                candidate = (days + 1) * (day / second);
+                continue;
+            }
+        }
+        if (not (alarm.AlarmMask & RTC_ALARMMASK_HOURS) && second_of_day / 3600 != alarm.AlarmTime.Hours) {
+            candidate = candidate - second_of_day % 3600 + 3600;
+            continue;
+        }
+        if (not (alarm.AlarmMask & RTC_ALARMMASK_MINUTES) && second_of_day / 60 % 60 != alarm.AlarmTime.Minutes) {
+            candidate = candidate - second_of_day % 60 + 60;
+            continue;
+        }
+        if (not (alarm.AlarmMask & RTC_ALARMMASK_SECONDS) && second_of_day % 60 != alarm.AlarmTime.Seconds) {
+            candidate++;
+            continue;
+        }
+
+        if (compared_bits == 0) {   // Match occurs at start of second
+            if (candidate * second > after) {
+                return candidate * second;
+            }
+        } else {
+            for (uint32_t step = 0; step < steps; step++) {
+                uint32_t subseconds = sync_prediv - step;
+                if (((subseconds ^ alarm.AlarmTime.SubSeconds) & subsecond_mask) != 0) {
+                    continue;
+                }
+                // First moment at which subsecond register reads given step
+                uint64_t moment = candidate * second + (step * second + steps - 1) / steps;
+                if (moment > after) {
+                    return moment;
+                }
+            }
+        }
+        candidate++;
+    }
+    return {};
+}
+
+void Simulated_RTC::Program_alarm(){
+    if (alarm_event) {
+        Virtual_clock::Cancel(alarm_event);
+        alarm_event = 0;
+    }
+    if (not alarm_enabled) {
+        return;
+    }
+    std::optional<uint64_t> next = Next_alarm(Calendar());
+    if (not next.has_value()) {
+        return;
+    }
+    alarm_event = Virtual_clock::Schedule(clock_base + (next.value() - calendar_base), [this](){
+        alarm_event = 0;
+        Program_alarm();    // Alarm stays enabled and matches again
+        HAL_RTC_AlarmAEventCallback(handle);
+    });
+}
@@ -0,0 +1,96 @@
+/**
+ * @file simulated_rtc.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "host/host_hal.hpp"
+
+/**
+ * @brief   Simulated RTC, instance of RTC_HandleTypeDef on host (macro RTC)
+ *          Calendar runs from Virtual_clock, subsecond register counts down from synchronous prescaler
+ *          Alarm A compares fields according to masks including subseconds and invokes
+ *              HAL_RTC_AlarmAEventCallback at first matching moment
+ */
+class Simulated_RTC {
+private:
+    static constexpr uint64_t second = 1000000000ULL;
+    static constexpr uint64_t day = 86400 * second;
+
+    /**
+     * @brief   Calendar time (ns since 1.1.1970) at time clock_base of Virtual_clock
+     *          Calendar starts at 1.1.2000 as RTC after reset
+     */
+    uint64_t calendar_base = 946684800ULL * second;
+    uint64_t clock_base = 0;
+
+    uint16_t sync_prediv = 255;
+
+    RTC_AlarmTypeDef alarm = {};
+    bool alarm_enabled = false;
+
+    /**
+     * @brief   Id of scheduled event of alarm, 0 if none
+     */
+    uint32_t alarm_event = 0;
+
+    /**
+     * @brief   Handle used in last call of HAL, passed to callbacks
+     */
+    RTC_HandleTypeDef *handle = nullptr;
+
+    /**
+     * @brief   Set calendar time in ns since 1.1.1970
+     */
+    void Calendar(uint64_t time);
+
+    /**
+     * @brief   Return calendar time in ns since 1.1.1970
+     */
+    uint64_t Calendar() const;
+
+    /**
+     * @brief   Return first moment after given calendar time at which alarm matches
+     */
+    std::optional<uint64_t> Next_alarm(uint64_t after) const;
+
+    /**
+     * @brief   Schedule event of alarm according to actual calendar
+     */
+    void Program_alarm();
+
+public:
+    void Init(RTC_HandleTypeDef *hrtc);
+
+    void Set_time(RTC_HandleTypeDef *hrtc, const RTC_TimeTypeDef &time);
+
+    void Get_time(RTC_TimeTypeDef &time) const;
+
+    void Set_date(RTC_HandleTypeDef *hrtc, const RTC_DateTypeDef &date);
+
+    void Get_date(RTC_DateTypeDef &date) const;
+
+    void Set_alarm(RTC_HandleTypeDef *hrtc, const RTC_AlarmTypeDef &alarm);
+
+    void Get_alarm(RTC_AlarmTypeDef &alarm) const { alarm = this->alarm; };
+
+    void Deactivate_alarm();
+
+    /**
+     * @brief   Return calendar time in ms since 1.1.1970
+     */
+    uint64_t Epoch() const { return Calendar() / 1000000; };
+
+    /**
+     * @brief   Set calendar time, used by simulation to start from given date
+     *
+     * @param epoch Time in ms since 1.1.1970
+     */
+    void Epoch(uint64_t epoch);
+};
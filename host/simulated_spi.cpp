@@ -0,0 +1,105 @@
+#include "simulated_spi.hpp"
+
+#include <algorithm>
+
+#include "host/simulated_gpio.hpp"
+#include "host/virtual_clock.hpp"
+
+void Simulated_SPI_register::Select(){
+    read = false;
+    frame.clear();
+}
+
+uint8_t Simulated_SPI_register::Exchange(uint8_t mosi){
+    uint8_t address_size = device.Address_size();
+    if (frame.size() < address_size) {
+        if (frame.empty()) {
+            read = mosi & read_flag;
+            mosi &= ~(read_flag | increment_flag);
+        }
+        frame.push_back(mosi);
+        if (read && frame.size() == address_size) {
+            // Address only write sets pointer of model
+            device.Write(0, frame.data(), address_size);
+        }
+        return 0xff;
+    }
+    if (read) {
+        uint8_t value;
+        device.Read(0, &value, 1);
+        return value;
+    }
+    frame.push_back(mosi);
+    return 0xff;
+}
+
+void Simulated_SPI_register::Deselect(){
+    if (!read && frame.size() > device.Address_size()) {
+        device.Write(0, frame.data(), frame.size());
+    }
+    device.Stop();
+    frame.clear();
+}
+
+Simulated_SPI_bus::Simulated_SPI_bus(uint32_t speed) :
+    speed(speed)
+{ }
+
+void Simulated_SPI_bus::Attach(Simulated_SPI_device &device){
+    if (std::find(devices.begin(), devices.end(), &device) != devices.end()) {
+        return;
+    }
+    devices.push_back(&device);
+    Simulated_GPIO::Watch(device.Port(), device.Pin(), [&device](bool level){
+        if (level) {
+            device.Deselect();
+        } else {
+            device.Select();
+        }
+    });
+}
+
+uint64_t Simulated_SPI_bus::Duration(uint32_t bytes) const{
+    return 8ULL * bytes * 1000000000ULL / speed;
+}
+
+void Simulated_SPI_bus::Exchange(const uint8_t *transmit, uint8_t *receive, uint16_t length){
+    Simulated_SPI_device *selected = nullptr;
+    for (auto device : devices) {
+        if (device->Selected()) {
+            selected = device;
+            break;
+        }
+    }
+    for (uint16_t i = 0; i < length; i++) {
+        uint8_t mosi = transmit ? transmit[i] : 0xff;
+        uint8_t miso = selected ? selected->Exchange(mosi) : 0xff;
+        if (receive) {
+            receive[i] = miso;
+        }
+    }
+}
+
+HAL_StatusTypeDef Simulated_SPI_bus::Transfer(SPI_HandleTypeDef *hspi, const uint8_t *transmit, uint8_t *receive, uint16_t length, bool dma){
+    if (dma_busy) {
+        return HAL_BUSY;
+    }
+    hspi->ErrorCode = HAL_SPI_ERROR_NONE;
+    uint64_t duration = Duration(length);
+    statistics.transactions++;
+    statistics.bytes += length;
+    statistics.busy_time += duration;
+    if (!dma) {
+        Exchange(transmit, receive, length);
+        Virtual_clock::Advance(duration);
+        return HAL_OK;
+    }
+    // Bytes are exchanged at the end of transfer, chip select must stay active until callback
+    dma_busy = true;
+    Virtual_clock::Schedule_after(duration, [this, hspi, transmit, receive, length](){
+        Exchange(transmit, receive, length);
+        dma_busy = false;
+        HAL_SPI_TxRxCpltCallback(hspi);
+    });
+    return HAL_OK;
+}
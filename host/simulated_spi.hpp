@@ -0,0 +1,197 @@
+/**
+ * @file simulated_spi.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "host/host_hal.hpp"
+#include "host/simulated_i2c.hpp"
+
+/**
+ * @brief   Device connected to Simulated_SPI_bus, selected by low level of its chip select pin
+ */
+class Simulated_SPI_device {
+protected:
+    /**
+     * @brief   Chip select of device
+     */
+    GPIO_TypeDef *port;
+    uint16_t pin;
+
+public:
+    /**
+     * @brief Construct a new Simulated_SPI_device object
+     *
+     * @param port  Port of chip select (GPIOA, GPIOB, ...)
+     * @param pin   Mask of chip select pin (GPIO_PIN_x)
+     */
+    Simulated_SPI_device(GPIO_TypeDef *port, uint16_t pin) :
+        port(port), pin(pin)
+    { }
+
+    virtual ~Simulated_SPI_device() = default;
+
+    GPIO_TypeDef *Port() const { return port; };
+
+    uint16_t Pin() const { return pin; };
+
+    /**
+     * @brief   Return true if chip select is active
+     */
+    bool Selected() const { return HAL_GPIO_ReadPin(port, pin) == GPIO_PIN_RESET; };
+
+    /**
+     * @brief   Falling edge of chip select, start of frame
+     */
+    virtual void Select(){ };
+
+    /**
+     * @brief   Exchange of one byte during frame
+     *
+     * @param mosi      Byte transmitted by master
+     * @return uint8_t  Byte transmitted by device
+     */
+    virtual uint8_t Exchange(uint8_t mosi) = 0;
+
+    /**
+     * @brief   Rising edge of chip select, end of frame
+     */
+    virtual void Deselect(){ };
+};
+
+/**
+ * @brief   SPI interface of register device model, same model can be connected to I2C and SPI bus
+ *          First bytes of frame are register address, read is marked by flag in first byte,
+ *              written data are passed to model at the end of frame as one I2C write transaction
+ */
+class Simulated_SPI_register : public Simulated_SPI_device {
+private:
+    Simulated_register_device &device;
+
+    /**
+     * @brief   Flags of first byte of address
+     */
+    uint8_t read_flag;
+    uint8_t increment_flag;
+
+    /**
+     * @brief   True if actual frame is read
+     */
+    bool read = false;
+
+    /**
+     * @brief   Address and data of actual frame
+     */
+    std::vector<uint8_t> frame;
+
+public:
+    /**
+     * @brief Construct a new Simulated_SPI_register object
+     *
+     * @param device            Model of device
+     * @param port              Port of chip select
+     * @param pin               Mask of chip select pin
+     * @param read_flag         Flag of read in first byte of address
+     * @param increment_flag    Flag of address increment in first byte of address, ignored by model
+     */
+    Simulated_SPI_register(Simulated_register_device &device, GPIO_TypeDef *port, uint16_t pin, uint8_t read_flag = 0x80, uint8_t increment_flag = 0x00) :
+        Simulated_SPI_device(port, pin), device(device), read_flag(read_flag), increment_flag(increment_flag)
+    { }
+
+    void Select() override;
+
+    uint8_t Exchange(uint8_t mosi) override;
+
+    void Deselect() override;
+};
+
+/**
+ * @brief   Simulated SPI bus, instance of SPI_HandleTypeDef on host
+ *          Duration of transfers is modeled by speed of bus and added to Virtual_clock,
+ *              DMA transfer is finished by HAL_SPI_TxRxCpltCallback from event of clock
+ */
+class Simulated_SPI_bus {
+public:
+    /**
+     * @brief   Counters of bus activity
+     */
+    struct Statistics {
+        uint32_t transactions = 0;
+        uint64_t bytes        = 0;
+        uint64_t busy_time    = 0;  // ns
+    };
+
+private:
+    /**
+     * @brief   Speed of bus in Hz
+     */
+    uint32_t speed;
+
+    std::vector<Simulated_SPI_device *> devices;
+
+    Statistics statistics;
+
+    /**
+     * @brief   True while DMA transfer is in progress
+     */
+    bool dma_busy = false;
+
+    /**
+     * @brief   Exchange bytes with selected device, MISO is high when no device is selected
+     */
+    void Exchange(const uint8_t *transmit, uint8_t *receive, uint16_t length);
+
+public:
+    /**
+     * @brief Construct a new Simulated_SPI_bus object
+     *
+     * @param speed Speed of bus in Hz
+     */
+    Simulated_SPI_bus(uint32_t speed = 1000000);
+
+    /**
+     * @brief   Connect device to bus, edges of chip select are forwarded to device
+     */
+    void Attach(Simulated_SPI_device &device);
+
+    /**
+     * @brief   Change speed of bus
+     *
+     * @param speed Speed of bus in Hz
+     */
+    void Speed(uint32_t speed){ this->speed = speed; };
+
+    /**
+     * @brief   Return speed of bus in Hz
+     */
+    uint32_t Speed() const { return speed; };
+
+    /**
+     * @brief   Return duration of transfer in ns
+     */
+    uint64_t Duration(uint32_t bytes) const;
+
+    /**
+     * @brief   Transfer of bytes, transmit or receive buffer can be nullptr
+     *
+     * @param dma       Transfer is finished by callback instead of blocking
+     * @return HAL_StatusTypeDef    HAL_BUSY if DMA transfer is in progress
+     */
+    HAL_StatusTypeDef Transfer(SPI_HandleTypeDef *hspi, const uint8_t *transmit, uint8_t *receive, uint16_t length, bool dma);
+
+    /**
+     * @brief   Return counters of bus activity
+     */
+    const Statistics &Stats() const { return statistics; };
+
+    /**
+     * @brief   Reset counters of bus activity
+     */
+    void Reset_statistics(){ statistics = Statistics(); };
+};
@@ -0,0 +1,95 @@
+#include "simulated_uart.hpp"
+
+#include <algorithm>
+
+#include "host/virtual_clock.hpp"
+
+Simulated_UART::Simulated_UART(uint32_t baudrate) :
+    baudrate(baudrate)
+{ }
+
+void Simulated_UART::Inject(const std::string &data, uint64_t delay){
+    uint64_t time = std::max(input_end, Virtual_clock::Now() + delay);
+    for (char character : data) {
+        time += Byte_time();
+        uint8_t byte = static_cast<uint8_t>(character);
+        Virtual_clock::Schedule(time, [this, byte](){ Arrive(byte); });
+    }
+    input_end = time;
+}
+
+std::string Simulated_UART::Take_output(){
+    std::string data;
+    data.swap(output);
+    return data;
+}
+
+void Simulated_UART::Arrive(uint8_t byte){
+    statistics.received++;
+    if (rx_buffer != nullptr) {
+        Deliver(byte);
+    } else if (rx_register < 0) {
+        rx_register = byte;
+    } else {
+        rx_register = byte;
+        statistics.overruns++;
+        if (handle) {
+            handle->ErrorCode = handle->ErrorCode | HAL_UART_ERROR_ORE;
+        }
+    }
+}
+
+void Simulated_UART::Deliver(uint8_t byte){
+    rx_buffer[rx_count++] = byte;
+    if (rx_count == rx_length) {
+        rx_buffer = nullptr;
+        HAL_UART_RxCpltCallback(handle);
+    }
+}
+
+HAL_StatusTypeDef Simulated_UART::Transmit(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t length, bool blocking){
+    if (tx_busy) {
+        return HAL_BUSY;
+    }
+    handle = huart;
+    if (capture) {
+        output.append(reinterpret_cast<const char *>(data), length);
+    }
+    statistics.transmitted += length;
+    uint64_t duration = Byte_time() * length;
+    if (blocking) {
+        Virtual_clock::Advance(duration);
+        return HAL_OK;
+    }
+    tx_busy = true;
+    Virtual_clock::Schedule_after(duration, [this](){
+        tx_busy = false;
+        HAL_UART_TxCpltCallback(handle);
+    });
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef Simulated_UART::Receive(UART_HandleTypeDef *huart, uint8_t *data, uint16_t length){
+    if (rx_buffer != nullptr) {
+        return HAL_BUSY;
+    }
+    if (length == 0) {
+        return HAL_ERROR;
+    }
+    handle = huart;
+    rx_buffer = data;
+    rx_length = length;
+    rx_count = 0;
+    if (rx_register >= 0) { // Pending byte raises interrupt immediately after enabling
+        uint8_t byte = rx_register;
+        rx_register = -1;
+        Virtual_clock::Schedule(Virtual_clock::Now(), [this, byte](){
+            if (rx_buffer != nullptr) {
+                Deliver(byte);
+            } else {
+                rx_register = byte;
+            }
+        });
+    }
+    return HAL_OK;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file simulated_uart.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "host/host_hal.hpp"
+
+/**
+ * @brief   Simulated UART, instance of UART_HandleTypeDef on host
+ *          Transmitted data are collected into output, received data are injected by simulation
+ *          Every byte takes 10 bit times at configured baudrate, completion is signaled by HAL callbacks
+ *          Byte which arrives while no reception is armed is held in receive register,
+ *              next byte overruns it as on MCU
+ */
+class Simulated_UART {
+public:
+    /**
+     * @brief   Counters of UART activity
+     */
+    struct Statistics {
+        uint64_t transmitted = 0;
+        uint64_t received    = 0;
+        uint32_t overruns    = 0;
+    };
+
+private:
+    uint32_t baudrate;
+
+    /**
+     * @brief   Data transmitted by MCU
+     */
+    std::string output;
+
+    /**
+     * @brief   Transmitted data are stored into output
+     */
+    bool capture = true;
+
+    /**
+     * @brief   Time at which last injected byte arrives, following bytes are queued after it
+     */
+    uint64_t input_end = 0;
+
+    /**
+     * @brief   State of transmission
+     */
+    bool tx_busy = false;
+
+    /**
+     * @brief   Armed reception
+     */
+    uint8_t *rx_buffer = nullptr;
+    uint16_t rx_length = 0;
+    uint16_t rx_count = 0;
+
+    /**
+     * @brief   Receive register, holds byte which arrived while no reception was armed
+     */
+    int16_t rx_register = -1;
+
+    /**
+     * @brief   Handle used in last call of HAL, passed to callbacks
+     */
+    UART_HandleTypeDef *handle = nullptr;
+
+    Statistics statistics;
+
+    /**
+     * @brief   Arrival of byte on RX line
+     */
+    void Arrive(uint8_t byte);
+
+    /**
+     * @brief   Store byte into armed reception
+     */
+    void Deliver(uint8_t byte);
+
+public:
+    /**
+     * @brief Construct a new Simulated_UART object
+     *
+     * @param baudrate  Baudrate in Bd
+     */
+    Simulated_UART(uint32_t baudrate = 115200);
+
+    /**
+     * @brief   Return duration of one byte (start, 8 data bits, stop) in ns
+     */
+    uint64_t Byte_time() const { return 10000000000ULL / baudrate; };
+
+    /**
+     * @brief   Change baudrate
+     */
+    void Baudrate(uint32_t baudrate){ this->baudrate = baudrate; };
+
+    /**
+     * @brief   Send data to MCU, bytes arrive back to back after data injected before
+     *
+     * @param data  Data received by MCU
+     * @param delay Delay of first byte in ns
+     */
+    void Inject(const std::string &data, uint64_t delay = 0);
+
+    /**
+     * @brief   Return data transmitted by MCU
+     */
+    const std::string &Output() const { return output; };
+
+    /**
+     * @brief   Return and clear data transmitted by MCU
+     */
+    std::string Take_output();
+
+    /**
+     * @brief   Enable storing of transmitted data, disabled capture keeps only statistics (long runs, benchmark)
+     */
+    void Capture(bool enable){ capture = enable; };
+
+    /**
+     * @brief   Return true if transmission is in progress
+     */
+    bool Busy() const { return tx_busy; };
+
+    /**
+     * @brief   Return counters of UART activity
+     */
+    const Statistics &Stats() const { return statistics; };
+
+    /**
+     * @brief   Start transmission, completion is signaled by HAL_UART_TxCpltCallback
+     *          Blocking transmission moves time by duration of transfer
+     */
+    HAL_StatusTypeDef Transmit(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t length, bool blocking);
+
+    /**
+     * @brief   Arm reception, completion is signaled by HAL_UART_RxCpltCallback
+     */
+    HAL_StatusTypeDef Receive(UART_HandleTypeDef *huart, uint8_t *data, uint16_t length);
+};
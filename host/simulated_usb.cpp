@@ -0,0 +1,82 @@
+#include "simulated_usb.hpp"
+
+#include <algorithm>
+
+#include "host/virtual_clock.hpp"
+
+Simulated_USB_CDC::Simulated_USB_CDC(uint32_t packets_per_frame) :
+    packet_time(1000000 / packets_per_frame)
+{ }
+
+void Simulated_USB_CDC::Inject(const std::string &data, uint64_t delay){
+    input_end = std::max(input_end, Virtual_clock::Now() + delay);
+    for (size_t offset = 0; offset < data.size(); offset += packet_size) {
+        input.push_back(data.substr(offset, packet_size));
+    }
+    Deliver();
+}
+
+std::string Simulated_USB_CDC::Take_output(){
+    std::string data;
+    data.swap(output);
+    return data;
+}
+
+void Simulated_USB_CDC::Deliver(){
+    if (!rx_armed || delivery || input.empty()) {
+        return;
+    }
+    delivery = true;
+    uint64_t time = std::max(input_end, Virtual_clock::Now()) + packet_time;
+    input_end = time;
+    Virtual_clock::Schedule(time, [this](){
+        delivery = false;
+        std::string packet = std::move(input.front());
+        input.pop_front();
+        std::copy(packet.begin(), packet.end(), rx_buffer);
+        rx_armed = false;
+        statistics.received += packet.size();
+        statistics.packets_out++;
+        uint32_t length = packet.size();
+        CDC_Receive_FS(rx_buffer, &length);
+        Deliver();
+    });
+}
+
+uint8_t Simulated_USB_CDC::Transmit(){
+    if (tx_busy) {
+        return USBD_BUSY;
+    }
+    tx_busy = true;
+    statistics.transfers++;
+    statistics.transmitted += tx_length;
+
+    // Packets are received by host now, transfer completes after their time on bus
+    uint32_t packets = tx_length / packet_size;
+    pending.append(reinterpret_cast<const char *>(tx_buffer), tx_length);
+    if (tx_length % packet_size != 0 || tx_length == 0) {
+        packets++;
+        if (tx_length == 0) {
+            statistics.zlps++;
+        }
+        output.append(pending);
+        pending.clear();
+    }
+    statistics.packets_in += packets;
+
+    Virtual_clock::Schedule_after(packets * packet_time, [this](){
+        tx_busy = false;
+        uint32_t length = tx_length;
+        CDC_TransmitCplt_FS(tx_buffer, &length, 0x81);
+    });
+    return USBD_OK;
+}
+
+uint8_t Simulated_USB_CDC::Receive(){
+    if (rx_buffer == nullptr) {
+        return USBD_FAIL;
+    }
+    rx_armed = true;
+    Deliver();
+    return USBD_OK;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file simulated_usb.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+
+#include "host/host_hal.hpp"
+
+/**
+ * @brief   Simulated USB CDC device with bulk endpoints, instance of USBD_HandleTypeDef on host
+ *          Transfers are split into packets of 64 bytes, transfer which is multiple of packet size is not
+ *              terminated by ZLP automatically (as endpoint without support of middleware), length 0 sends ZLP
+ *          Host reads data by bulk transfers, read is completed by short packet or ZLP, until then data are pending
+ *          Every packet takes one slot of full speed frame, completion is signaled by CDC_TransmitCplt_FS
+ *          OUT packets injected by simulation are NAKed until device arms reception, then delivered by CDC_Receive_FS
+ */
+class Simulated_USB_CDC {
+public:
+    /**
+     * @brief   Maximal size of bulk packet of full speed device
+     */
+    static constexpr uint16_t packet_size = 64;
+
+    /**
+     * @brief   Counters of USB activity
+     */
+    struct Statistics {
+        uint64_t transmitted    = 0;
+        uint64_t received       = 0;
+        uint32_t packets_in     = 0;    // Packets to host including ZLP
+        uint32_t packets_out    = 0;    // Packets from host
+        uint32_t zlps           = 0;
+        uint32_t transfers      = 0;    // Transfers started by device
+    };
+
+private:
+    /**
+     * @brief   Duration of one packet in ns
+     */
+    uint64_t packet_time;
+
+    /**
+     * @brief   Data of reads completed by host
+     */
+    std::string output;
+
+    /**
+     * @brief   Data received by host in read which was not terminated yet
+     */
+    std::string pending;
+
+    /**
+     * @brief   Packets sent by host, waiting for armed reception
+     */
+    std::deque<std::string> input;
+
+    /**
+     * @brief   Time at which last injected packet can be delivered
+     */
+    uint64_t input_end = 0;
+
+    /**
+     * @brief   Transmit buffer set by USBD_CDC_SetTxBuffer
+     */
+    uint8_t *tx_buffer = nullptr;
+    uint32_t tx_length = 0;
+    bool tx_busy = false;
+
+    /**
+     * @brief   Receive buffer set by USBD_CDC_SetRxBuffer, reception is armed by USBD_CDC_ReceivePacket
+     */
+    uint8_t *rx_buffer = nullptr;
+    bool rx_armed = false;
+
+    /**
+     * @brief   Delivery of first packet of input is scheduled
+     */
+    bool delivery = false;
+
+    Statistics statistics;
+
+    /**
+     * @brief   Schedule delivery of first waiting packet if reception is armed
+     */
+    void Deliver();
+
+public:
+    /**
+     * @brief Construct a new Simulated_USB_CDC object
+     *
+     * @param packets_per_frame Number of bulk packets transferred in one frame of 1 ms, 19 for full speed
+     */
+    Simulated_USB_CDC(uint32_t packets_per_frame = 19);
+
+    /**
+     * @brief   Return duration of one packet in ns
+     */
+    uint64_t Packet_time() const { return packet_time; };
+
+    /**
+     * @brief   Send data from host to device, data are split into packets of 64 bytes
+     *
+     * @param data  Data received by device
+     * @param delay Delay of first packet in ns
+     */
+    void Inject(const std::string &data, uint64_t delay = 0);
+
+    /**
+     * @brief   Return data of reads completed by host
+     */
+    const std::string &Output() const { return output; };
+
+    /**
+     * @brief   Return and clear data of reads completed by host
+     */
+    std::string Take_output();
+
+    /**
+     * @brief   Return data which host received, but read was not completed by short packet or ZLP
+     */
+    const std::string &Pending() const { return pending; };
+
+    /**
+     * @brief   Return true if transfer to host is in progress
+     */
+    bool Busy() const { return tx_busy; };
+
+    /**
+     * @brief   Return counters of USB activity
+     */
+    const Statistics &Stats() const { return statistics; };
+
+    /**
+     * @brief   Select buffer of next transfer to host
+     */
+    void Set_TX_buffer(uint8_t *buffer, uint32_t length){ tx_buffer = buffer; tx_length = length; };
+
+    /**
+     * @brief   Select buffer for next packet from host
+     */
+    void Set_RX_buffer(uint8_t *buffer){ rx_buffer = buffer; };
+
+    /**
+     * @brief   Start transfer to host, completion is signaled by CDC_TransmitCplt_FS
+     */
+    uint8_t Transmit();
+
+    /**
+     * @brief   Arm reception of one packet, completion is signaled by CDC_Receive_FS
+     */
+    uint8_t Receive();
+};
@@ -0,0 +1,86 @@
+#include "virtual_clock.hpp"
+
+#include <algorithm>
+
+void Virtual_clock::Advance(uint64_t duration){
+    Advance_to(time + duration);
+}
+
+void Virtual_clock::Advance_to(uint64_t moment){
+    // Time stops at every event, so handlers observe time of their interrupt
+    while (not masked && not in_interrupt && not events.empty() && events.front().time <= moment) {
+        if (events.front().time > time) {
+            time = events.front().time;
+        }
+        Process();
+    }
+    if (moment > time) {
+        time = moment;
+    }
+    Process();
+}
+
+uint32_t Virtual_clock::Schedule(uint64_t moment, Handler handler){
+    Event event{moment, ++last_id, std::move(handler)};
+    auto position = std::upper_bound(events.begin(), events.end(), moment, [](uint64_t value, const Event &item){ return value < item.time; });
+    events.insert(position, std::move(event));
+    return last_id;
+}
+
+bool Virtual_clock::Cancel(uint32_t id){
+    auto position = std::find_if(events.begin(), events.end(), [id](const Event &item){ return item.id == id; });
+    if (position == events.end()) {
+        return false;
+    }
+    events.erase(position);
+    return true;
+}
+
+unsigned int Virtual_clock::Process(){
+    if (masked || in_interrupt) {
+        return 0;
+    }
+    unsigned int invoked = 0;
+    while (not events.empty() && events.front().time <= time && not masked) {
+        // Handler is removed before invocation, so it can schedule or cancel events
+        Handler handler = std::move(events.front().handler);
+        events.erase(events.begin());
+        in_interrupt = true;
+        handler();
+        in_interrupt = false;
+        invoked++;
+    }
+    return invoked;
+}
+
+bool Virtual_clock::Wait_for_interrupt(std::optional<uint64_t> deadline){
+    std::optional<uint64_t> next = Next_event();
+    bool event = next.has_value() && (not deadline.has_value() || next.value() <= deadline.value());
+    if (event) {
+        Advance_to(next.value());
+    } else if (deadline.has_value()) {
+        Advance_to(deadline.value());
+    }
+    return event;
+}
+
+std::optional<uint64_t> Virtual_clock::Next_event(){
+    if (events.empty()) {
+        return {};
+    }
+    return events.front().time;
+}
+
+void Virtual_clock::Mask(bool state){
+    masked = state;
+    if (not masked) {
+        Process();
+    }
+}
+
+void Virtual_clock::Reset(){
+    time = 0;
+    events.clear();
+    masked = false;
+    in_interrupt = false;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file virtual_clock.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+/**
+ * @brief   Simulated time of host build, shared by all simulated peripherals
+ *          Time advances only explicitly (sleep, modeled bus transfers), so simulations are deterministic
+ *          Simulated peripherals schedule their interrupts as events, which are invoked when time reaches them
+ *          Events are not invoked while interrupts are masked (PRIMASK) or while other event is running,
+ *              same as interrupts of single priority on MCU
+ */
+class Virtual_clock {
+public:
+    /**
+     * @brief   Handler of simulated interrupt
+     */
+    using Handler = std::function<void()>;
+
+private:
+    /**
+     * @brief   Scheduled interrupt, events with same time are invoked in order of scheduling
+     */
+    struct Event {
+        uint64_t time;
+        uint32_t id;
+        Handler handler;
+    };
+
+    /**
+     * @brief   Actual time in nanoseconds
+     */
+    static inline uint64_t time = 0;
+
+    /**
+     * @brief   Scheduled events sorted by time
+     */
+    static inline std::vector<Event> events;
+
+    /**
+     * @brief   Id of last scheduled event
+     */
+    static inline uint32_t last_id = 0;
+
+    /**
+     * @brief   Simulated PRIMASK, true if interrupts are disabled
+     */
+    static inline bool masked = false;
+
+    /**
+     * @brief   True during invocation of event handler, prevents nesting of interrupts
+     */
+    static inline bool in_interrupt = false;
+
+public:
+    /**
+     * @brief   Return actual time in nanoseconds
+     */
+    static uint64_t Now(){ return time; };
+
+    /**
+     * @brief   Return actual time in microseconds
+     */
+    static uint64_t Now_us(){ return time / 1000; };
+
+    /**
+     * @brief   Return actual time in milliseconds
+     */
+    static uint64_t Now_ms(){ return time / 1000000; };
+
+    /**
+     * @brief   Move time forward and invoke events which became due
+     *
+     * @param duration  Duration in nanoseconds
+     */
+    static void Advance(uint64_t duration);
+
+    /**
+     * @brief   Move time forward to given moment and invoke events which became due, time never goes backwards
+     *
+     * @param moment    Time in nanoseconds
+     */
+    static void Advance_to(uint64_t moment);
+
+    /**
+     * @brief   Schedule simulated interrupt
+     *
+     * @param moment    Time of interrupt in nanoseconds
+     * @param handler   Handler of interrupt
+     * @return uint32_t Id of event, can be used to cancel event
+     */
+    static uint32_t Schedule(uint64_t moment, Handler handler);
+
+    /**
+     * @brief   Schedule simulated interrupt relative to actual time
+     *
+     * @param delay     Delay of interrupt in nanoseconds
+     * @param handler   Handler of interrupt
+     * @return uint32_t Id of event, can be used to cancel event
+     */
+    static uint32_t Schedule_after(uint64_t delay, Handler handler){ return Schedule(time + delay, std::move(handler)); };
+
+    /**
+     * @brief   Remove scheduled event
+     *
+     * @param id        Id returned by Schedule
+     * @return true     Event was removed
+     * @return false    Event was already invoked or removed
+     */
+    static bool Cancel(uint32_t id);
+
+    /**
+     * @brief   Invoke handlers of events which are due, if interrupts are not masked
+     *
+     * @return unsigned int Number of invoked handlers
+     */
+    static unsigned int Process();
+
+    /**
+     * @brief   Simulate WFI, time moves to nearest event or deadline
+     *          Due events are invoked only if interrupts are not masked, otherwise they stay pending
+     *              until interrupts are enabled again
+     *
+     * @param deadline  Latest time of wake up in nanoseconds
+     * @return true     Woken by event
+     * @return false    Woken by deadline or there is no event which can wake up
+     */
+    static bool Wait_for_interrupt(std::optional<uint64_t> deadline = {});
+
+    /**
+     * @brief   Return time of nearest event in nanoseconds, empty if no event is scheduled
+     */
+    static std::optional<uint64_t> Next_event();
+
+    /**
+     * @brief   Return number of scheduled events
+     */
+    static size_t Scheduled(){ return events.size(); };
+
+    /**
+     * @brief   Mask or unmask simulated interrupts, pending events are invoked after unmasking
+     *
+     * @param state True disables interrupts
+     */
+    static void Mask(bool state);
+
+    /**
+     * @brief   Return true if simulated interrupts are disabled
+     */
+    static bool Masked(){ return masked; };
+
+    /**
+     * @brief   Return true if event handler is running, simulated interrupt context
+     */
+    static bool In_interrupt(){ return in_interrupt; };
+
+    /**
+     * @brief   Reset time to zero and remove all events, used between independent simulations
+     */
+    static void Reset();
+};
@@ -0,0 +1,158 @@
+#include "i2c_bus_group.hpp"
+
+#include "misc/critical_section.hpp"
+
+namespace {
+    /**
+     * @brief   Return register address as big endian bytes
+     */
+    Byte_vector Address_bytes(uint16_t address, uint8_t address_size){
+        Byte_vector bytes(address_size);
+        for (uint8_t i = 0; i < address_size; i++) {
+            bytes[i] = static_cast<uint8_t>(address >> (8 * (address_size - 1 - i)));
+        }
+        return bytes;
+    }
+}
+
+std::optional<uint8_t> I2C_bus_group::Add(const I2C_master &master){
+    if (count >= buses_max || Busy()) {
+        return {};
+    }
+    Bus &bus = buses[count];
+    bus.master = master;
+    bus.queue.clear();
+    bus.lane.group = this;
+    bus.lane.bus = count;
+    return count++;
+}
+
+std::optional<uint8_t> I2C_bus_group::Bus_of(const I2C_device &device) const {
+    for (uint8_t i = 0; i < count; i++) {
+        if (buses[i].master.Handler() == device.Master().Handler()) {
+            return i;
+        }
+    }
+    return {};
+}
+
+std::optional<uint16_t> I2C_bus_group::Queue(const I2C_device &device, Byte_vector frame, uint8_t *data, uint16_t length){
+    auto bus = Bus_of(device);
+    if (!bus || Busy() || requests.size() >= requests.max_size()) {
+        return {};
+    }
+    uint16_t index = requests.size();
+    requests.push_back({*bus, device.Address(), std::move(frame), data, length, false});
+    buses[*bus].queue.push_back(index);
+    return index;
+}
+
+std::optional<uint16_t> I2C_bus_group::Read(const I2C_device &device, uint16_t address, uint8_t address_size, uint8_t *data, uint16_t length){
+    return Queue(device, Address_bytes(address, address_size), data, length);
+}
+
+std::optional<uint16_t> I2C_bus_group::Write(const I2C_device &device, uint16_t address, uint8_t address_size, const Byte_vector &data){
+    Byte_vector frame = Address_bytes(address, address_size);
+    frame.insert(frame.end(), data.begin(), data.end());
+    return Queue(device, std::move(frame), nullptr, 0);
+}
+
+bool I2C_bus_group::Clear(){
+    if (Busy()) {
+        return false;
+    }
+    requests.clear();
+    for (uint8_t i = 0; i < count; i++) {
+        buses[i].queue.clear();
+    }
+    return true;
+}
+
+bool I2C_bus_group::Start(Invocation_wrapper_base<void, bool> *callback){
+    if (Busy()) {
+        return false;
+    }
+    this->callback = callback;
+    failures = 0;
+    for (auto &request : requests) {
+        request.success = false;
+    }
+
+    // Every bus is counted before first transfer starts, fast completion of one bus cannot finish batch
+    uint8_t active = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        buses[i].cursor = 0;
+        buses[i].receiving = false;
+        if (!buses[i].queue.empty()) {
+            active++;
+        }
+    }
+    if (active == 0) {
+        if (callback) {
+            callback->Invoke(true);
+        }
+        return true;
+    }
+
+    remaining = active + 1;
+    for (uint8_t i = 0; i < count; i++) {
+        if (!buses[i].queue.empty()) {
+            Issue(i);
+        }
+    }
+    // Reference held by Start is released, batch can be finished by last bus or here
+    Finish();
+    return true;
+}
+
+void I2C_bus_group::Issue(uint8_t index){
+    Bus &bus = buses[index];
+    while (bus.cursor < bus.queue.size()) {
+        Request &request = requests[bus.queue[bus.cursor]];
+        bus.receiving = false;
+        if (bus.master.Transmit_IT(request.address, request.frame.data(), request.frame.size(), &bus.lane)) {
+            return;
+        }
+        Failed();
+        bus.cursor++;
+    }
+    Finish();
+}
+
+void I2C_bus_group::Next(uint8_t index, bool success){
+    Bus &bus = buses[index];
+    Request &request = requests[bus.queue[bus.cursor]];
+
+    // Address of register is transmitted, data of read follow as separate transfer
+    if (success && !bus.receiving && request.data != nullptr) {
+        bus.receiving = true;
+        if (bus.master.Receive_IT(request.address, request.data, request.length, &bus.lane)) {
+            return;
+        }
+        success = false;
+    }
+
+    request.success = success;
+    if (!success) {
+        Failed();
+    }
+    bus.cursor++;
+    Issue(index);
+}
+
+void I2C_bus_group::Failed(){
+    Critical_section section;
+    failures = failures + 1;
+}
+
+void I2C_bus_group::Finish(){
+    uint8_t left;
+    {
+        Critical_section section;
+        remaining = remaining - 1;
+        left = remaining;
+    }
+    if (left == 0 && callback) {
+        callback->Invoke(failures == 0);
+    }
+}
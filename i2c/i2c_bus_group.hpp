@@ -0,0 +1,204 @@
+/**
+ * @file i2c_bus_group.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "i2c/i2c_device.hpp"
+#include "misc/invocation_wrapper.hpp"
+#include "misc/no_heap.hpp"
+
+/**
+ * @brief   Maximal number of requests of I2C_bus_group in no-heap build
+ */
+#ifndef HALUP_I2C_GROUP_REQUESTS
+#define HALUP_I2C_GROUP_REQUESTS 16
+#endif
+
+/**
+ * @brief   Group of I2C peripherals whose transfers run concurrently
+ *          Every request is bound to bus of its device (affinity), requests of one bus are executed in order of queuing
+ *              in interrupt mode, buses are independent, so whole batch takes time of slowest bus instead of sum of all
+ *          Batch of requests is kept after completion and can be started again, for example periodic read of all sensors:
+ *              I2C_bus_group group;
+ *              group.Add(i2c1);
+ *              group.Add(i2c2);
+ *              group.Read(temperature, 0x00, 1, temperature_data, 2);
+ *              group.Read(accelerometer, 0x28, 1, acceleration_data, 6);
+ *              group.Start(&batch_done);
+ *          Completion of I2C_master is forwarded from HAL callbacks (see misc/hal_callbacks.hpp)
+ */
+class I2C_bus_group {
+public:
+    /**
+     * @brief   Maximal number of buses in group
+     */
+    static constexpr uint8_t buses_max = HALUP_I2C_BUSES;
+
+private:
+    /**
+     * @brief   Register read or write of one device
+     */
+    struct Request {
+        uint8_t bus;
+        uint8_t address;
+        Byte_vector frame;              // Address of register, followed by data for write
+        uint8_t *data;                  // Buffer of read, null for write
+        uint16_t length;
+        bool success;
+    };
+
+    /**
+     * @brief   Callback of transfers of one bus, continues with next phase or request of bus
+     */
+    class Lane : public Invocation_wrapper_base<void, bool> {
+    public:
+        I2C_bus_group *group = nullptr;
+        uint8_t bus = 0;
+
+        void Invoke(bool success) const override { group->Next(bus, success); };
+    };
+
+    /**
+     * @brief   State of one bus, modified from IRQ during batch
+     */
+    struct Bus {
+        I2C_master master;
+        Bounded_vector<uint16_t, HALUP_I2C_GROUP_REQUESTS> queue;  // Indexes of requests
+        uint16_t cursor = 0;                                        // Actual request in queue
+        bool receiving = false;                                     // Address of register was transmitted, data are received
+        Lane lane;
+    };
+
+    Bus buses[buses_max];
+    uint8_t count = 0;
+
+    Bounded_vector<Request, HALUP_I2C_GROUP_REQUESTS> requests;
+
+    /**
+     * @brief   Number of buses which did not finish their queue, Start() holds one more until all buses are started
+     */
+    volatile uint8_t remaining = 0;
+
+    /**
+     * @brief   Number of failed requests of last batch
+     */
+    volatile uint16_t failures = 0;
+
+    Invocation_wrapper_base<void, bool> *callback = nullptr;
+
+    /**
+     * @brief   Queue request to bus of device
+     */
+    std::optional<uint16_t> Queue(const I2C_device &device, Byte_vector frame, uint8_t *data, uint16_t length);
+
+    /**
+     * @brief   Start actual request of bus, requests which cannot be started are failed,
+     *          bus is finished after its last request
+     */
+    void Issue(uint8_t bus);
+
+    /**
+     * @brief   Handle completion of transfer of bus, called from IRQ
+     */
+    void Next(uint8_t bus, bool success);
+
+    /**
+     * @brief   Count failed request, buses fail requests concurrently
+     */
+    void Failed();
+
+    /**
+     * @brief   Release one reference of running batch, last one finishes batch and invokes callback
+     */
+    void Finish();
+
+public:
+    I2C_bus_group() = default;
+
+    I2C_bus_group(const I2C_bus_group &) = delete;
+    I2C_bus_group &operator=(const I2C_bus_group &) = delete;
+
+    /**
+     * @brief   Add peripheral to group
+     *
+     * @param master    Bus, its handler identifies devices of bus
+     * @return std::optional<uint8_t>   Index of bus, empty if group is full or batch is running
+     */
+    std::optional<uint8_t> Add(const I2C_master &master);
+
+    /**
+     * @brief   Return index of bus to which device is connected, empty if bus of device is not in group
+     */
+    std::optional<uint8_t> Bus_of(const I2C_device &device) const;
+
+    /**
+     * @brief   Queue read of registers, buffer must be valid until completion of batch
+     *
+     * @param device        Device, request is executed by its bus
+     * @param address       Address of first register
+     * @param address_size  Size of register address in bytes, transmitted as big endian
+     * @param data          Buffer for received data
+     * @param length        Number of bytes to read
+     * @return std::optional<uint16_t>  Index of request, empty if bus of device is not in group, batch is running or group is full
+     */
+    std::optional<uint16_t> Read(const I2C_device &device, uint16_t address, uint8_t address_size, uint8_t *data, uint16_t length);
+
+    /**
+     * @brief   Queue write of registers, data are copied into request
+     *
+     * @param device        Device, request is executed by its bus
+     * @param address       Address of first register
+     * @param address_size  Size of register address in bytes, transmitted as big endian
+     * @param data          Data to write
+     * @return std::optional<uint16_t>  Index of request, empty if bus of device is not in group, batch is running or group is full
+     */
+    std::optional<uint16_t> Write(const I2C_device &device, uint16_t address, uint8_t address_size, const Byte_vector &data);
+
+    /**
+     * @brief   Remove all requests, buses stay in group
+     *
+     * @return false    Batch is running
+     */
+    bool Clear();
+
+    /**
+     * @brief   Start all queued requests, buses run concurrently
+     *
+     * @param callback  Invoked once after last request of all buses with true if all requests succeeded, can be null
+     *                  Invoked from IRQ, or directly if there are no requests
+     * @return false    Batch is already running
+     */
+    bool Start(Invocation_wrapper_base<void, bool> *callback = nullptr);
+
+    /**
+     * @brief   Return true while batch is running
+     */
+    bool Busy() const { return remaining > 0; };
+
+    /**
+     * @brief   Return true if request of last batch succeeded
+     */
+    bool Success(uint16_t request) const { return request < requests.size() && requests[request].success; };
+
+    /**
+     * @brief   Return number of failed requests of last batch
+     */
+    uint16_t Failures() const { return failures; };
+
+    /**
+     * @brief   Return number of buses in group
+     */
+    uint8_t Buses() const { return count; };
+
+    /**
+     * @brief   Return number of queued requests
+     */
+    size_t Requests() const { return requests.size(); };
+};
@@ -5,10 +5,10 @@ I2C_device::I2C_device(I2C_master &master, unsigned char address):
 
 }
 
-bool I2C_device::Transmit(const std::vector<uint8_t> &data) const{
-    return master.Transmit_poll(address, data);
+bool I2C_device::Transmit(const Byte_vector &data) const{
+    return master.Transmit_poll(address, data, &health);
 }
 
-std::optional<std::vector<uint8_t>> I2C_device::Receive(uint length){
-    return master.Receive_poll(address, length);
+std::optional<Byte_vector> I2C_device::Receive(uint length){
+    return master.Receive_poll(address, length, &health);
 }
@@ -12,12 +12,13 @@
 #include <algorithm>
 
 #include "i2c/i2c_master.hpp"
+#include "misc/register_device.hpp"
 
 /**
  * @brief Generic class for all devices, which are connected to I2C bus
  *
  */
-class I2C_device{
+class I2C_device : public Register_device{
 private:
     /**
      * @brief Object of master bus on which is device connected
@@ -31,6 +32,11 @@ private:
      */
     uint8_t address = 0;
 
+    /**
+     * @brief   Retry policy and error counters of device, updated by every transfer
+     */
+    mutable I2C_master::Health health;
+
 public:
     I2C_device() = default;
     /**
@@ -48,15 +54,42 @@ public:
      * @param data      Data to be send by bus
      * @return bool     True if packet was successfully transmitted (ACKed)
      */
-    bool Transmit(const std::vector<uint8_t> &data) const;
+    bool Transmit(const Byte_vector &data) const;
 
     /**
      * @brief   Receive data from device on bus
      *
      * @param length    Number of bytes to be received
-     * @return optional<vector<uint8_t>> Return read value if transmission was successful, otherwise empty optional
+     * @return optional<Byte_vector> Return read value if transmission was successful, otherwise empty optional
+     */
+    std::optional<Byte_vector> Receive(uint length) ;
+
+    /**
+     * @brief   Return bus on which is device connected
      */
-    std::optional<std::vector<uint8_t>> Receive(uint length) ;
+    const I2C_master &Master() const { return master; };
+
+    /**
+     * @brief   Return address of device in 8-bit format
+     */
+    uint8_t Address() const { return address; };
+
+    /**
+     * @brief   Return retry policy and error counters of device
+     */
+    const I2C_master::Health &Health() const { return health; };
+
+    /**
+     * @brief   Set retry and timeout policy of transfers with device
+     *
+     * @param policy    Number of retries, backoff and time for clock stretching
+     */
+    void Policy(const I2C_master::Policy &policy){ health.policy = policy; };
+
+    /**
+     * @brief   Reset error counters of device
+     */
+    void Reset_statistics(){ health.statistics = I2C_master::Statistics(); };
 
     /**
      * @brief   Write data to device using standart I2C method
@@ -68,13 +101,13 @@ public:
      * @return bool         True if packet was successfully transmitted (ACKed)
      */
     template<typename T = uint8_t>
-    bool Write(T mem_address, std::vector<uint8_t> data){
-        std::vector<uint8_t> address_bytes(sizeof(T));
+    bool Write(T mem_address, Byte_vector data){
+        Byte_vector address_bytes(sizeof(T));
         std::reverse_copy(reinterpret_cast<const uint8_t*>(&mem_address),
                           reinterpret_cast<const uint8_t*>(&mem_address) + sizeof(T),
                           address_bytes.begin());
         data.insert(data.begin(), address_bytes.begin(), address_bytes.end());
-        return master.Transmit_poll(address, data);
+        return master.Transmit_poll(address, data, &health);
     }
 
     /**
@@ -83,19 +116,39 @@ public:
      *
      * @param mem_address       Address in device memory to read data
      * @param length            Number of bytes to be received
-     * @return vector<uint8_t>  Received data
+     * @return Byte_vector  Received data
      */
     template<typename T = uint8_t>
-    std::optional<std::vector<uint8_t>> Read(T mem_address, uint length){
-        std::vector<uint8_t> address_bytes(sizeof(T));
+    std::optional<Byte_vector> Read(T mem_address, uint length){
+        Byte_vector address_bytes(sizeof(T));
         // Switch endianity of address
         std::reverse_copy(reinterpret_cast<const uint8_t*>(&mem_address),
                           reinterpret_cast<const uint8_t*>(&mem_address) + sizeof(T),
                           address_bytes.begin());
-        if(master.Transmit_poll(address, address_bytes)){
-            return master.Receive_poll(address, length);
+        if(master.Transmit_poll(address, address_bytes, &health)){
+            return master.Receive_poll(address, length, &health);
         } else {
             return {};
         }
     }
+
+    /**
+     * @brief   Read registers by Read with address of given size, implementation of Register_device
+     */
+    std::optional<Byte_vector> Read_registers(uint16_t address, uint8_t address_size, uint length) override{
+        if(address_size == 2){
+            return Read<uint16_t>(address, length);
+        }
+        return Read<uint8_t>(address, length);
+    }
+
+    /**
+     * @brief   Write registers by Write with address of given size, implementation of Register_device
+     */
+    bool Write_registers(uint16_t address, uint8_t address_size, const Byte_vector &data) override{
+        if(address_size == 2){
+            return Write<uint16_t>(address, data);
+        }
+        return Write<uint8_t>(address, data);
+    }
 };
@@ -1,31 +1,233 @@
 #include "i2c_master.hpp"
 
-I2C_master::I2C_master(I2C_HandleTypeDef *handler, uint speed)
-    : handler(handler), speed(speed)
+#include "misc/critical_section.hpp"
+#include "misc/probe.hpp"
+#include "trace/bus_trace.hpp"
+
+I2C_master::I2C_master(I2C_HandleTypeDef *handler, uint speed, uint8_t index)
+    : handler(handler), speed(speed), index(index)
+{
+}
+
+void I2C_master::Recovery_lines(GPIO_TypeDef *scl_port, uint16_t scl_pin, GPIO_TypeDef *sda_port, uint16_t sda_pin){
+    this->scl_port = scl_port;
+    this->scl_pin = scl_pin;
+    this->sda_port = sda_port;
+    this->sda_pin = sda_pin;
+}
+
+uint32_t I2C_master::Timeout(uint32_t length, uint16_t stretch) const
+{
+    // Start and stop condition + 9 bits (data and ACK) per byte including address
+    uint32_t bits = 2 + 9 * (length + 1);
+    uint32_t bus_speed = speed ? speed : 100000;
+    // One more ms because tick can increment right after start of transfer
+    return (bits * 1000 + bus_speed - 1) / bus_speed + stretch + 1;
+}
+
+void I2C_master::Half_clock() const
+{
+    uint32_t ticks = Probe::Frequency() / (2 * (speed ? speed : 100000));
+    if (ticks == 0) {
+        // Counter is slower than bus clock (HAL tick)
+        HAL_Delay(1);
+        return;
+    }
+    // Number of spins limits waiting when cycle counter was not enabled, every spin takes at least one cycle
+    // Loop is not removed by optimization, every spin reads counter
+    uint32_t start = Probe::Now();
+    for (uint32_t spin = 0; spin < ticks && (Probe::Now() - start) < ticks; spin++) { }
+}
+
+bool I2C_master::Recover() const
 {
+    if (scl_port == nullptr || sda_port == nullptr) {
+        return false;
+    }
+    HAL_I2C_DeInit(handler);
+
+    // Output data register is set before switching to output, so no false clock is generated
+    HAL_GPIO_WritePin(scl_port, scl_pin, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(sda_port, sda_pin, GPIO_PIN_SET);
+    GPIO_InitTypeDef init = {};
+    init.Mode = GPIO_MODE_OUTPUT_OD;
+    init.Pull = GPIO_NOPULL;
+    init.Speed = GPIO_SPEED_FREQ_LOW;
+    init.Pin = scl_pin;
+    HAL_GPIO_Init(scl_port, &init);
+    init.Pin = sda_pin;
+    HAL_GPIO_Init(sda_port, &init);
+
+    // Slave releases SDA at latest after it clocks out remaining bits of byte and ACK
+    for (uint8_t clock = 0; clock < 9 && HAL_GPIO_ReadPin(sda_port, sda_pin) == GPIO_PIN_RESET; clock++) {
+        HAL_GPIO_WritePin(scl_port, scl_pin, GPIO_PIN_RESET);
+        Half_clock();
+        HAL_GPIO_WritePin(scl_port, scl_pin, GPIO_PIN_SET);
+        Half_clock();
+    }
+    bool released = HAL_GPIO_ReadPin(sda_port, sda_pin) == GPIO_PIN_SET;
+
+    // Stop condition, rising edge of SDA while SCL is high
+    HAL_GPIO_WritePin(scl_port, scl_pin, GPIO_PIN_RESET);
+    Half_clock();
+    HAL_GPIO_WritePin(sda_port, sda_pin, GPIO_PIN_RESET);
+    Half_clock();
+    HAL_GPIO_WritePin(scl_port, scl_pin, GPIO_PIN_SET);
+    Half_clock();
+    HAL_GPIO_WritePin(sda_port, sda_pin, GPIO_PIN_SET);
+    Half_clock();
+
+    // MSP initialization of peripheral switches pins back to alternate function
+    HAL_I2C_Init(handler);
+    return released;
+}
+
+HAL_StatusTypeDef I2C_master::Execute(Transfer transfer, uint8_t addr, uint8_t *data, uint16_t length, Health *health) const
+{
+    const Policy &active = health ? health->policy : policy;
+    uint8_t retries = (transfer == Transfer::Ping) ? 0 : active.retries;
+    uint32_t timeout = Timeout(length, active.stretch);
+    HAL_StatusTypeDef status = HAL_ERROR;
+
+    // Interrupt transfer owns peripheral, recovery would destroy it and its completion would never arrive
+    if (Busy()) {
+        return HAL_BUSY;
+    }
+
+    for (uint8_t attempt = 0; attempt <= retries; attempt++) {
+        if (attempt > 0) {
+            HAL_Delay(static_cast<uint32_t>(active.backoff) << (attempt - 1));
+            if (health) {
+                health->statistics.retries++;
+            }
+        }
+
+        // Slave holding SDA low would block peripheral until timeout of busy flag
+        bool stuck = sda_port && HAL_GPIO_ReadPin(sda_port, sda_pin) == GPIO_PIN_RESET;
+        if (stuck && Recover() && health) {
+            health->statistics.recoveries++;
+        }
+
+        uint32_t start = Bus_trace::Start();
+        Trace::Operation operation = Trace::Operation::Transmit;
+        switch (transfer) {
+            case Transfer::Transmit:
+                status = HAL_I2C_Master_Transmit(handler, addr, data, length, timeout);
+                break;
+            case Transfer::Receive:
+                operation = Trace::Operation::Receive;
+                status = HAL_I2C_Master_Receive(handler, addr, data, length, timeout);
+                break;
+            case Transfer::Ping:
+                operation = Trace::Operation::Probe;
+                status = HAL_I2C_IsDeviceReady(handler, addr, 1, timeout);
+                break;
+        }
+        uint32_t error = handler->ErrorCode;
+        Bus_trace::Record(Trace::Bus::I2C, index, addr, operation, status, error, length, start);
+
+        if (health) {
+            health->statistics.transactions++;
+        }
+        if (status == HAL_OK || status == HAL_BUSY) {
+            // Busy peripheral is locked by other transfer, bus is not stuck
+            break;
+        }
+
+        bool timed_out = (status == HAL_TIMEOUT) || (error & HAL_I2C_ERROR_TIMEOUT);
+        if (health) {
+            health->statistics.errors += (transfer != Transfer::Ping);
+            health->statistics.nacks += (error & HAL_I2C_ERROR_AF) ? 1 : 0;
+            health->statistics.timeouts += timed_out;
+        }
+        if (timed_out && Recover() && health) {
+            health->statistics.recoveries++;
+        }
+    }
+    return status;
 }
 
-bool I2C_master::Transmit_poll(uint8_t addr, const vector<uint8_t> &data) const
+bool I2C_master::Transmit_poll(uint8_t addr, const Byte_vector &data, Health *health) const
 {
-    return !HAL_I2C_Master_Transmit(handler, addr, (uint8_t *)data.data(), data.size(), 100);
+    HALUP_PROBE("i2c.transmit");
+    return Execute(Transfer::Transmit, addr, (uint8_t *)data.data(), data.size(), health) == HAL_OK;
 }
 
-std::optional<vector<uint8_t>> I2C_master::Receive_poll(uint8_t addr, uint length)
+std::optional<Byte_vector> I2C_master::Receive_poll(uint8_t addr, uint length, Health *health)
 {
-    vector<uint8_t> data(length);
-    if(HAL_I2C_Master_Receive(handler, (uint8_t)addr, (uint8_t *)data.data(), length, 100)){
+    HALUP_PROBE("i2c.receive");
+    Byte_vector data(length);
+    // Transfer longer than HALUP_TRANSFER_SIZE does not fit into data in no-heap build
+    if(data.size() < length || Execute(Transfer::Receive, addr, data.data(), length, health) != HAL_OK){
         return {};
     } else {
         return data;
     }
 }
 
-bool I2C_master::Ping(uint8_t addr){
-    HAL_StatusTypeDef status = HAL_I2C_IsDeviceReady(handler, (uint8_t)addr, 1, 10);
+bool I2C_master::Ping(uint8_t addr, Health *health){
+    HALUP_PROBE("i2c.ping");
+    return Execute(Transfer::Ping, addr, nullptr, 0, health) == HAL_OK;
+}
 
-    if(status == HAL_OK){
-        return true;
-    } else {
+bool I2C_master::Start_IT(bool receive, uint8_t addr, uint8_t *data, uint16_t length, Invocation_wrapper_base<void, bool> *callback) const
+{
+    Pending *transfer;
+    {
+        Critical_section section;
+        transfer = pending.Emplace(handler);
+        if (transfer == nullptr || transfer->active) {
+            return false;
+        }
+        transfer->active = true;
+    }
+    transfer->callback = callback;
+    transfer->address = addr;
+    transfer->length = length;
+    transfer->index = index;
+    transfer->receive = receive;
+    transfer->start = Bus_trace::Start();
+
+    HAL_StatusTypeDef status = receive ? HAL_I2C_Master_Receive_IT(handler, addr, data, length)
+                                       : HAL_I2C_Master_Transmit_IT(handler, addr, data, length);
+    if (status != HAL_OK) {
+        transfer->active = false;
+        Bus_trace::Record(Trace::Bus::I2C, index, addr, receive ? Trace::Operation::Receive : Trace::Operation::Transmit,
+                          status, handler->ErrorCode, length, transfer->start);
         return false;
     }
+    return true;
+}
+
+bool I2C_master::Transmit_IT(uint8_t addr, const uint8_t *data, uint16_t length, Invocation_wrapper_base<void, bool> *callback) const
+{
+    return Start_IT(false, addr, const_cast<uint8_t *>(data), length, callback);
+}
+
+bool I2C_master::Receive_IT(uint8_t addr, uint8_t *data, uint16_t length, Invocation_wrapper_base<void, bool> *callback) const
+{
+    return Start_IT(true, addr, data, length, callback);
+}
+
+bool I2C_master::Busy() const
+{
+    Pending *transfer = pending.Find(handler);
+    return transfer && transfer->active;
+}
+
+void I2C_master::Complete(I2C_HandleTypeDef *handler, bool success)
+{
+    Pending *transfer = pending.Find(handler);
+    if (transfer == nullptr || !transfer->active) {
+        return;
+    }
+    Bus_trace::Record(Trace::Bus::I2C, transfer->index, transfer->address,
+                      transfer->receive ? Trace::Operation::Receive : Trace::Operation::Transmit,
+                      success ? HAL_OK : HAL_ERROR, handler->ErrorCode, transfer->length, transfer->start);
+    auto callback = transfer->callback;
+    transfer->active = false;
+    // Callback can start next transfer
+    if (callback) {
+        callback->Invoke(success);
+    }
 }
@@ -12,17 +12,130 @@
 #include <optional>
 
 #include "global_includes.hpp"
+#include "misc/handle_map.hpp"
+#include "misc/invocation_wrapper.hpp"
+#include "misc/no_heap.hpp"
 
 using namespace std;
 typedef unsigned int uint;
 
+/**
+ * @brief Maximal number of I2C peripherals with interrupt transfers
+ */
+#ifndef HALUP_I2C_BUSES
+#define HALUP_I2C_BUSES 4
+#endif
+
 /**
  * @brief I2C Bus in master role, comunicates with other device connected to bus
+ *        Timeout of every transfer is computed from its length and speed of bus, failed transfers
+ *        are retried with exponential backoff. When SDA is held low by slave, bus is recovered by nine
+ *        clocks on SCL driven as GPIO, if recovery lines are configured.
+ *        Worst case duration of call is (retries + 1) * timeout + sum of backoffs + recovery
+ *        Interrupt transfers are not retried, their completion is forwarded from HAL callbacks (see misc/hal_callbacks.hpp):
+ *            void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c){ I2C_master::Complete(hi2c); }
+ *            void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c){ I2C_master::Complete(hi2c); }
+ *            void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c){ I2C_master::Complete(hi2c, false); }
  */
 class I2C_master{
+public:
+    /**
+     * @brief Retry and timeout policy of transfers, can be set per device
+     */
+    struct Policy {
+        uint8_t retries = 2;    // Number of repetitions of failed transfer
+        uint8_t backoff = 1;    // Delay before first retry in ms, doubled with every next retry
+        uint16_t stretch = 1;   // Time in ms for which device can stretch clock, added to timeout
+    };
+
+    /**
+     * @brief Error counters of device
+     */
+    struct Statistics {
+        uint32_t transactions = 0;
+        uint32_t errors = 0;
+        uint32_t nacks = 0;
+        uint32_t timeouts = 0;
+        uint32_t retries = 0;
+        uint32_t recoveries = 0;
+    };
+
+    /**
+     * @brief Policy and counters of one device, owned by device and passed to transfers
+     */
+    struct Health {
+        Policy policy;
+        Statistics statistics;
+    };
+
 private:
-    I2C_HandleTypeDef *handler;
-    uint speed;
+    I2C_HandleTypeDef *handler = nullptr;
+    uint speed = 100000;
+
+    /**
+     * @brief Index of bus in records of Bus_trace
+     */
+    uint8_t index = 0;
+
+    /**
+     * @brief Policy of transfers without health of device
+     */
+    Policy policy;
+
+    /**
+     * @brief Pins of bus used for recovery, recovery is disabled when ports are null
+     */
+    GPIO_TypeDef *scl_port = nullptr;
+    uint16_t scl_pin = 0;
+    GPIO_TypeDef *sda_port = nullptr;
+    uint16_t sda_pin = 0;
+
+    /**
+     * @brief Type of transfer executed by Execute
+     */
+    enum class Transfer: uint8_t {
+        Transmit,
+        Receive,
+        Ping,
+    };
+
+    /**
+     * @brief Execute transfer with retries and recovery, record it into Bus_trace and counters
+     *
+     * @param transfer  Type of transfer
+     * @param addr      Target device address
+     * @param data      Transmitted or received data
+     * @param length    Number of bytes
+     * @param health    Policy and counters of device, policy of master is used if null
+     * @return HAL_StatusTypeDef Status of last attempt, HAL_BUSY without attempt if interrupt transfer is in progress
+     */
+    HAL_StatusTypeDef Execute(Transfer transfer, uint8_t addr, uint8_t *data, uint16_t length, Health *health) const;
+
+    /**
+     * @brief Wait for half of period of SCL
+     */
+    void Half_clock() const;
+
+    /**
+     * @brief Interrupt transfer in progress on peripheral
+     *        State is kept per handler, because master is copied into every device, callback finds it by handler in O(1)
+     */
+    struct Pending {
+        Invocation_wrapper_base<void, bool> *callback;
+        uint32_t start;
+        uint16_t length;
+        uint8_t address;
+        uint8_t index;
+        bool receive;
+        volatile bool active;
+    };
+
+    static inline Handle_map<I2C_HandleTypeDef, Pending, HALUP_I2C_BUSES> pending;
+
+    /**
+     * @brief Start interrupt transfer
+     */
+    bool Start_IT(bool receive, uint8_t addr, uint8_t *data, uint16_t length, Invocation_wrapper_base<void, bool> *callback) const;
 
 public:
     /**
@@ -35,33 +148,116 @@ public:
      *
      * @param handler pointer to handler structure of I2C
      * @param speed baudrate of bus
+     * @param index index of bus in records of Bus_trace
+     */
+    I2C_master(I2C_HandleTypeDef *handler, uint speed = 100000, uint8_t index = 0);
+
+    /**
+     * @brief Set pins of bus which are used for recovery of bus
+     *        Pins are switched to GPIO during recovery, peripheral is reinitialized by HAL_I2C_Init afterwards
+     *        Cycle counter must be enabled by Probe::Init on target with DWT
+     *
+     * @param scl_port  Port of SCL
+     * @param scl_pin   Mask of SCL pin (GPIO_PIN_x)
+     * @param sda_port  Port of SDA
+     * @param sda_pin   Mask of SDA pin (GPIO_PIN_x)
+     */
+    void Recovery_lines(GPIO_TypeDef *scl_port, uint16_t scl_pin, GPIO_TypeDef *sda_port, uint16_t sda_pin);
+
+    /**
+     * @brief Set policy of transfers which are executed without health of device
+     */
+    void Default_policy(const Policy &policy){ this->policy = policy; };
+
+    /**
+     * @brief Return timeout of transfer in ms
+     *        Duration of transfer on bus with time for clock stretching and resolution of HAL tick
+     *
+     * @param length    Number of transferred bytes without address
+     * @param stretch   Time for clock stretching in ms
+     * @return uint32_t Timeout in ms
+     */
+    uint32_t Timeout(uint32_t length, uint16_t stretch) const;
+
+    /**
+     * @brief Release bus held by slave, nine clocks are generated on SCL until SDA is released,
+     *        then stop condition is generated
+     *
+     * @return true     SDA is released
+     * @return false    Recovery lines are not configured or SDA is still low
      */
-    I2C_master(I2C_HandleTypeDef *handler, uint speed = 100000);
+    bool Recover() const;
 
     /**
      * @brief Transmit data to device on bus in polling mode
      *
      * @param addr Target device address
      * @param data Data to be send
-     * @return uint Success = 0, Error - 1, Busy - 2, Timeout - 3
+     * @param health Policy and counters of device, policy of master is used if null
+     * @return true Data were acknowledged by device
      */
-    bool Transmit_poll(uint8_t addr, const vector<uint8_t> &data) const;
+    bool Transmit_poll(uint8_t addr, const Byte_vector &data, Health *health = nullptr) const;
 
     /**
      * @brief Receive data from device on bus in polling mode
      *
      * @param addr Address of target device
      * @param length Number of bytes received
-     * @return vector<uint8_t> Received data
+     * @param health Policy and counters of device, policy of master is used if null
+     * @return Byte_vector Received data
      */
-    std::optional<vector<uint8_t>> Receive_poll(uint8_t addr, uint length = 1);
+    std::optional<Byte_vector> Receive_poll(uint8_t addr, uint length = 1, Health *health = nullptr);
 
     /**
      * @brief Test if target device is responding with ACK
+     *        Ping is not retried, not responding device is not an error of bus
      *
      * @param addr      Address of target device
+     * @param health    Counters of device, can be null
      * @return true     Device is present and ready (sending ACK)
      * @return false    Device is not responding with ACKs
      */
-    bool Ping(uint8_t addr);
+    bool Ping(uint8_t addr, Health *health = nullptr);
+
+    /**
+     * @brief Start transmission in interrupt mode, data must be valid until completion
+     *
+     * @param addr      Target device address
+     * @param data      Data to be send
+     * @param length    Number of bytes
+     * @param callback  Invoked from IRQ after completion with result of transfer, can be null
+     * @return true     Transfer was started
+     * @return false    Peripheral is busy or transfer cannot be started
+     */
+    bool Transmit_IT(uint8_t addr, const uint8_t *data, uint16_t length, Invocation_wrapper_base<void, bool> *callback) const;
+
+    /**
+     * @brief Start reception in interrupt mode, buffer must be valid until completion
+     *
+     * @param addr      Target device address
+     * @param data      Buffer for received data
+     * @param length    Number of bytes
+     * @param callback  Invoked from IRQ after completion with result of transfer, can be null
+     * @return true     Transfer was started
+     * @return false    Peripheral is busy or transfer cannot be started
+     */
+    bool Receive_IT(uint8_t addr, uint8_t *data, uint16_t length, Invocation_wrapper_base<void, bool> *callback) const;
+
+    /**
+     * @brief Return true if interrupt transfer is in progress on peripheral
+     */
+    bool Busy() const;
+
+    /**
+     * @brief Return handler of peripheral, identifies bus shared by copies of master
+     */
+    I2C_HandleTypeDef *Handler() const { return handler; };
+
+    /**
+     * @brief Finish interrupt transfer, must be called from HAL callbacks of transfer completion and error
+     *
+     * @param handler   Handler which finished transfer
+     * @param success   False if transfer was finished by error
+     */
+    static void Complete(I2C_HandleTypeDef *handler, bool success = true);
 };
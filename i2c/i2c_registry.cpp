@@ -0,0 +1,172 @@
+#include "i2c_registry.hpp"
+
+namespace {
+    /**
+     * @brief   Description of known part, range of 8-bit addresses and function which identifies part and creates driver
+     */
+    struct Identifier {
+        I2C_registry::Part part;
+        uint8_t first;
+        uint8_t last;
+        bool (*create)(I2C_master &master, uint8_t address, I2C_registry::Driver_slot &slot);
+    };
+
+    bool Create_TMP117(I2C_master &master, uint8_t address, I2C_registry::Driver_slot &slot){
+        TMP117 sensor(master, address);
+        if (sensor.ID() != 0x117) {
+            return false;
+        }
+        slot.emplace(std::in_place_type<TMP117>, sensor);
+        return true;
+    }
+
+    bool Create_LIS2DW12(I2C_master &master, uint8_t address, I2C_registry::Driver_slot &slot){
+        LIS2DW12 sensor(master, address);
+        if (sensor.ID() != 0x44) {
+            return false;
+        }
+        slot.emplace(std::in_place_type<LIS2DW12>, sensor);
+        return true;
+    }
+
+    bool Create_ST25DV(I2C_master &master, uint8_t address, I2C_registry::Driver_slot &slot){
+        // Driver is created only for identified part, memory size is read from system registers
+        I2C_device system(master, address);
+        if (Register_map::Read<ST25DV0xK::Map::MANUF_CODE>(system) != 0x02) {
+            return false;
+        }
+        // MEM_SIZE is number of 4 byte blocks minus one
+        auto blocks = Register_map::Read<ST25DV0xK::Map::MEM_SIZE>(system);
+        if (!blocks) {
+            return false;
+        }
+        uint8_t memory_size = (blocks.value() + 1) / 32;
+        slot.emplace(std::in_place_type<ST25DV0xK>, master, address, nullptr, memory_size);
+        return true;
+    }
+
+    const Identifier identifiers[] = {
+        {I2C_registry::Part::TMP117,   0x90, 0x96, Create_TMP117},
+        {I2C_registry::Part::LIS2DW12, 0x30, 0x32, Create_LIS2DW12},
+        {I2C_registry::Part::ST25DV,   0xae, 0xae, Create_ST25DV},
+    };
+}
+
+I2C_registry::I2C_registry(I2C_master master) :
+    master(master)
+{ }
+
+I2C_registry::Entry I2C_registry::Identify(uint8_t address){
+    uint8_t slot = 0;
+    while (slot < HALUP_I2C_REGISTRY_DRIVERS && drivers[slot]) {
+        slot++;
+    }
+    // Part is identified even if pool is full, its driver is discarded
+    Driver_slot discarded;
+    Driver_slot &driver = (slot < HALUP_I2C_REGISTRY_DRIVERS) ? drivers[slot] : discarded;
+
+    for (auto &identifier : identifiers) {
+        if (address < identifier.first || address > identifier.last) {
+            continue;
+        }
+        if (identifier.create(master, address, driver)) {
+            if (&driver == &discarded) {
+                return {address, identifier.part, nullptr, 0};
+            }
+            Register_device *device = std::visit([](auto &instance) -> Register_device * { return &instance; }, *driver);
+            return {address, identifier.part, device, slot};
+        }
+    }
+    return {address, Part::Unknown, nullptr, 0};
+}
+
+uint8_t I2C_registry::Scan(){
+    for (auto &bits : found) {
+        bits = 0;
+    }
+    for (uint8_t address = first_address; address <= last_address; address++) {
+        if (master.Ping(address << 1)) {
+            found[address >> 5] |= 1UL << (address & 31);
+        }
+    }
+    cursor = first_address;
+    scans++;
+    Update();
+    return entries.size();
+}
+
+bool I2C_registry::Step(uint8_t count){
+    if (cursor == first_address) {
+        for (auto &bits : found) {
+            bits = 0;
+        }
+    }
+    for (; count > 0 && cursor <= last_address; count--, cursor++) {
+        if (master.Ping(cursor << 1)) {
+            found[cursor >> 5] |= 1UL << (cursor & 31);
+        }
+    }
+    if (cursor <= last_address) {
+        return false;
+    }
+    cursor = first_address;
+    scans++;
+    Update();
+    return true;
+}
+
+void I2C_registry::Update(){
+    // Remove devices which disappeared
+    for (auto entry = entries.begin(); entry != entries.end();) {
+        if (Get_bit(found, entry->address >> 1)) {
+            entry++;
+            continue;
+        }
+        Event event = {entry->address, entry->part, false};
+        if (entry->driver) {
+            drivers[entry->slot].reset();
+        }
+        entry = entries.erase(entry);
+        if (callback) {
+            callback->Invoke(event);
+        }
+    }
+
+    // Identify new devices, entries are kept sorted by address
+    for (uint8_t address = first_address; address <= last_address; address++) {
+        if (!Get_bit(found, address) || Find(address << 1)) {
+            continue;
+        }
+        if (entries.size() >= entries.max_size()) {
+            break;
+        }
+        Entry entry = Identify(address << 1);
+        Event event = {entry.address, entry.part, true};
+        auto position = entries.begin();
+        while (position != entries.end() && position->address < entry.address) {
+            position++;
+        }
+        entries.insert(position, std::move(entry));
+        if (callback) {
+            callback->Invoke(event);
+        }
+    }
+}
+
+const I2C_registry::Entry *I2C_registry::Find(uint8_t address) const{
+    for (auto &entry : entries) {
+        if (entry.address == address) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const char *I2C_registry::Name(Part part){
+    switch (part) {
+        case Part::TMP117:   return "TMP117";
+        case Part::LIS2DW12: return "LIS2DW12";
+        case Part::ST25DV:   return "ST25DV";
+        default:             return "unknown";
+    }
+}
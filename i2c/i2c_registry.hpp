@@ -0,0 +1,197 @@
+/**
+ * @file i2c_registry.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <variant>
+
+#include "i2c/i2c_device.hpp"
+#include "misc/invocation_wrapper.hpp"
+#include "misc/no_heap.hpp"
+#include "nfc/ST25DV0xK.hpp"
+#include "sensors/LIS2DW12.hpp"
+#include "sensors/TMP117.hpp"
+
+/**
+ * @brief   Maximal number of drivers created by I2C_registry
+ */
+#ifndef HALUP_I2C_REGISTRY_DRIVERS
+#define HALUP_I2C_REGISTRY_DRIVERS 8
+#endif
+
+/**
+ * @brief   Maximal number of devices in I2C_registry in no-heap build
+ */
+#ifndef HALUP_I2C_REGISTRY_DEVICES
+#define HALUP_I2C_REGISTRY_DEVICES 16
+#endif
+
+/**
+ * @brief   Discovery of devices on I2C bus and registry of their drivers
+ *          Bus is scanned by address-only probes with timeout derived from speed of bus,
+ *              absent device is answered by NACK within one byte time, so whole bus is scanned in few ms
+ *          Scan can be performed at once by Scan() or incrementally by Step() from main loop,
+ *              repeated incremental scans detect attached and detached devices (hot-plug)
+ *          Found devices are identified by ID registers of known parts and driver object is created for them,
+ *              drivers are stored in fixed pool inside registry, so no memory is allocated during scan
+ */
+class I2C_registry {
+public:
+    /**
+     * @brief   Known parts which are identified by registry
+     */
+    enum class Part: uint8_t {
+        Unknown  = 0,
+        TMP117   = 1,
+        LIS2DW12 = 2,
+        ST25DV   = 3,
+    };
+
+    /**
+     * @brief   Device present on bus
+     */
+    struct Entry {
+        uint8_t address;                        // 8-bit address
+        Part part;
+        Register_device *driver;                // Null for unknown devices or if pool of drivers is full
+        uint8_t slot;                           // Index of driver in pool
+    };
+
+    /**
+     * @brief   Slot of pool of drivers, empty if slot is free
+     */
+    using Driver_slot = std::optional<std::variant<TMP117, LIS2DW12, ST25DV0xK>>;
+
+    /**
+     * @brief   Change of presence of device, passed to callback
+     */
+    struct Event {
+        uint8_t address;
+        Part part;
+        bool attached;
+    };
+
+    /**
+     * @brief   First and last valid 7-bit address, other addresses are reserved
+     */
+    static constexpr uint8_t first_address = 0x08;
+    static constexpr uint8_t last_address = 0x77;
+
+private:
+    I2C_master master;
+
+    Bounded_vector<Entry, HALUP_I2C_REGISTRY_DEVICES> entries;
+
+    /**
+     * @brief   Pool of drivers, entries point into it
+     */
+    Driver_slot drivers[HALUP_I2C_REGISTRY_DRIVERS];
+
+    /**
+     * @brief   Presence of 7-bit addresses found by current scan
+     */
+    uint32_t found[4] = {};
+
+    /**
+     * @brief   Next 7-bit address probed by Step
+     */
+    uint8_t cursor = first_address;
+
+    /**
+     * @brief   Number of completed scans
+     */
+    uint32_t scans = 0;
+
+    Invocation_wrapper_base<void, Event> *callback = nullptr;
+
+    /**
+     * @brief   Identify part at address and create its driver in free slot of pool
+     */
+    Entry Identify(uint8_t address);
+
+    /**
+     * @brief   Compare result of scan with registry, add new devices and remove missing ones
+     */
+    void Update();
+
+    static bool Get_bit(const uint32_t *bits, uint8_t address){ return bits[address >> 5] & (1UL << (address & 31)); };
+
+public:
+    /**
+     * @brief Construct a new I2C_registry object
+     *
+     * @param master    I2C bus which is scanned
+     */
+    explicit I2C_registry(I2C_master master);
+
+    I2C_registry(const I2C_registry &) = delete;
+    I2C_registry &operator=(const I2C_registry &) = delete;
+
+    /**
+     * @brief   Scan whole bus at once and update registry
+     *
+     * @return uint8_t  Number of present devices
+     */
+    uint8_t Scan();
+
+    /**
+     * @brief   Probe next addresses of incremental scan, registry is updated after last address
+     *
+     * @param count     Number of probed addresses
+     * @return true     Scan was completed by this step and registry is updated
+     * @return false    Scan continues
+     */
+    bool Step(uint8_t count = 8);
+
+    /**
+     * @brief   Register callback which is called when device appears or disappears
+     */
+    void Register(Invocation_wrapper_base<void, Event> *callback){ this->callback = callback; };
+
+    /**
+     * @brief   Return all devices present on bus
+     */
+    const Bounded_vector<Entry, HALUP_I2C_REGISTRY_DEVICES> &Devices() const { return entries; };
+
+    /**
+     * @brief   Return number of completed scans
+     */
+    uint32_t Scans() const { return scans; };
+
+    /**
+     * @brief   Return registry entry of device at address, null if device is not present
+     *
+     * @param address   8-bit address of device
+     */
+    const Entry *Find(uint8_t address) const;
+
+    /**
+     * @brief   Return driver of n-th device of given part
+     *          Type of driver must match part: TMP117, LIS2DW12, ST25DV0xK
+     *
+     * @tparam T        Type of driver
+     * @param part      Part of device
+     * @param index     Index of device among devices of same part
+     * @return T*       Driver or null if there is no such device
+     */
+    template <typename T>
+    T *Driver(Part part, uint8_t index = 0) const {
+        for (auto &entry : entries) {
+            if (entry.part == part && entry.driver && index-- == 0) {
+                return static_cast<T *>(entry.driver);
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief   Return name of part
+     */
+    static const char *Name(Part part);
+};
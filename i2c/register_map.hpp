@@ -0,0 +1,249 @@
+/**
+ * @file register_map.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "misc/register_device.hpp"
+
+/**
+ * @brief   Compile-time description of registers of devices, accessed over any Register_device (I2C, SPI)
+ *          Layout describes conventions of device (width of register address, width of register, byte order, burst support),
+ *              Register describes address, access mode and type of value, Field describes bits of register
+ *          All descriptors are types, accessors are generated at compile time, no table is searched at runtime
+ *          Example:
+ *              using Layout = Register_map::Layout<uint8_t, uint16_t, Register_map::Endian::Big>;
+ *              using Configuration = Register_map::Register<Layout, 0x01>;
+ *              using Mode = Register_map::Field<Configuration, 0x0c00, Mode_enum>;
+ *              Register_map::Modify<Mode>(device, Mode_enum::Shutdown);
+ */
+namespace Register_map {
+    /**
+     * @brief   Order of bytes of multibyte registers on bus
+     */
+    enum class Endian: uint8_t {
+        Big,
+        Little,
+    };
+
+    /**
+     * @brief   Allowed access to register, checked at compile time
+     */
+    enum class Access: uint8_t {
+        Read_only,
+        Write_only,
+        Read_write,
+    };
+
+    /**
+     * @brief   Conventions of device
+     *
+     * @tparam Address_T    Type of register address transmitted before data (uint8_t or uint16_t)
+     * @tparam Unit_T       Type of register at one address, address is incremented by one per unit
+     * @tparam byte_order   Order of bytes of multibyte values
+     * @tparam burst        Device increments address during transfer, so contiguous registers can be read at once
+     */
+    template <typename Address_T, typename Unit_T, Endian byte_order, bool burst = true>
+    struct Layout {
+        using address_type = Address_T;
+        using unit_type = Unit_T;
+        static constexpr Endian endian = byte_order;
+        static constexpr bool burst_read = burst;
+        static constexpr size_t unit = sizeof(Unit_T);
+    };
+
+    /**
+     * @brief   Register of device
+     *
+     * @tparam Layout_T     Layout of device
+     * @tparam address_v    Address of register, can be value of enum of device
+     * @tparam access_v     Allowed access
+     * @tparam Value_T      Type of value, can span several units of device (16-bit value in 8-bit registers)
+     */
+    template <typename Layout_T, auto address_v, Access access_v = Access::Read_write, typename Value_T = typename Layout_T::unit_type>
+    struct Register {
+        using layout = Layout_T;
+        using value_type = Value_T;
+        static constexpr typename Layout_T::address_type address = static_cast<typename Layout_T::address_type>(address_v);
+        static constexpr Access access = access_v;
+        static constexpr size_t size = sizeof(Value_T);
+
+        static_assert(size % Layout_T::unit == 0, "Value of register must be whole number of units of device");
+    };
+
+    /**
+     * @brief   Bits of register
+     *
+     * @tparam Register_T   Register which contains field
+     * @tparam mask_v       Mask of field in value of register, bits must be contiguous
+     * @tparam Field_T      Type of value of field (integer, bool or enum)
+     */
+    template <typename Register_T, auto mask_v, typename Field_T = typename Register_T::value_type>
+    struct Field {
+        using register_type = Register_T;
+        using field_type = Field_T;
+        using raw_type = std::make_unsigned_t<typename Register_T::value_type>;
+        static constexpr raw_type mask = static_cast<raw_type>(mask_v);
+        static constexpr uint8_t shift = __builtin_ctzll(mask);
+
+        static_assert(mask != 0, "Mask of field must not be empty");
+        static_assert(((mask >> shift) & ((mask >> shift) + 1)) == 0, "Bits of field must be contiguous");
+
+        /**
+         * @brief   Return value of field from value of register
+         */
+        static constexpr Field_T Extract(typename Register_T::value_type value){
+            return static_cast<Field_T>((static_cast<raw_type>(value) & mask) >> shift);
+        }
+
+        /**
+         * @brief   Return value of register with field replaced by new value
+         */
+        static constexpr typename Register_T::value_type Insert(typename Register_T::value_type value, Field_T field){
+            raw_type bits = (static_cast<raw_type>(field) << shift) & mask;
+            return static_cast<typename Register_T::value_type>((static_cast<raw_type>(value) & ~mask) | bits);
+        }
+    };
+
+    /**
+     * @brief   Convert bytes received from device into value of register
+     */
+    template <typename Register_T>
+    constexpr typename Register_T::value_type Decode(const uint8_t *bytes){
+        using raw_type = std::make_unsigned_t<typename Register_T::value_type>;
+        raw_type value = 0;
+        for (size_t i = 0; i < Register_T::size; i++) {
+            size_t position = (Register_T::layout::endian == Endian::Big) ? i : Register_T::size - 1 - i;
+            value = static_cast<raw_type>((value << 8) | bytes[position]);
+        }
+        return static_cast<typename Register_T::value_type>(value);
+    }
+
+    /**
+     * @brief   Convert value of register into bytes transmitted to device
+     */
+    template <typename Register_T>
+    constexpr void Encode(typename Register_T::value_type value, uint8_t *bytes){
+        using raw_type = std::make_unsigned_t<typename Register_T::value_type>;
+        raw_type raw = static_cast<raw_type>(value);
+        for (size_t i = 0; i < Register_T::size; i++) {
+            size_t position = (Register_T::layout::endian == Endian::Big) ? Register_T::size - 1 - i : i;
+            bytes[position] = static_cast<uint8_t>(raw & 0xff);
+            raw = static_cast<raw_type>(raw >> 8);
+        }
+    }
+
+    /**
+     * @brief   Read value of register
+     *
+     * @return std::optional<value_type>    Value of register, empty if transfer failed
+     */
+    template <typename Register_T>
+    std::optional<typename Register_T::value_type> Read(Register_device &device){
+        static_assert(Register_T::access != Access::Write_only, "Register is write only");
+        auto data = device.Read_registers(Register_T::address, sizeof(typename Register_T::layout::address_type), Register_T::size);
+        if (!data || data->size() < Register_T::size) {
+            return {};
+        }
+        return Decode<Register_T>(data->data());
+    }
+
+    /**
+     * @brief   Write value into register
+     *
+     * @return true     Value was acknowledged by device
+     */
+    template <typename Register_T>
+    bool Write(Register_device &device, typename Register_T::value_type value){
+        static_assert(Register_T::access != Access::Read_only, "Register is read only");
+        Byte_vector data(Register_T::size);
+        Encode<Register_T>(value, data.data());
+        return device.Write_registers(Register_T::address, sizeof(typename Register_T::layout::address_type), data);
+    }
+
+    /**
+     * @brief   Read value of field
+     *
+     * @return std::optional<field_type>    Value of field, empty if transfer failed
+     */
+    template <typename Field_T>
+    std::optional<typename Field_T::field_type> Read_field(Register_device &device){
+        auto value = Read<typename Field_T::register_type>(device);
+        if (!value) {
+            return {};
+        }
+        return Field_T::Extract(*value);
+    }
+
+    /**
+     * @brief   Change value of field by read-modify-write of register, other bits of register are preserved
+     *
+     * @return true     Register was read and written successfully
+     */
+    template <typename Field_T>
+    bool Modify(Register_device &device, typename Field_T::field_type field){
+        static_assert(Field_T::register_type::access == Access::Read_write, "Modification of field requires readable and writable register");
+        auto value = Read<typename Field_T::register_type>(device);
+        if (!value) {
+            return false;
+        }
+        return Write<typename Field_T::register_type>(device, Field_T::Insert(*value, field));
+    }
+
+    /**
+     * @brief   Return true if every register follows previous one without gap
+     */
+    template <typename First, typename... Rest>
+    constexpr bool Contiguous(){
+        if constexpr (sizeof...(Rest) == 0) {
+            return true;
+        } else {
+            using Next = std::tuple_element_t<0, std::tuple<Rest...>>;
+            return (Next::address == First::address + First::size / First::layout::unit) && Contiguous<Rest...>();
+        }
+    }
+
+    /**
+     * @brief   Decode register from data of burst and move offset behind it
+     */
+    template <typename Register_T>
+    constexpr typename Register_T::value_type Take(const uint8_t *data, size_t &offset){
+        auto value = Decode<Register_T>(data + offset);
+        offset += Register_T::size;
+        return value;
+    }
+
+    /**
+     * @brief   Read contiguous registers by single transfer
+     *          Contiguity, access and burst support of device are checked at compile time
+     *
+     * @tparam Registers    Registers in ascending order of address
+     * @return std::optional<std::tuple<value_type...>> Values of registers, empty if transfer failed
+     */
+    template <typename... Registers>
+    std::optional<std::tuple<typename Registers::value_type...>> Read_burst(Register_device &device){
+        using First = std::tuple_element_t<0, std::tuple<Registers...>>;
+        static_assert(First::layout::burst_read, "Device does not support burst read");
+        static_assert(Contiguous<Registers...>(), "Registers of burst must be contiguous");
+        static_assert(((Registers::access != Access::Write_only) && ...), "Burst contains write only register");
+
+        constexpr size_t length = (Registers::size + ...);
+        auto data = device.Read_registers(First::address, sizeof(typename First::layout::address_type), length);
+        if (!data || data->size() < length) {
+            return {};
+        }
+        size_t offset = 0;
+        // Elements of braced initializer are evaluated in order, so offsets follow order of registers
+        return std::tuple<typename Registers::value_type...>{Take<Registers>(data->data(), offset)...};
+    }
+}
@@ -0,0 +1,115 @@
+#include "log_decoder.hpp"
+
+#include <algorithm>
+
+Log_decoder::Log_decoder(std::function<void(const Event &)> callback) :
+    callback(callback)
+{ }
+
+size_t Log_decoder::Expected_length(const uint8_t *data, size_t length){
+    if (data[0] == static_cast<uint8_t>(Log::Packet::Event)) {
+        if (length < 8) {
+            return 0;
+        }
+        return data[7] <= HALUP_LOG_MAX_ARGUMENTS * sizeof(uint64_t) ? 8 + data[7] : invalid;
+    }
+    // Definition packet
+    if (length < 5) {
+        return 0;
+    }
+    uint8_t argument_count = data[4];
+    if (argument_count > HALUP_LOG_MAX_ARGUMENTS) {
+        return invalid;
+    }
+    size_t format_offset = 5 + argument_count + 2;
+    for (size_t i = 5; i < std::min(length, format_offset - 2); i++) {
+        if (data[i] > static_cast<uint8_t>(Log::Argument_type::Double)) {
+            return invalid;
+        }
+    }
+    if (length < format_offset) {
+        return 0;
+    }
+    size_t format_length = data[format_offset - 2] | data[format_offset - 1] << 8;
+    return format_length <= format_max ? format_offset + format_length : invalid;
+}
+
+void Log_decoder::Feed(const uint8_t *data, size_t length){
+    packet.insert(packet.end(), data, data + length);
+
+    size_t position = 0;
+    while (position < packet.size()) {
+        const uint8_t *start = packet.data() + position;
+        size_t available = packet.size() - position;
+        bool tag = start[0] == static_cast<uint8_t>(Log::Packet::Event) || start[0] == static_cast<uint8_t>(Log::Packet::Definition);
+        size_t expected = tag ? Expected_length(start, available) : invalid;
+        if (expected == 0 || (expected != invalid && available < expected)) {
+            break;
+        }
+        if (expected != invalid && Process_packet(start, expected)) {
+            position += expected;
+        } else {
+            // Damaged packet, search for next tag from following byte
+            skipped++;
+            position++;
+        }
+    }
+    packet.erase(packet.begin(), packet.begin() + position);
+}
+
+bool Log_decoder::Process_packet(const uint8_t *data, size_t length){
+    uint16_t id = data[1] | data[2] << 8;
+
+    if (data[0] == static_cast<uint8_t>(Log::Packet::Definition)) {
+        Definition definition;
+        definition.level = static_cast<Log::Level>(data[3]);
+        uint8_t argument_count = data[4];
+        for (uint8_t i = 0; i < argument_count; i++) {
+            definition.types.push_back(static_cast<Log::Argument_type>(data[5 + i]));
+        }
+        definition.format.assign(data + 5 + argument_count + 2, data + length);
+        definitions[id] = definition;
+        return true;
+    }
+
+    auto definition = definitions.find(id);
+    if (definition == definitions.end()) {
+        unknown++;
+        return true;
+    }
+
+    // Damaged length or definition of other firmware would read arguments out of packet
+    size_t payload_length = 0;
+    for (Log::Argument_type type : definition->second.types) {
+        payload_length += Log::Argument_size(type);
+    }
+    if (payload_length != data[7]) {
+        unknown++;
+        return false;
+    }
+
+    Event event;
+    event.id = id;
+    event.level = definition->second.level;
+    event.timestamp = data[3] | data[4] << 8 | data[5] << 16 | static_cast<uint32_t>(data[6]) << 24;
+
+    std::string text(definition->second.format.size() + 24 * definition->second.types.size() + 1, '\0');
+    size_t text_length = Log::Format(
+        definition->second.format.c_str(),
+        definition->second.types.data(),
+        definition->second.types.size(),
+        data + 8,
+        text.data(),
+        text.size()
+    );
+    text.resize(text_length);
+    event.text = text;
+    if (callback) {
+        callback(event);
+    }
+    return true;
+}
+
+std::string Log_decoder::Format_line(const Event &event){
+    return "[" + std::to_string(event.timestamp) + "] " + Log::Level_name(event.level) + " " + event.text;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file log_decoder.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "log/log_record.hpp"
+
+/**
+ * @brief   Host side decoder of binary log output of Logger
+ *          Data can be fed in arbitrary fragments, damaged packet is skipped byte by byte until next valid packet
+ *          Definitions of messages are collected from stream, events are formatted into text lines
+ */
+class Log_decoder {
+public:
+    /**
+     * @brief   Decoded log event
+     */
+    struct Event {
+        uint16_t id;
+        Log::Level level;
+        uint32_t timestamp;
+        std::string text;
+    };
+
+private:
+    /**
+     * @brief   Definition of message received from target
+     */
+    struct Definition {
+        Log::Level level;
+        std::vector<Log::Argument_type> types;
+        std::string format;
+    };
+
+    /**
+     * @brief   Definitions of messages indexed by id
+     */
+    std::map<uint16_t, Definition> definitions;
+
+    /**
+     * @brief   Received bytes which were not parsed yet, start by tag of packet
+     */
+    std::vector<uint8_t> packet;
+
+    /**
+     * @brief   Function which receives decoded events
+     */
+    std::function<void(const Event &)> callback;
+
+    /**
+     * @brief   Number of bytes which were skipped because they do not belong to any valid packet
+     */
+    uint32_t skipped = 0;
+
+    /**
+     * @brief   Number of events of which definition was not received or does not match payload
+     */
+    uint32_t unknown = 0;
+
+    /**
+     * @brief   Expected length of packet which is not valid
+     */
+    static constexpr size_t invalid = SIZE_MAX;
+
+    /**
+     * @brief   Maximal length of format string in definition packet, longer length means damaged packet
+     */
+    static constexpr size_t format_max = 1024;
+
+    /**
+     * @brief   Return expected length of packet at start of data
+     *
+     * @param data      Data starting by tag of packet
+     * @param length    Number of available bytes
+     * @return size_t   Length of packet, 0 if length cannot be determined yet, invalid if header of packet is damaged
+     */
+    static size_t Expected_length(const uint8_t *data, size_t length);
+
+    /**
+     * @brief   Process complete packet
+     *
+     * @return false    Payload of event does not match its definition, packet is skipped
+     */
+    bool Process_packet(const uint8_t *data, size_t length);
+
+public:
+    /**
+     * @brief Construct a new Log_decoder object
+     *
+     * @param callback  Function which receives decoded events
+     */
+    explicit Log_decoder(std::function<void(const Event &)> callback);
+
+    /**
+     * @brief   Feed received bytes into decoder
+     *
+     * @param data      Received data
+     * @param length    Number of received bytes
+     */
+    void Feed(const uint8_t *data, size_t length);
+
+    /**
+     * @brief   Format decoded event into line as it would be formatted by Logger in text output
+     *
+     * @param event         Decoded event
+     * @return std::string  Formatted line without line ending
+     */
+    static std::string Format_line(const Event &event);
+
+    /**
+     * @brief   Return number of bytes which were skipped because they do not belong to any packet
+     */
+    uint32_t Skipped() const { return skipped; };
+
+    /**
+     * @brief   Return number of events of which definition was not received
+     */
+    uint32_t Unknown() const { return unknown; };
+};
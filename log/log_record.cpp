@@ -0,0 +1,77 @@
+#include "log_record.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+namespace {
+    template <typename T>
+    T Load(const uint8_t *payload){
+        T value;
+        std::memcpy(&value, payload, sizeof(T));
+        return value;
+    }
+
+    char *Format_argument(Log::Argument_type type, const uint8_t *payload, char *begin, char *end){
+        std::to_chars_result result{begin, std::errc()};
+        switch (type) {
+            case Log::Argument_type::Bool: {
+                const char *text = payload[0] ? "true" : "false";
+                size_t length = std::min<size_t>(std::strlen(text), end - begin);
+                std::memcpy(begin, text, length);
+                return begin + length;
+            }
+            case Log::Argument_type::Char:
+                if (begin < end) {
+                    *begin++ = static_cast<char>(payload[0]);
+                }
+                return begin;
+            case Log::Argument_type::Int8:   result = std::to_chars(begin, end, Load<int8_t>(payload));   break;
+            case Log::Argument_type::Uint8:  result = std::to_chars(begin, end, Load<uint8_t>(payload));  break;
+            case Log::Argument_type::Int16:  result = std::to_chars(begin, end, Load<int16_t>(payload));  break;
+            case Log::Argument_type::Uint16: result = std::to_chars(begin, end, Load<uint16_t>(payload)); break;
+            case Log::Argument_type::Int32:  result = std::to_chars(begin, end, Load<int32_t>(payload));  break;
+            case Log::Argument_type::Uint32: result = std::to_chars(begin, end, Load<uint32_t>(payload)); break;
+            case Log::Argument_type::Int64:  result = std::to_chars(begin, end, Load<int64_t>(payload));  break;
+            case Log::Argument_type::Uint64: result = std::to_chars(begin, end, Load<uint64_t>(payload)); break;
+            case Log::Argument_type::Float:  result = std::to_chars(begin, end, Load<float>(payload));    break;
+            case Log::Argument_type::Double: result = std::to_chars(begin, end, Load<double>(payload));   break;
+        }
+        if (result.ec != std::errc()) {
+            return begin;
+        }
+        return result.ptr;
+    }
+}
+
+const char *Log::Level_name(Log::Level level){
+    switch (level) {
+        case Level::Trace:   return "TRACE";
+        case Level::Debug:   return "DEBUG";
+        case Level::Info:    return "INFO ";
+        case Level::Warning: return "WARN ";
+        case Level::Error:   return "ERROR";
+    }
+    return "?????";
+}
+
+size_t Log::Format(const char *format, const Argument_type *types, uint8_t argument_count, const uint8_t *payload, char *output, size_t capacity){
+    if (capacity == 0) {
+        return 0;
+    }
+    char *position = output;
+    char *end = output + capacity - 1; // Space for terminating null
+    uint8_t argument = 0;
+
+    while (*format != '\0' && position < end) {
+        if (format[0] == '{' && format[1] == '}' && argument < argument_count) {
+            position = Format_argument(types[argument], payload, position, end);
+            payload += Argument_size(types[argument]);
+            argument++;
+            format += 2;
+        } else {
+            *position++ = *format++;
+        }
+    }
+    *position = '\0';
+    return position - output;
+}
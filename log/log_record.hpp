@@ -0,0 +1,175 @@
+/**
+ * @file log_record.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief   Minimal level of log messages which are compiled into firmware
+ *          Messages with lower level are removed at compile time including their arguments
+ *          0 - Trace, 1 - Debug, 2 - Info, 3 - Warning, 4 - Error
+ */
+#ifndef HALUP_LOG_LEVEL
+#define HALUP_LOG_LEVEL 1
+#endif
+
+/**
+ * @brief   Maximal number of arguments of one log message
+ */
+#ifndef HALUP_LOG_MAX_ARGUMENTS
+#define HALUP_LOG_MAX_ARGUMENTS 8
+#endif
+
+/**
+ * @brief   Format of records shared by logger on target and decoder on host side
+ *          Log event is stored as reference to static message (format string and level),
+ *          timestamp and raw bytes of arguments, formatting is done later outside of call site
+ */
+namespace Log {
+    /**
+     * @brief   Severity of log message
+     */
+    enum class Level: uint8_t {
+        Trace   = 0,
+        Debug   = 1,
+        Info    = 2,
+        Warning = 3,
+        Error   = 4,
+    };
+
+    /**
+     * @brief   Level of messages which are compiled into firmware
+     */
+    inline constexpr Level compile_level = static_cast<Level>(HALUP_LOG_LEVEL);
+
+    /**
+     * @brief   Type of argument stored in record, determines size and formatting of argument
+     */
+    enum class Argument_type: uint8_t {
+        Bool    = 0,
+        Char    = 1,
+        Int8    = 2,
+        Uint8   = 3,
+        Int16   = 4,
+        Uint16  = 5,
+        Int32   = 6,
+        Uint32  = 7,
+        Int64   = 8,
+        Uint64  = 9,
+        Float   = 10,
+        Double  = 11,
+    };
+
+    /**
+     * @brief   Tags of packets in binary export of log
+     *          Definition packet: tag, id (2B), level (1B), argument count (1B), argument types, format length (2B), format
+     *          Event packet:      tag, id (2B), timestamp (4B), payload length (1B), payload
+     *          All multibyte values are little-endian
+     */
+    enum class Packet: uint8_t {
+        Definition = 0xd1,
+        Event      = 0xe1,
+    };
+
+    /**
+     * @brief   Static description of one log call site, created by logging macros
+     *          Id and argument types are filled during first recording of message
+     */
+    struct Message {
+        const char *format;
+        Level level;
+        uint16_t id = 0;
+        uint8_t argument_count = 0;
+        Argument_type argument_types[HALUP_LOG_MAX_ARGUMENTS] = {};
+        bool exported = false;
+
+        constexpr Message(const char *format, Level level) :
+            format(format), level(level)
+        { }
+    };
+
+    /**
+     * @brief   Size of argument in record
+     *
+     * @param type      Type of argument
+     * @return size_t   Number of bytes occupied by argument
+     */
+    constexpr size_t Argument_size(Argument_type type){
+        switch (type) {
+            case Argument_type::Bool:
+            case Argument_type::Char:
+            case Argument_type::Int8:
+            case Argument_type::Uint8:  return 1;
+            case Argument_type::Int16:
+            case Argument_type::Uint16: return 2;
+            case Argument_type::Int32:
+            case Argument_type::Uint32:
+            case Argument_type::Float:  return 4;
+            case Argument_type::Int64:
+            case Argument_type::Uint64:
+            case Argument_type::Double: return 8;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief   Type tag of argument of C++ type
+     *
+     * @tparam T    Type of argument, only arithmetic types and enums are supported
+     */
+    template <typename T>
+    constexpr Argument_type Type_of(){
+        using type = std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::common_type<T>>;
+        using value_T = typename type::type;
+        static_assert(std::is_arithmetic_v<value_T>, "Log arguments must be arithmetic values, pointers and strings are not supported");
+        if constexpr (std::is_same_v<value_T, bool>) {
+            return Argument_type::Bool;
+        } else if constexpr (std::is_same_v<value_T, char>) {
+            return Argument_type::Char;
+        } else if constexpr (std::is_same_v<value_T, float>) {
+            return Argument_type::Float;
+        } else if constexpr (std::is_floating_point_v<value_T>) {
+            static_assert(sizeof(value_T) == 8, "Only float and double are supported");
+            return Argument_type::Double;
+        } else if constexpr (sizeof(value_T) == 1) {
+            return std::is_signed_v<value_T> ? Argument_type::Int8 : Argument_type::Uint8;
+        } else if constexpr (sizeof(value_T) == 2) {
+            return std::is_signed_v<value_T> ? Argument_type::Int16 : Argument_type::Uint16;
+        } else if constexpr (sizeof(value_T) == 4) {
+            return std::is_signed_v<value_T> ? Argument_type::Int32 : Argument_type::Uint32;
+        } else {
+            return std::is_signed_v<value_T> ? Argument_type::Int64 : Argument_type::Uint64;
+        }
+    }
+
+    /**
+     * @brief   Name of level used as prefix of formatted message
+     *
+     * @param level         Level of message
+     * @return const char*  Name of level padded to same length
+     */
+    const char *Level_name(Level level);
+
+    /**
+     * @brief   Format message with arguments from raw record payload
+     *          Every {} in format is replaced by next argument, output is truncated to capacity
+     *          Output is terminated by null if capacity is not zero
+     *
+     * @param format            Format string of message
+     * @param types             Types of arguments
+     * @param argument_count    Number of arguments
+     * @param payload           Raw little-endian bytes of arguments
+     * @param output            Target buffer
+     * @param capacity          Size of target buffer
+     * @return size_t           Number of written characters without terminating null
+     */
+    size_t Format(const char *format, const Argument_type *types, uint8_t argument_count, const uint8_t *payload, char *output, size_t capacity);
+}
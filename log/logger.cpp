@@ -0,0 +1,152 @@
+#include "logger.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <string_view>
+
+#include "color.hpp"
+#include "misc/critical_section.hpp"
+
+namespace {
+    std::string_view Level_color(Log::Level level){
+        switch (level) {
+            case Log::Level::Trace:   return dye::light_black.code;
+            case Log::Level::Debug:   return dye::cyan.code;
+            case Log::Level::Info:    return dye::green.code;
+            case Log::Level::Warning: return dye::yellow.code;
+            case Log::Level::Error:   return (dye::bold + dye::red).code;
+        }
+        return {};
+    }
+
+    size_t Append(char *output, size_t position, size_t capacity, std::string_view text){
+        size_t length = std::min(text.size(), capacity - position);
+        std::memcpy(output + position, text.data(), length);
+        return position + length;
+    }
+}
+
+Logger::Logger(Serial_line &line, Output output, bool colors, uint32_t (*timestamp_source)()) :
+    line(&line), output(output), colors(colors), timestamp_source(timestamp_source)
+{ }
+
+void Logger::Copy_in(uint32_t position, const void *data, size_t length){
+    const uint8_t *source = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < length; i++) {
+        buffer[(position + i) & (HALUP_LOG_BUFFER_SIZE - 1)] = source[i];
+    }
+}
+
+void Logger::Copy_out(uint32_t position, void *data, size_t length) const{
+    uint8_t *target = static_cast<uint8_t *>(data);
+    for (size_t i = 0; i < length; i++) {
+        target[i] = buffer[(position + i) & (HALUP_LOG_BUFFER_SIZE - 1)];
+    }
+}
+
+bool Logger::Push(Log::Message &message, const Log::Argument_type *types, uint8_t argument_count, const uint8_t *payload, uint8_t length){
+    uint32_t timestamp = timestamp_source ? timestamp_source() : 0;
+    uint8_t record_length = header_size + length;
+    Log::Message *message_pointer = &message;
+
+    Critical_section section;
+    if (message.id == 0) {  // First record of message, describe it
+        message.id = ++last_id;
+        message.argument_count = argument_count;
+        std::copy(types, types + argument_count, message.argument_types);
+    }
+    if (HALUP_LOG_BUFFER_SIZE - (head - tail) < record_length) {
+        dropped = dropped + 1;
+        return false;
+    }
+    uint32_t position = head;
+    Copy_in(position, &record_length, 1);
+    position += 1;
+    Copy_in(position, &message_pointer, sizeof(message_pointer));
+    position += sizeof(message_pointer);
+    Copy_in(position, &timestamp, sizeof(timestamp));
+    position += sizeof(timestamp);
+    Copy_in(position, payload, length);
+    head = position + length;
+    return true;
+}
+
+uint32_t Logger::Process(uint32_t max_records){
+    uint32_t processed = 0;
+    while ((max_records == 0 || processed < max_records) && (head != tail)) {
+        uint8_t record[header_size + HALUP_LOG_MAX_ARGUMENTS * sizeof(uint64_t)];
+        uint8_t record_length;
+        Copy_out(tail, &record_length, 1);
+        Copy_out(tail, record, record_length);
+        tail = tail + record_length;    // Release space before slow transmission
+
+        Log::Message *message;
+        uint32_t timestamp;
+        std::memcpy(&message, record + 1, sizeof(message));
+        std::memcpy(&timestamp, record + 1 + sizeof(message), sizeof(timestamp));
+        const uint8_t *payload = record + header_size;
+        uint8_t payload_length = record_length - header_size;
+
+        if (output == Output::Text) {
+            Emit_text(*message, timestamp, payload);
+        } else {
+            Emit_binary(*message, timestamp, payload, payload_length);
+        }
+        processed++;
+    }
+    return processed;
+}
+
+void Logger::Emit_text(const Log::Message &message, uint32_t timestamp, const uint8_t *payload){
+    char text[line_size];
+    size_t capacity = line_size - 2;    // Space for line ending
+    size_t position = 0;
+
+    if (colors) {
+        position = Append(text, position, capacity, Level_color(message.level));
+    }
+    position = Append(text, position, capacity, "[");
+    position = std::to_chars(text + position, text + capacity, timestamp).ptr - text;
+    position = Append(text, position, capacity, "] ");
+    position = Append(text, position, capacity, Log::Level_name(message.level));
+    position = Append(text, position, capacity, " ");
+    position += Log::Format(message.format, message.argument_types, message.argument_count, payload, text + position, capacity - position);
+    if (colors) {
+        position = Append(text, position, capacity, dye::Reset_code);
+    }
+    text[position++] = '\r';
+    text[position++] = '\n';
+    line->Send(Serial_line::Text(text, position));
+}
+
+void Logger::Emit_binary(Log::Message &message, uint32_t timestamp, const uint8_t *payload, uint8_t length){
+    if (not message.exported) {
+        uint16_t format_length = std::strlen(message.format);
+        Serial_line::Text definition;
+        definition.reserve(7 + message.argument_count + format_length);
+        definition.push_back(static_cast<char>(Log::Packet::Definition));
+        definition.push_back(static_cast<char>(message.id & 0xff));
+        definition.push_back(static_cast<char>(message.id >> 8));
+        definition.push_back(static_cast<char>(message.level));
+        definition.push_back(static_cast<char>(message.argument_count));
+        for (uint8_t i = 0; i < message.argument_count; i++) {
+            definition.push_back(static_cast<char>(message.argument_types[i]));
+        }
+        definition.push_back(static_cast<char>(format_length & 0xff));
+        definition.push_back(static_cast<char>(format_length >> 8));
+        definition.append(message.format, format_length);
+        line->Send(definition);
+        message.exported = true;
+    }
+
+    char event[8 + HALUP_LOG_MAX_ARGUMENTS * sizeof(uint64_t)];
+    event[0] = static_cast<char>(Log::Packet::Event);
+    event[1] = static_cast<char>(message.id & 0xff);
+    event[2] = static_cast<char>(message.id >> 8);
+    for (int i = 0; i < 4; i++) {
+        event[3 + i] = static_cast<char>((timestamp >> (i * 8)) & 0xff);
+    }
+    event[7] = static_cast<char>(length);
+    std::memcpy(event + 8, payload, length);
+    line->Send(Serial_line::Text(event, 8 + length));
+}
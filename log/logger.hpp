@@ -0,0 +1,209 @@
+/**
+ * @file logger.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "global_includes.hpp"
+#include "log/log_record.hpp"
+#include "uart/serial_line.hpp"
+
+/**
+ * @brief   Size of ring buffer of log records in bytes, must be power of two
+ */
+#ifndef HALUP_LOG_BUFFER_SIZE
+#define HALUP_LOG_BUFFER_SIZE 1024
+#endif
+
+/**
+ * @brief   Record message into logger if level of message is not filtered out at compile time
+ *          Arguments of filtered message are not evaluated
+ *          Example: LOG_INFO(logger, "Temperature {} C, axis {}", temperature, x);
+ */
+#define HALUP_LOG(logger, level, format, ...)                                     \
+    do {                                                                          \
+        if constexpr ((level) >= Log::compile_level) {                            \
+            static Log::Message halup_log_message((format), (level));             \
+            (logger).Record(halup_log_message, ##__VA_ARGS__);                    \
+        }                                                                         \
+    } while (0)
+
+#define LOG_TRACE(logger, format, ...)   HALUP_LOG(logger, Log::Level::Trace, format, ##__VA_ARGS__)
+#define LOG_DEBUG(logger, format, ...)   HALUP_LOG(logger, Log::Level::Debug, format, ##__VA_ARGS__)
+#define LOG_INFO(logger, format, ...)    HALUP_LOG(logger, Log::Level::Info, format, ##__VA_ARGS__)
+#define LOG_WARNING(logger, format, ...) HALUP_LOG(logger, Log::Level::Warning, format, ##__VA_ARGS__)
+#define LOG_ERROR(logger, format, ...)   HALUP_LOG(logger, Log::Level::Error, format, ##__VA_ARGS__)
+
+/**
+ * @brief   Deferred logger over serial line
+ *          Call site only copies raw arguments and reference to static message into ring buffer,
+ *              formatting and transmission is done later by Process() from low priority context (main loop)
+ *          Records can be emitted as formatted text (optionally colored) or as binary packets,
+ *              which are decoded on host side by Log_decoder
+ *          Recording is protected by critical section and can be used from IRQ handlers
+ */
+class Logger {
+public:
+    /**
+     * @brief   Form of data emitted by logger to serial line
+     */
+    enum class Output: uint8_t {
+        Text   = 0, // Formatted lines, formatting is done on target
+        Binary = 1, // Binary packets, formatting is done on host by Log_decoder
+    };
+
+private:
+    static_assert((HALUP_LOG_BUFFER_SIZE & (HALUP_LOG_BUFFER_SIZE - 1)) == 0, "Size of log buffer must be power of two");
+
+    /**
+     * @brief   Size of record header: length, pointer to message, timestamp
+     */
+    static constexpr size_t header_size = 1 + sizeof(Log::Message *) + sizeof(uint32_t);
+
+    /**
+     * @brief   Maximal size of formatted line
+     */
+    static constexpr size_t line_size = 160;
+
+    /**
+     * @brief   Serial line to which are log records emitted
+     */
+    Serial_line *line;
+
+    /**
+     * @brief   Form of emitted records
+     */
+    Output output;
+
+    /**
+     * @brief   If true, text output is colored by level of message
+     */
+    bool colors;
+
+    /**
+     * @brief   Source of timestamps of records, HAL_GetTick by default
+     */
+    uint32_t (*timestamp_source)();
+
+    /**
+     * @brief   Ring buffer of records which are waiting for processing
+     */
+    uint8_t buffer[HALUP_LOG_BUFFER_SIZE];
+
+    /**
+     * @brief   Free running write and read positions in ring buffer
+     */
+    volatile uint32_t head = 0;
+    volatile uint32_t tail = 0;
+
+    /**
+     * @brief   Number of records which were dropped due to full buffer
+     */
+    volatile uint32_t dropped = 0;
+
+    /**
+     * @brief   Last id assigned to message, ids are shared by all loggers
+     */
+    static inline uint16_t last_id = 0;
+
+    /**
+     * @brief   Store record into ring buffer
+     *
+     * @param message           Message of call site
+     * @param types             Types of arguments, used to describe message during first record
+     * @param argument_count    Number of arguments
+     * @param payload           Raw bytes of arguments
+     * @param length            Size of payload
+     * @return true             Record was stored
+     * @return false            Buffer is full, record was dropped
+     */
+    bool Push(Log::Message &message, const Log::Argument_type *types, uint8_t argument_count, const uint8_t *payload, uint8_t length);
+
+    /**
+     * @brief   Copy data into ring buffer from given position, wraps around end of buffer
+     */
+    void Copy_in(uint32_t position, const void *data, size_t length);
+
+    /**
+     * @brief   Copy data from ring buffer from given position, wraps around end of buffer
+     */
+    void Copy_out(uint32_t position, void *data, size_t length) const;
+
+    /**
+     * @brief   Emit record as formatted text line
+     */
+    void Emit_text(const Log::Message &message, uint32_t timestamp, const uint8_t *payload);
+
+    /**
+     * @brief   Emit record as binary event packet, preceded by definition packet of message if it was not exported yet
+     */
+    void Emit_binary(Log::Message &message, uint32_t timestamp, const uint8_t *payload, uint8_t length);
+
+public:
+    /**
+     * @brief Construct a new Logger object
+     *
+     * @param line              Serial line to which are records emitted
+     * @param output            Form of emitted records
+     * @param colors            Color text output by level of messages
+     * @param timestamp_source  Function which returns timestamp of record in ms
+     */
+    Logger(Serial_line &line, Output output = Output::Text, bool colors = false, uint32_t (*timestamp_source)() = HAL_GetTick);
+
+    /**
+     * @brief   Record message with arguments, is invoked by logging macros
+     *          Only raw values of arguments are copied, no formatting is done
+     *
+     * @tparam args_T   Types of arguments, only arithmetic types and enums are supported
+     * @param message   Static message of call site
+     * @param args      Arguments of message
+     * @return true     Record was stored
+     * @return false    Buffer is full, record was dropped
+     */
+    template <typename... args_T>
+    bool Record(Log::Message &message, args_T... args){
+        static_assert(sizeof...(args_T) <= HALUP_LOG_MAX_ARGUMENTS, "Too many arguments of log message");
+        if constexpr (sizeof...(args_T) == 0) {
+            return Push(message, nullptr, 0, nullptr, 0);
+        } else {
+            const Log::Argument_type types[] = {Log::Type_of<args_T>()...};
+            uint8_t payload[(sizeof(args_T) + ...)];
+            size_t offset = 0;
+            ((std::memcpy(payload + offset, &args, sizeof(args_T)), offset += sizeof(args_T)), ...);
+            return Push(message, types, sizeof...(args_T), payload, sizeof(payload));
+        }
+    }
+
+    /**
+     * @brief   Format and emit stored records to serial line, should be called from low priority context
+     *
+     * @param max_records   Maximal number of processed records, 0 processes all records
+     * @return uint32_t     Number of processed records
+     */
+    uint32_t Process(uint32_t max_records = 0);
+
+    /**
+     * @brief   Return number of dropped records since start of logger
+     *
+     * @return uint32_t Number of dropped records
+     */
+    uint32_t Dropped() const { return dropped; };
+
+    /**
+     * @brief   Return number of bytes occupied by records waiting for processing
+     *
+     * @return uint32_t Occupied size of buffer
+     */
+    uint32_t Pending() const { return head - tail; };
+
+    /**
+     * @brief   Drop records waiting for processing, must be called from same context as Process()
+     */
+    void Clear(){ tail = head; };
+};
@@ -0,0 +1,44 @@
+/**
+ * @file critical_section.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "global_includes.hpp"
+
+/**
+ * @brief   Scoped critical section, interrupts are disabled during lifetime of object
+ *          Previous state of interrupts is restored at destruction, so sections can be nested
+ */
+class Critical_section {
+private:
+    /**
+     * @brief   State of PRIMASK register before entering section
+     */
+    uint32_t primask;
+
+public:
+    /**
+     * @brief   Enter critical section by disabling of interrupts
+     */
+    Critical_section() :
+        primask(__get_PRIMASK())
+    {
+        __disable_irq();
+    }
+
+    /**
+     * @brief   Leave critical section, restores previous state of interrupts
+     */
+    ~Critical_section(){
+        __set_PRIMASK(primask);
+    }
+
+    Critical_section(const Critical_section &) = delete;
+    Critical_section &operator=(const Critical_section &) = delete;
+};
@@ -0,0 +1,78 @@
+#include "hal_callbacks.hpp"
+
+#if HALUP_HAL_CALLBACKS
+
+#include "i2c/i2c_master.hpp"
+#include "rtc/rtc_timer.hpp"
+#include "spi/spi_master.hpp"
+#include "uart/uart.hpp"
+
+#ifdef MCU_FAMILY_HOST
+# include "usb/usb_cdc.hpp"
+#endif
+
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart){
+    if (UART *uart = UART::Of(huart)) {
+        uart->Receive();
+    }
+}
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart){
+    if (UART *uart = UART::Of(huart)) {
+        uart->Resend();
+    }
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c){
+    I2C_master::Complete(hi2c);
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c){
+    I2C_master::Complete(hi2c);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c){
+    I2C_master::Complete(hi2c, false);
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi){
+    if (SPI_master *master = SPI_master::Of(hspi)) {
+        master->Complete();
+    }
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi){
+    if (SPI_master *master = SPI_master::Of(hspi)) {
+        master->Complete(false);
+    }
+}
+
+void HAL_RTC_AlarmAEventCallback(RTC_HandleTypeDef *hrtc){
+    if (RTC_timer_wheel *wheel = RTC_timer_wheel::Of(hrtc)) {
+        wheel->Alarm();
+    }
+}
+
+#ifdef MCU_FAMILY_HOST
+
+// Callbacks of CDC interface are part of usbd_cdc_if.c on MCU, simulated device calls these
+int8_t CDC_Receive_FS(uint8_t *Buf, uint32_t *Len){
+    if (USB_CDC *cdc = USB_CDC::Of(&hUsbDeviceFS)) {
+        cdc->Packet_received(Buf, *Len);
+    }
+    return USBD_OK;
+}
+
+int8_t CDC_TransmitCplt_FS(uint8_t *Buf, uint32_t *Len, uint8_t epnum){
+    (void)Buf;
+    (void)Len;
+    (void)epnum;
+    if (USB_CDC *cdc = USB_CDC::Of(&hUsbDeviceFS)) {
+        cdc->Packet_transmitted();
+    }
+    return USBD_OK;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,38 @@
+/**
+ * @file hal_callbacks.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+/**
+ * @brief   Library can define HAL callbacks of UART, I2C, SPI and RTC alarm, disabled by default (opt-in)
+ *          Enable by HALUP_HAL_CALLBACKS 1 in build flags of project, callbacks then must not be defined elsewhere,
+ *              otherwise linking fails with multiple definitions (CubeMX generates none of them, but application may)
+ *          Migration: projects which relied on callbacks of library define HALUP_HAL_CALLBACKS 1,
+ *              without it UART receives nothing, interrupt transfers of I2C and DMA of SPI never complete
+ *              and RTC_timer_wheel is not woken by alarm
+ *          Callback is shared by all instances of peripheral, object of library is found by handle in O(1):
+ *              UART::Of(huart)                 - Receive() after RX, Resend() after TX
+ *              I2C_master::Complete(hi2c)      - completion or error of interrupt transfer
+ *              SPI_master::Of(hspi)            - Complete() after DMA transfer or its error
+ *              RTC_timer_wheel::Of(hrtc)       - Alarm() after alarm A
+ *          Callbacks of USB CDC are part of usbd_cdc_if.c generated by CubeMX (see usb/usb_cdc.hpp),
+ *              library defines them only for simulated device in host build
+ *          HAL defines its callbacks as weak, so definitions in hal_callbacks.cpp replace them
+ *          Main loop which sleeps (Run_loop) is woken by objects, not by callbacks, register its Wake by
+ *              Wake_notification of serial line (UART, USB_CDC) and of RTC_timer_wheel:
+ *              Invocation_wrapper<Run_loop, void, void> wake(&loop, &Run_loop::Wake);
+ *              uart.Wake_notification(&wake);
+ *              wheel.Wake_notification(&wake);
+ *          Projects which need additional work in callbacks keep them disabled and forward callbacks by same functions:
+ *              void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart){
+ *                  if (UART *uart = UART::Of(huart)) uart->Receive();
+ *                  ...
+ *              }
+ */
+#ifndef HALUP_HAL_CALLBACKS
+#define HALUP_HAL_CALLBACKS 0
+#endif
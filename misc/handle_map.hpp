@@ -0,0 +1,148 @@
+/**
+ * @file handle_map.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "misc/critical_section.hpp"
+
+/**
+ * @brief   Map from HAL handle to object of library, used to route shared HAL callbacks to instance of driver
+ *          Handles are hashed by address into open addressing table with at most half of slots used,
+ *              so lookup from IRQ takes one or two comparisons independently of number of peripherals
+ *          Table is fixed array, insertion and removal are done in critical section, lookup is safe from IRQ
+ *
+ * @tparam Handle_T HAL handle, for example UART_HandleTypeDef
+ * @tparam Value_T  Value stored for handle, pointer to driver or state of peripheral
+ * @tparam N        Maximal number of handles
+ */
+template <typename Handle_T, typename Value_T, size_t N>
+class Handle_map {
+private:
+    /**
+     * @brief   Number of slots, power of two at least twice the capacity
+     */
+    static constexpr size_t slots_count = [](){
+        size_t size = 1;
+        while (size < 2 * N) {
+            size <<= 1;
+        }
+        return size;
+    }();
+
+    struct Slot {
+        const Handle_T *handle = nullptr;
+        Value_T value = {};
+    };
+
+    Slot slots[slots_count] = {};
+
+    size_t count = 0;
+
+    /**
+     * @brief   Return preferred slot of handle, Fibonacci hashing of address
+     */
+    static size_t Home(const Handle_T *handle){
+        uint32_t key = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(handle) >> 2);
+        return ((key * 2654435769u) >> 16) & (slots_count - 1);
+    }
+
+    /**
+     * @brief   Return slot of handle or first empty slot of its probe sequence
+     */
+    size_t Probe(const Handle_T *handle) const {
+        size_t index = Home(handle);
+        while (slots[index].handle != nullptr && slots[index].handle != handle) {
+            index = (index + 1) & (slots_count - 1);
+        }
+        return index;
+    }
+
+public:
+    /**
+     * @brief   Return value of handle, null if handle is not in map
+     */
+    Value_T *Find(const Handle_T *handle){
+        if (handle == nullptr) {
+            return nullptr;
+        }
+        Slot &slot = slots[Probe(handle)];
+        return slot.handle ? &slot.value : nullptr;
+    }
+
+    /**
+     * @brief   Return value of handle, default constructed value is added if handle is not in map
+     *
+     * @return Value_T*     Value of handle, null if map is full
+     */
+    Value_T *Emplace(const Handle_T *handle){
+        if (handle == nullptr) {
+            return nullptr;
+        }
+        Critical_section section;
+        Slot &slot = slots[Probe(handle)];
+        if (slot.handle == nullptr) {
+            if (count >= N) {
+                return nullptr;
+            }
+            slot.value = Value_T{};
+            slot.handle = handle;
+            count++;
+        }
+        return &slot.value;
+    }
+
+    /**
+     * @brief   Set value of handle
+     *
+     * @return false    Map is full
+     */
+    bool Insert(const Handle_T *handle, const Value_T &value){
+        Critical_section section;
+        Value_T *stored = Emplace(handle);
+        if (stored == nullptr) {
+            return false;
+        }
+        *stored = value;
+        return true;
+    }
+
+    /**
+     * @brief   Remove handle from map, following slots of cluster are shifted back so no probe sequence is broken
+     *
+     * @return false    Handle is not in map
+     */
+    bool Erase(const Handle_T *handle){
+        if (handle == nullptr) {
+            return false;
+        }
+        Critical_section section;
+        size_t hole = Probe(handle);
+        if (slots[hole].handle == nullptr) {
+            return false;
+        }
+        slots[hole].handle = nullptr;
+        count--;
+        for (size_t index = (hole + 1) & (slots_count - 1); slots[index].handle != nullptr; index = (index + 1) & (slots_count - 1)) {
+            // Entry can fill the hole only if its home is not between hole and its position (cyclically)
+            size_t home = Home(slots[index].handle);
+            if (((index - home) & (slots_count - 1)) >= ((index - hole) & (slots_count - 1))) {
+                slots[hole] = slots[index];
+                slots[index].handle = nullptr;
+                hole = index;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief   Return number of handles in map
+     */
+    size_t Size() const { return count; };
+};
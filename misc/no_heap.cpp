@@ -0,0 +1,13 @@
+#include "no_heap.hpp"
+
+#ifdef HALUP_NO_HEAP
+
+#include <new>
+
+// Deleting destructors of polymorphic classes reference operator delete even if no object is created by new,
+// default operator delete calls free, so it is replaced by empty one to keep allocator out of image
+void operator delete(void *) noexcept { }
+
+void operator delete(void *, size_t) noexcept { }
+
+#endif
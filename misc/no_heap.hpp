@@ -0,0 +1,75 @@
+/**
+ * @file no_heap.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "misc/static_string.hpp"
+#include "misc/static_vector.hpp"
+
+/**
+ * @brief   No-heap build mode, enabled by defining HALUP_NO_HEAP for whole library
+ *          Containers of library are selected by aliases below, in no-heap build they are replaced
+ *              by Static_vector and Static_string with capacity given by template parameter,
+ *              so memory of every component is known at compile time and heap is never fragmented
+ *          Capacities of components are configured by HALUP_* macros, they are ignored in normal build
+ *          Functions which cannot work without heap (conversion to std::string, creation of drivers by new)
+ *              are not available in no-heap build
+ *          Absence of heap is checked by linker, any reference to allocator becomes undefined symbol:
+ *              -DHALUP_NO_HEAP -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+ *              -Wl,--wrap=_malloc_r,--wrap=_calloc_r,--wrap=_realloc_r,--wrap=_free_r    (newlib)
+ *          operator new of libstdc++ calls malloc, so it is caught as well, exceptions must be disabled (-fno-exceptions),
+ *              because memory of thrown exception is allocated from heap
+ *          Deleting destructors of polymorphic classes reference operator delete, it is replaced by empty one in no_heap.cpp
+ */
+
+/**
+ * @brief   Maximal number of bytes of one register transfer or SPI frame in no-heap build
+ */
+#ifndef HALUP_TRANSFER_SIZE
+#define HALUP_TRANSFER_SIZE 256
+#endif
+
+/**
+ * @brief   Maximal number of characters of RX buffer of Serial_line and of one sent message in no-heap build
+ */
+#ifndef HALUP_SERIAL_BUFFER
+#define HALUP_SERIAL_BUFFER 256
+#endif
+
+#ifdef HALUP_NO_HEAP
+
+/**
+ * @brief   Vector with capacity N in no-heap build, std::vector otherwise
+ */
+template <typename T, size_t N>
+using Bounded_vector = Static_vector<T, N>;
+
+/**
+ * @brief   String with capacity N in no-heap build, std::string otherwise
+ */
+template <size_t N>
+using Bounded_string = Static_string<N>;
+
+#else
+
+template <typename T, size_t N>
+using Bounded_vector = std::vector<T>;
+
+template <size_t N>
+using Bounded_string = std::string;
+
+#endif
+
+/**
+ * @brief   Data of register transfers
+ */
+using Byte_vector = Bounded_vector<uint8_t, HALUP_TRANSFER_SIZE>;
@@ -0,0 +1,134 @@
+/**
+ * @file number_format.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief   Number of decimal places of floating point values formatted without explicit precision
+ *          Default is same as std::to_string
+ */
+#ifndef HALUP_FLOAT_PRECISION
+#define HALUP_FLOAT_PRECISION 6
+#endif
+
+/**
+ * @brief   Formatting of numbers into buffer of caller by std::to_chars, no memory is allocated and no locale is used
+ *          Plain values are formatted as decimal integers or fixed point floats, other formats are selected by wrappers:
+ *              Number::Hex(register_value, 2)      -> 0x0c
+ *              Number::Binary(register_value, 8)   -> 0b00001100
+ *              Number::Fixed(temperature, 2)       -> 21.50
+ *          Serial_line::Send accepts all of them
+ */
+namespace Number {
+    /**
+     * @brief   Size of buffer which fits every formatted value except floats with huge exponent in fixed notation,
+     *              those are formatted in scientific notation
+     */
+    inline constexpr size_t max_length = 72;
+
+    /**
+     * @brief   Integer in binary or hexadecimal format with prefix, padded by zeros to minimal number of digits
+     */
+    template <typename T>
+    struct Based {
+        T value;
+        uint8_t base;
+        uint8_t width;
+    };
+
+    /**
+     * @brief   Float with given number of decimal places
+     */
+    template <typename T>
+    struct Fixed_point {
+        T value;
+        uint8_t precision;
+    };
+
+    template <typename T>
+    constexpr Based<T> Hex(T value, uint8_t width = 0){ return {value, 16, width}; };
+
+    template <typename T>
+    constexpr Based<T> Binary(T value, uint8_t width = 0){ return {value, 2, width}; };
+
+    template <typename T>
+    constexpr Fixed_point<T> Fixed(T value, uint8_t precision){ return {value, precision}; };
+
+    /**
+     * @brief   Format float with given number of decimal places,
+     *              scientific notation is used if fixed notation does not fit into buffer
+     *
+     * @return size_t   Number of written characters, 0 if value does not fit
+     */
+    template <typename T>
+    size_t Format(char *buffer, size_t capacity, Fixed_point<T> number){
+        auto result = std::to_chars(buffer, buffer + capacity, number.value, std::chars_format::fixed, number.precision);
+        if (result.ec != std::errc()) {
+            result = std::to_chars(buffer, buffer + capacity, number.value, std::chars_format::scientific, number.precision);
+        }
+        return result.ec == std::errc() ? result.ptr - buffer : 0;
+    }
+
+    /**
+     * @brief   Format integer with prefix 0x or 0b, sign is placed before prefix
+     *
+     * @return size_t   Number of written characters, 0 if value does not fit
+     */
+    template <typename T>
+    size_t Format(char *buffer, size_t capacity, Based<T> number){
+        static_assert(std::is_integral_v<T>, "Only integers can be formatted in binary or hexadecimal");
+        char digits[8 * sizeof(T)];
+        using Unsigned = std::make_unsigned_t<T>;
+        Unsigned magnitude = static_cast<Unsigned>(number.value);
+        bool negative = false;
+        if constexpr (std::is_signed_v<T>) {
+            if (number.value < 0) {
+                negative = true;
+                magnitude = static_cast<Unsigned>(0) - magnitude;
+            }
+        }
+        size_t length = std::to_chars(digits, digits + sizeof(digits), magnitude, number.base).ptr - digits;
+        size_t padding = number.width > length ? number.width - length : 0;
+        size_t total = negative + 2 + padding + length;
+        if (total > capacity) {
+            return 0;
+        }
+        char *position = buffer;
+        if (negative) {
+            *position++ = '-';
+        }
+        *position++ = '0';
+        *position++ = number.base == 16 ? 'x' : 'b';
+        std::memset(position, '0', padding);
+        std::memcpy(position + padding, digits, length);
+        return total;
+    }
+
+    /**
+     * @brief   Format integer as decimal number and float in fixed notation with HALUP_FLOAT_PRECISION decimal places
+     *
+     * @return size_t   Number of written characters, 0 if value does not fit
+     */
+    template <typename T>
+    size_t Format(char *buffer, size_t capacity, T value){
+        static_assert(std::is_arithmetic_v<T>, "Only numbers can be formatted");
+        if constexpr (std::is_same_v<T, bool>) {
+            return Format(buffer, capacity, static_cast<int>(value));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return Format(buffer, capacity, Fixed(value, HALUP_FLOAT_PRECISION));
+        } else {
+            auto result = std::to_chars(buffer, buffer + capacity, value);
+            return result.ec == std::errc() ? result.ptr - buffer : 0;
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#include "probe.hpp"
+
+#include <charconv>
+
+#include "uart/serial_line.hpp"
+
+#if defined(MCU_FAMILY_HOST)
+#include <chrono>
+
+uint64_t Probe::Host_now(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+void Probe::Init(){
+#if !defined(MCU_FAMILY_HOST) && defined(DWT)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+const char *Probe::Unit(){
+#if defined(MCU_FAMILY_HOST)
+    return "ns";
+#elif defined(DWT)
+    return "cycles";
+#else
+    return "ms";
+#endif
+}
+
+uint32_t Probe::Frequency(){
+#if defined(MCU_FAMILY_HOST)
+    return 1000000000;
+#elif defined(DWT)
+    return SystemCoreClock;
+#else
+    return 1000;
+#endif
+}
+
+void Probe::Register(Site &site){
+    site.registered = true;
+    if (site_count < HALUP_PROBE_SITES) {
+        sites[site_count++] = &site;
+    }
+}
+
+void Probe::Reset(){
+    for (uint8_t i = 0; i < site_count; i++) {
+        Site &site = *sites[i];
+        site.count = 0;
+        site.min = UINT32_MAX;
+        site.max = 0;
+        site.total = 0;
+        for (auto &bucket : site.histogram) {
+            bucket = 0;
+        }
+    }
+}
+
+namespace {
+    /**
+     * @brief   Append number to text
+     */
+    void Append(Serial_line::Text &text, uint64_t value){
+        char digits[20];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        text.append(digits, result.ptr - digits);
+    }
+}
+
+void Probe::Dump(Serial_line &line){
+    Serial_line::Text text;
+    text.reserve(96);
+    text = "probe count min mean max [";
+    text += Unit();
+    text += "]\r\n";
+    line.Send(text);
+
+    for (uint8_t i = 0; i < site_count; i++) {
+        const Site &site = *sites[i];
+        text = site.name;
+        text += ' ';
+        Append(text, site.count);
+        text += ' ';
+        Append(text, site.count ? site.min : 0);
+        text += ' ';
+        Append(text, site.Mean());
+        text += ' ';
+        Append(text, site.max);
+        text += "\r\n";
+        // Histogram as pairs lower_bound:count of nonempty buckets
+        text += "  ";
+        for (uint8_t bucket = 0; bucket < buckets; bucket++) {
+            if (site.histogram[bucket] == 0) {
+                continue;
+            }
+            Append(text, bucket ? (1ULL << bucket) : 0);
+            text += ':';
+            Append(text, site.histogram[bucket]);
+            text += ' ';
+        }
+        text += "\r\n";
+        line.Send(text);
+    }
+}
@@ -0,0 +1,194 @@
+/**
+ * @file probe.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "global_includes.hpp"
+
+/**
+ * @brief   Enables latency probes, when 0 all probes are removed at compile time
+ */
+#ifndef HALUP_PROBES
+#define HALUP_PROBES 0
+#endif
+
+/**
+ * @brief   Maximal number of probe sites which are reported by Probe::Dump
+ */
+#ifndef HALUP_PROBE_SITES
+#define HALUP_PROBE_SITES 16
+#endif
+
+#if HALUP_PROBES
+#define HALUP_PROBE_CONCAT_(a, b) a##b
+#define HALUP_PROBE_CONCAT(a, b)  HALUP_PROBE_CONCAT_(a, b)
+
+/**
+ * @brief   Measure duration from this point to the end of enclosing scope
+ *          Example: HALUP_PROBE("i2c.transmit");
+ */
+#define HALUP_PROBE(name)                                                                   \
+    static Probe::Site HALUP_PROBE_CONCAT(halup_probe_site_, __LINE__){name};               \
+    Probe::Scope HALUP_PROBE_CONCAT(halup_probe_scope_, __LINE__){HALUP_PROBE_CONCAT(halup_probe_site_, __LINE__)}
+
+/**
+ * @brief   Measure duration of expression, value of expression is returned
+ *          Example: auto temperature = HALUP_PROBE_CALL("tmp117.temperature", sensor.Temperature());
+ */
+#define HALUP_PROBE_CALL(name, expression) \
+    ([&]() -> decltype(auto) { HALUP_PROBE(name); return (expression); }())
+#else
+#define HALUP_PROBE(name)                  static_cast<void>(0)
+#define HALUP_PROBE_CALL(name, expression) (expression)
+#endif
+
+class Serial_line;
+
+/**
+ * @brief   Latency instrumentation of call sites
+ *          Time is measured by cycle counter DWT CYCCNT on Cortex-M3/M4/M7, by HAL_GetTick on cores without DWT
+ *              and by std::chrono in ns on host (MCU_FAMILY_HOST)
+ *          Every site accumulates count, min, max, total and log2 histogram in static storage,
+ *              probe costs two reads of counter and update of few words
+ *          Statistics of one site are not protected against preemption, site should not be shared by IRQ and main loop
+ */
+class Probe {
+public:
+    /**
+     * @brief   Number of buckets of histogram, bucket i contains durations in range <2^i, 2^(i+1))
+     */
+    static constexpr uint8_t buckets = 32;
+
+    /**
+     * @brief   Statistics of one call site, static object is created by macro HALUP_PROBE
+     */
+    struct Site {
+        const char *name;
+        uint32_t count = 0;
+        uint32_t min = UINT32_MAX;
+        uint32_t max = 0;
+        uint64_t total = 0;
+        uint32_t histogram[buckets] = {};
+        bool registered = false;
+
+        constexpr Site(const char *name) :
+            name(name)
+        { }
+
+        /**
+         * @brief   Add measured duration to statistics
+         */
+        void Record(uint32_t duration){
+            if (not registered) {
+                Probe::Register(*this);
+            }
+            count++;
+            total += duration;
+            min = (duration < min) ? duration : min;
+            max = (duration > max) ? duration : max;
+            histogram[duration ? 31 - __builtin_clz(duration) : 0]++;
+        }
+
+        /**
+         * @brief   Return mean duration
+         */
+        uint32_t Mean() const { return count ? total / count : 0; };
+    };
+
+    /**
+     * @brief   Scoped measurement, duration from construction to destruction is recorded into site
+     */
+    class Scope {
+    private:
+        Site &site;
+        uint32_t start;
+
+    public:
+        Scope(Site &site) :
+            site(site), start(Probe::Now())
+        { }
+
+        ~Scope(){
+            site.Record(Probe::Now() - start);
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+    };
+
+private:
+    /**
+     * @brief   Sites which were hit at least once
+     */
+    static inline Site *sites[HALUP_PROBE_SITES] = {};
+    static inline uint8_t site_count = 0;
+
+public:
+    /**
+     * @brief   Enable cycle counter, must be called once before first measurement on target
+     */
+    static void Init();
+
+    /**
+     * @brief   Return actual value of counter
+     *
+     * @return uint32_t Cycles on target with DWT, ms on target without DWT, ns on host
+     */
+    static inline uint32_t Now(){
+#if defined(MCU_FAMILY_HOST)
+        return static_cast<uint32_t>(Host_now());
+#elif defined(DWT)
+        return DWT->CYCCNT;
+#else
+        return HAL_GetTick();
+#endif
+    }
+
+    /**
+     * @brief   Return name of unit of durations
+     */
+    static const char *Unit();
+
+    /**
+     * @brief   Return frequency of counter in Hz
+     */
+    static uint32_t Frequency();
+
+    /**
+     * @brief   Store site into list of reported sites, called by site at first record
+     */
+    static void Register(Site &site);
+
+    /**
+     * @brief   Return number of registered sites
+     */
+    static uint8_t Count(){ return site_count; };
+
+    /**
+     * @brief   Return registered site
+     */
+    static const Site &Get(uint8_t index){ return *sites[index]; };
+
+    /**
+     * @brief   Clear statistics of all sites
+     */
+    static void Reset();
+
+    /**
+     * @brief   Print statistics and nonempty buckets of histograms of all sites to serial line
+     *
+     * @param line  Serial line to which are statistics printed
+     */
+    static void Dump(Serial_line &line);
+
+#if defined(MCU_FAMILY_HOST)
+private:
+    static uint64_t Host_now();
+#endif
+};
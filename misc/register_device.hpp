@@ -0,0 +1,44 @@
+/**
+ * @file register_device.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "misc/no_heap.hpp"
+
+/**
+ * @brief   Device with addressable registers independent of bus (I2C, SPI)
+ *          Register address is transmitted before data, big endian, device increments address during transfer
+ *          Drivers and Register_map access registers only through this interface,
+ *              so same driver works over any bus which implements it
+ */
+class Register_device {
+public:
+    virtual ~Register_device() = default;
+
+    /**
+     * @brief   Read registers of device starting at address
+     *
+     * @param address       Address of first register
+     * @param address_size  Size of register address in bytes (1 or 2)
+     * @param length        Number of bytes to read
+     * @return std::optional<Byte_vector>  Received data, empty if transfer failed
+     */
+    virtual std::optional<Byte_vector> Read_registers(uint16_t address, uint8_t address_size, unsigned int length) = 0;
+
+    /**
+     * @brief   Write registers of device starting at address
+     *
+     * @param address       Address of first register
+     * @param address_size  Size of register address in bytes (1 or 2)
+     * @param data          Data to write
+     * @return true         Data were transmitted successfully
+     */
+    virtual bool Write_registers(uint16_t address, uint8_t address_size, const Byte_vector &data) = 0;
+};
@@ -0,0 +1,164 @@
+/**
+ * @file static_string.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+/**
+ * @brief   String with capacity fixed at compile time, characters are stored inside object and terminated by null
+ *          Interface is subset of std::string, so it can replace string in no-heap build (HALUP_NO_HEAP)
+ *          Operations which would exceed capacity are truncated
+ *
+ * @tparam N    Maximal number of characters without terminating null
+ */
+template <size_t N>
+class Static_string {
+public:
+    using value_type = char;
+    using size_type = size_t;
+    using iterator = char *;
+    using const_iterator = const char *;
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+private:
+    char text[N + 1] = {};
+    size_t count = 0;
+
+public:
+    Static_string() = default;
+
+    Static_string(const char *input){ append(input, std::strlen(input)); };
+
+    Static_string(const char *input, size_t length){ append(input, length); };
+
+    Static_string(size_t length, char character){ resize(length, character); };
+
+    explicit Static_string(std::string_view input){ append(input.data(), input.size()); };
+
+    size_t size() const { return count; };
+
+    size_t length() const { return count; };
+
+    static constexpr size_t capacity(){ return N; };
+
+    static constexpr size_t max_size(){ return N; };
+
+    bool empty() const { return count == 0; };
+
+    char *data(){ return text; };
+    const char *data() const { return text; };
+    const char *c_str() const { return text; };
+
+    iterator begin(){ return text; };
+    iterator end(){ return text + count; };
+    const_iterator begin() const { return text; };
+    const_iterator end() const { return text + count; };
+
+    char &operator[](size_t index){ return text[index]; };
+    const char &operator[](size_t index) const { return text[index]; };
+
+    char &front(){ return text[0]; };
+    char &back(){ return text[count - 1]; };
+
+    operator std::string_view() const { return {text, count}; };
+
+    void reserve(size_t){ };
+
+    void clear(){
+        count = 0;
+        text[0] = '\0';
+    }
+
+    void resize(size_t length, char character = '\0'){
+        length = std::min(length, N);
+        for (size_t i = count; i < length; i++) {
+            text[i] = character;
+        }
+        count = length;
+        text[count] = '\0';
+    }
+
+    /**
+     * @brief   Append characters, characters which do not fit are dropped
+     */
+    Static_string &append(const char *input, size_t length){
+        length = std::min(length, N - count);
+        std::memcpy(text + count, input, length);
+        count += length;
+        text[count] = '\0';
+        return *this;
+    }
+
+    Static_string &append(std::string_view input){ return append(input.data(), input.size()); };
+
+    Static_string &append(size_t length, char character){
+        resize(count + length, character);
+        return *this;
+    }
+
+    void push_back(char character){ append(&character, 1); };
+
+    void pop_back(){
+        if (count > 0) {
+            text[--count] = '\0';
+        }
+    }
+
+    Static_string &operator+=(char character){
+        push_back(character);
+        return *this;
+    }
+
+    Static_string &operator+=(std::string_view input){ return append(input); };
+
+    Static_string &operator+=(const char *input){ return append(input, std::strlen(input)); };
+
+    /**
+     * @brief   Return copy of part of string
+     */
+    Static_string substr(size_t position, size_t length = npos) const {
+        position = std::min(position, count);
+        return Static_string(text + position, std::min(length, count - position));
+    }
+
+    /**
+     * @brief   Remove characters from position, rest of string is moved to position
+     */
+    Static_string &erase(size_t position = 0, size_t length = npos){
+        position = std::min(position, count);
+        length = std::min(length, count - position);
+        std::memmove(text + position, text + position + length, count - position - length);
+        count -= length;
+        text[count] = '\0';
+        return *this;
+    }
+
+    size_t find(std::string_view input, size_t position = 0) const {
+        return std::string_view(*this).find(input, position);
+    }
+
+    size_t find(char character, size_t position = 0) const {
+        return std::string_view(*this).find(character, position);
+    }
+
+    bool operator==(std::string_view other) const { return std::string_view(*this) == other; };
+
+    bool operator!=(std::string_view other) const { return std::string_view(*this) != other; };
+
+    bool operator==(const Static_string &other) const { return std::string_view(*this) == std::string_view(other); };
+
+    bool operator!=(const Static_string &other) const { return !(*this == other); };
+
+    bool operator==(const char *other) const { return std::string_view(*this) == other; };
+
+    bool operator!=(const char *other) const { return std::string_view(*this) != other; };
+};
@@ -0,0 +1,174 @@
+/**
+ * @file static_vector.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+/**
+ * @brief   Vector with capacity fixed at compile time, elements are stored inside object
+ *          Interface is subset of std::vector, so it can replace vector in no-heap build (HALUP_NO_HEAP)
+ *          Operations which would exceed capacity are truncated, elements which do not fit are dropped
+ *          Storage is array of T, so all N elements are default constructed, intended for small trivial types
+ *
+ * @tparam T    Type of element
+ * @tparam N    Maximal number of elements
+ */
+template <typename T, size_t N>
+class Static_vector {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+private:
+    T items[N] = {};
+    size_t count = 0;
+
+public:
+    Static_vector() = default;
+
+    explicit Static_vector(size_t size){ resize(size); };
+
+    Static_vector(size_t size, const T &value){ assign(size, value); };
+
+    Static_vector(std::initializer_list<T> list){ assign(list.begin(), list.end()); };
+
+    template <typename Iterator, typename = decltype(*std::declval<Iterator>())>
+    Static_vector(Iterator first, Iterator last){ assign(first, last); };
+
+    size_t size() const { return count; };
+
+    static constexpr size_t capacity(){ return N; };
+
+    static constexpr size_t max_size(){ return N; };
+
+    bool empty() const { return count == 0; };
+
+    /**
+     * @brief   Return true if no more element can be added
+     */
+    bool full() const { return count == N; };
+
+    T *data(){ return items; };
+    const T *data() const { return items; };
+
+    iterator begin(){ return items; };
+    iterator end(){ return items + count; };
+    const_iterator begin() const { return items; };
+    const_iterator end() const { return items + count; };
+    const_iterator cbegin() const { return items; };
+    const_iterator cend() const { return items + count; };
+
+    T &operator[](size_t index){ return items[index]; };
+    const T &operator[](size_t index) const { return items[index]; };
+
+    T &front(){ return items[0]; };
+    const T &front() const { return items[0]; };
+    T &back(){ return items[count - 1]; };
+    const T &back() const { return items[count - 1]; };
+
+    void clear(){ count = 0; };
+
+    void reserve(size_t){ };
+
+    /**
+     * @brief   Change number of elements, new elements are value initialized, size is limited by capacity
+     */
+    void resize(size_t size, const T &value = T()){
+        size = std::min(size, N);
+        for (size_t i = count; i < size; i++) {
+            items[i] = value;
+        }
+        count = size;
+    }
+
+    void assign(size_t size, const T &value){
+        count = 0;
+        resize(size, value);
+    }
+
+    template <typename Iterator>
+    void assign(Iterator first, Iterator last){
+        count = 0;
+        for (; first != last && count < N; ++first) {
+            items[count++] = *first;
+        }
+    }
+
+    /**
+     * @brief   Append element
+     *
+     * @return false    Vector is full, element was dropped
+     */
+    bool push_back(const T &value){
+        if (count == N) {
+            return false;
+        }
+        items[count++] = value;
+        return true;
+    }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args){
+        if (count < N) {
+            items[count++] = T(std::forward<Args>(args)...);
+        }
+        return back();
+    }
+
+    void pop_back(){
+        if (count > 0) {
+            count--;
+        }
+    }
+
+    /**
+     * @brief   Insert range before position, elements which do not fit are dropped from end
+     */
+    template <typename Iterator, typename = decltype(*std::declval<Iterator>())>
+    iterator insert(const_iterator position, Iterator first, Iterator last){
+        size_t index = position - items;
+        size_t length = std::min<size_t>(std::distance(first, last), N - index);
+        size_t moved = std::min(count - index, N - index - length);
+        std::move_backward(items + index, items + index + moved, items + index + length + moved);
+        for (size_t i = 0; i < length; ++i, ++first) {
+            items[index + i] = *first;
+        }
+        count = index + length + moved;
+        return items + index;
+    }
+
+    iterator insert(const_iterator position, const T &value){
+        return insert(position, &value, &value + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last){
+        size_t index = first - items;
+        size_t length = last - first;
+        std::move(items + index + length, items + count, items + index);
+        count -= length;
+        return items + index;
+    }
+
+    iterator erase(const_iterator position){
+        return erase(position, position + 1);
+    }
+
+    bool operator==(const Static_vector &other) const {
+        return std::equal(begin(), end(), other.begin(), other.end());
+    }
+
+    bool operator!=(const Static_vector &other) const { return !(*this == other); };
+};
@@ -1,10 +1,11 @@
 #include "ST25DV0xK.hpp"
 #include <cstdint>
-#include <vector>
+
+#include "misc/number_format.hpp"
 
 ST25DV0xK::ST25DV0xK(I2C_master master, unsigned char address, Pin * lpd_gpio, uint8_t memory_size):
     I2C_device(master, address),
-    user_memory(new I2C_EEPROM(master, 0xa6, 0x2000)),
+    user_memory(master, 0xa6, 0x2000),
     lpd_gpio(lpd_gpio),
     memory_size(memory_size)
 {
@@ -19,12 +20,12 @@ std::optional<uint8_t> ST25DV0xK::Read_register(Registers_system register_name){
 }
 
 uint8_t ST25DV0xK::Write_register(Registers_system register_name, uint8_t value){
-    auto data = vector<uint8_t>{value};
+    auto data = Byte_vector{value};
     return Write<uint16_t>(static_cast<uint16_t>(register_name), data);
 }
 
 std::optional<uint8_t> ST25DV0xK::Read_register(Registers_dynamic register_name){
-    auto register_data = user_memory->Read<uint16_t>(static_cast<uint16_t>(register_name),1);
+    auto register_data = user_memory.Read<uint16_t>(static_cast<uint16_t>(register_name),1);
     if(not register_data.has_value()){
         return {};
     }
@@ -32,21 +33,21 @@ std::optional<uint8_t> ST25DV0xK::Read_register(Registers_dynamic register_name)
 }
 
 uint8_t ST25DV0xK::Write_register(Registers_dynamic register_name, uint8_t value){
-    auto data = vector<uint8_t>{value};
+    auto data = Byte_vector{value};
     uint16_t address = static_cast<uint16_t>(register_name);
-    return user_memory->Write<uint16_t>(address, data);
+    return user_memory.Write<uint16_t>(address, data);
 }
 
-uint8_t ST25DV0xK::Write_memory(uint16_t address, std::vector<uint8_t> &data){
-    return user_memory->Write<uint16_t>(address, data);
+uint8_t ST25DV0xK::Write_memory(uint16_t address, Byte_vector &data){
+    return user_memory.Write<uint16_t>(address, data);
 }
 
-std::optional<std::vector<uint8_t>> ST25DV0xK::Read_memory(uint16_t address, uint16_t length){
-    return user_memory->Read<uint16_t>(address, length);
+std::optional<Byte_vector> ST25DV0xK::Read_memory(uint16_t address, uint16_t length){
+    return user_memory.Read<uint16_t>(address, length);
 }
 
 std::optional<uint8_t> ST25DV0xK::ID(){
-    return Read_register(Registers_system::MANUF_CODE);
+    return Register_map::Read<Map::MANUF_CODE>(*this);
 }
 
 void ST25DV0xK::Low_power(ST25DV0xK::State state){
@@ -58,16 +59,16 @@ void ST25DV0xK::Low_power(ST25DV0xK::State state){
 }
 
 std::optional<bool> ST25DV0xK::Locked_state(){
-    auto register_data = Read_register(Registers_dynamic::I2C_SSO);
-    if (register_data) {
-        return !(register_data.value());
+    auto session_open = Register_map::Read_field<Map::I2C_SSO>(user_memory);
+    if (session_open) {
+        return !(session_open.value());
     } else {
         return {};
     }
 }
 
 bool ST25DV0xK::Present_password(uint64_t password){
-    std::vector<uint8_t> password_present_command(19);
+    Byte_vector password_present_command(19);
     password_present_command[0] = (static_cast<uint16_t>(Registers_system::I2C_PWD) & 0xff00) >> 8;
     password_present_command[1] = (static_cast<uint16_t>(Registers_system::I2C_PWD) & 0x00ff);
     for(int i = 0; i < 8; i++){ // Copy password
@@ -83,40 +84,33 @@ bool ST25DV0xK::Present_password(uint64_t password){
 }
 
 bool ST25DV0xK::RF_control(ST25DV0xK::State state){
-    uint8_t reg_value = 0x0;
-    if (state == ST25DV0xK::State::On) {
-        reg_value = 0x00;
-    } else if (state == ST25DV0xK::State::Off) {
-        reg_value = 0x03;
-    }
-    return Write_register(Registers_dynamic::RF_MNGT, reg_value);
+    uint8_t rf_off = (state == ST25DV0xK::State::On) ? 0b00 : 0b11;
+    return Register_map::Write<Map::RF_MNGT_DYN>(user_memory, Map::RF_OFF::Insert(0x00, rf_off));
 }
 
 std::optional<ST25DV0xK::State> ST25DV0xK::RF_control(){
-    auto RF_state_register = Read_register(Registers_dynamic::RF_MNGT);
-    if (RF_state_register.has_value()) {
-        if ((RF_state_register.value() & 0x03) == 0x00) {
-            return ST25DV0xK::State::On;
-        } else if ((RF_state_register.value() & 0x03) != 0x00){
-            return ST25DV0xK::State::Off;
-        }
+    auto rf_off = Register_map::Read_field<Map::RF_OFF>(user_memory);
+    if (rf_off.has_value()) {
+        return (rf_off.value() == 0) ? ST25DV0xK::State::On : ST25DV0xK::State::Off;
     }
     return {};
 }
 
-std::string ST25DV0xK::Format_register(ST25DV0xK::Registers_system register_name){
+ST25DV0xK::Register_text ST25DV0xK::Format_register(ST25DV0xK::Registers_system register_name){
     auto register_data = Read<uint16_t>(static_cast<uint16_t>(register_name),1);
     if(not register_data.has_value()){
         return "";
     }
-    return emio::format("0b{:08b}",register_data.value()[0]);
+    char text[register_text_size];
+    return Register_text(text, Number::Format(text, sizeof(text), Number::Binary(register_data.value()[0], 8)));
 }
 
-std::string ST25DV0xK::Format_register(ST25DV0xK::Registers_dynamic register_name){
+ST25DV0xK::Register_text ST25DV0xK::Format_register(ST25DV0xK::Registers_dynamic register_name){
     //auto register_data = Read<uint16_t>(static_cast<uint16_t>(register_name),1);
-    auto register_data = user_memory->Read<uint16_t>(static_cast<uint16_t>(register_name),1);
+    auto register_data = user_memory.Read<uint16_t>(static_cast<uint16_t>(register_name),1);
     if(not register_data.has_value()){
         return "";
     }
-    return emio::format("0b{:08b}",register_data.value()[0]);
+    char text[register_text_size];
+    return Register_text(text, Number::Format(text, sizeof(text), Number::Binary(register_data.value()[0], 8)));
 }
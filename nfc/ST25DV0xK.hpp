@@ -7,14 +7,14 @@
 #pragma once
 
 #include "i2c/i2c_device.hpp"
+#include "i2c/register_map.hpp"
 #include "memory/eeprom/i2c_eeprom.hpp"
 #include "gpio/pin.hpp"
 
-#include "emio/emio.hpp"
+#include "misc/no_heap.hpp"
 
-#include <vector>
 #include <optional>
-#include <map>
+#include <utility>
 
 /**
  * @brief   ST25DV0xK: Dynamic NFC/RFID tag IC with 4-64 Kbit EEPROM
@@ -28,7 +28,10 @@
 class ST25DV0xK : public I2C_device{
 private:
 
-    I2C_EEPROM *const user_memory;
+    /**
+     * @brief   User memory and dynamic registers, accessed at second address of device
+     */
+    I2C_EEPROM user_memory;
 
     /**
      * @brief   Pin which is used to control low power mode of NFC
@@ -51,7 +54,7 @@ private:
      * @brief Mapping of value in register MEM_SIZE to real memory size in kb
      *          Value of MEM_SIZE is expressed as amount of RF blocks (4bytes)
      */
-    const std::map<uint16_t, uint8_t> memory_size_map = {
+    static constexpr std::pair<uint16_t, uint8_t> memory_size_map[] = {
         {0x007F, 4},
         {0x01ff, 16},
         {0x07ff, 64}
@@ -102,6 +105,30 @@ public:
         MB_LEN      = 0x2007
     };
 
+private:
+    /**
+     * @brief 8-bit registers addressed by 16-bit address, multibyte values are little-endian
+     */
+    using Layout = Register_map::Layout<uint16_t, uint8_t, Register_map::Endian::Little>;
+
+public:
+    /**
+     * @brief Register map of IC, system registers are accessed at system address of device,
+     *          dynamic registers at address of user memory
+     */
+    struct Map {
+        using MEM_SIZE      = Register_map::Register<Layout, Registers_system::MEM_SIZE, Register_map::Access::Read_only, uint16_t>;
+        using BLK_SIZE      = Register_map::Register<Layout, Registers_system::BLK_SIZE, Register_map::Access::Read_only>;
+        using IC_REF        = Register_map::Register<Layout, Registers_system::IC_REF, Register_map::Access::Read_only>;
+        using MANUF_CODE    = Register_map::Register<Layout, Registers_system::MANUF_CODE, Register_map::Access::Read_only>;
+        using IC_REV        = Register_map::Register<Layout, Registers_system::IC_REV, Register_map::Access::Read_only>;
+        using RF_MNGT_DYN   = Register_map::Register<Layout, Registers_dynamic::RF_MNGT>;
+        using I2C_SSO_DYN   = Register_map::Register<Layout, Registers_dynamic::I2C_SSO, Register_map::Access::Read_only>;
+
+        using RF_OFF        = Register_map::Field<RF_MNGT_DYN, 0x03>;     // RF_DISABLE and RF_SLEEP
+        using I2C_SSO       = Register_map::Field<I2C_SSO_DYN, 0x01, bool>;
+    };
+
     enum class State: bool{
         Off  = false,
         On   = true
@@ -155,16 +182,16 @@ public:
      * @param data      Data to write into memory
      * @return uint8_t  Number of bytes written
      */
-    uint8_t Write_memory(uint16_t address, std::vector<uint8_t> &data);
+    uint8_t Write_memory(uint16_t address, Byte_vector &data);
 
     /**
      * @brief Read data from EEPROM memory of NFC
      *
      * @param address   Address of first byte in memory
      * @param length    Number of bytes to read
-     * @return std::optional<std::vector<uint8_t>>  Data read from memory if read from device was successful, otherwise empty optional
+     * @return std::optional<Byte_vector>  Data read from memory if read from device was successful, otherwise empty optional
      */
-    std::optional<std::vector<uint8_t>> Read_memory(uint16_t address, uint16_t length);
+    std::optional<Byte_vector> Read_memory(uint16_t address, uint16_t length);
 
     /**
      * @brief Read ID of device
@@ -213,21 +240,27 @@ public:
      */
     std::optional<State> RF_control();
 
+    /**
+     * @brief Binary representation of register, 0b followed by 8 digits
+     */
+    static constexpr size_t register_text_size = 10;
+    using Register_text = Bounded_string<register_text_size>;
+
     /**
      * @brief Format given system register value into binary representation
      *
      * @param register_name Name of register to format
-     * @return std::string  Formatted string of register value
+     * @return Register_text    Formatted string of register value, empty if read failed
      */
-    std::string Format_register(Registers_system register_name);
+    Register_text Format_register(Registers_system register_name);
 
     /**
      * @brief Format given dynamic register value into binary representation
      *
      * @param register_name Name of register to format
-     * @return std::string  Formatted string of register value
+     * @return Register_text    Formatted string of register value, empty if read failed
      */
-    std::string Format_register(Registers_dynamic register_name);
+    Register_text Format_register(Registers_dynamic register_name);
 
     /**
      * @brief   Return size of memory in kb
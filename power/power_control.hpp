@@ -0,0 +1,50 @@
+/**
+ * @file power_control.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+/**
+ * @brief   Interface to power modes of MCU and to clock which runs in all power modes
+ *          Implemented by STM32_power on target and by Simulated_power on host
+ */
+class Power_control {
+public:
+    /**
+     * @brief   Power states ordered from shallowest to deepest
+     */
+    enum class State: uint8_t {
+        Run   = 0,  // CPU is running
+        Sleep = 1,  // CPU is stopped, peripherals are clocked
+        Stop  = 2,  // All clocks except LSE/LSI are stopped, RAM is retained
+    };
+
+    /**
+     * @brief   Number of power states
+     */
+    static constexpr uint8_t states = 3;
+
+    virtual ~Power_control() = default;
+
+    /**
+     * @brief   Monotonic time which continues in all power states
+     *
+     * @return uint64_t Time in microseconds
+     */
+    virtual uint64_t Now() = 0;
+
+    /**
+     * @brief   Enter low power state, returns after wake up by interrupt or deadline
+     *          Is called with interrupts disabled, pending interrupt must wake MCU immediately
+     *
+     * @param state     Sleep or Stop
+     * @param deadline  Time of wake up by RTC in microseconds, empty if no wake up is scheduled
+     */
+    virtual void Enter(State state, std::optional<uint64_t> deadline) = 0;
+};
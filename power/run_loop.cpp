@@ -0,0 +1,116 @@
+#include "run_loop.hpp"
+
+#include "misc/critical_section.hpp"
+
+Run_loop::Run_loop(Power_control &power, RTC_timer_wheel *wheel) :
+    power(&power), wheel(wheel)
+{ }
+
+bool Run_loop::Register(Invocation_wrapper_base<bool, void> *task){
+    if (task == nullptr || task_count >= HALUP_RUN_LOOP_TASKS) {
+        return false;
+    }
+    tasks[task_count++] = task;
+    return true;
+}
+
+void Run_loop::Lock(State state){
+    Critical_section section;
+    locks[static_cast<uint8_t>(state)] = locks[static_cast<uint8_t>(state)] + 1;
+}
+
+void Run_loop::Unlock(State state){
+    Critical_section section;
+    if (locks[static_cast<uint8_t>(state)] > 0) {
+        locks[static_cast<uint8_t>(state)] = locks[static_cast<uint8_t>(state)] - 1;
+    }
+}
+
+bool Run_loop::Iterate(){
+    bool busy = false;
+    woken = false;
+
+    std::optional<uint64_t> deadline;
+    if (wheel) {
+        auto next = wheel->Next_expiry();
+        if (wheel->Pending() || (next.has_value() && next.value() * 1000 <= power->Now())) {
+            busy |= wheel->Dispatch() > 0;
+            next = wheel->Next_expiry();
+        }
+        if (next.has_value()) {
+            deadline = next.value() * 1000;
+        }
+    }
+    for (uint8_t i = 0; i < task_count; i++) {
+        busy |= tasks[i]->Invoke();
+    }
+    if (busy || locks[static_cast<uint8_t>(State::Sleep)] > 0) {
+        return busy;
+    }
+
+    uint64_t start = power->Now();
+    if (not accounting) {
+        last_timestamp = start;
+        accounting = true;
+    }
+    if (deadline.has_value() && deadline.value() <= start) {
+        return false;
+    }
+
+    State state = State::Stop;
+    if (locks[static_cast<uint8_t>(State::Stop)] > 0 || (deadline.has_value() && deadline.value() - start < stop_threshold)) {
+        state = State::Sleep;
+    }
+
+    statistics.time[static_cast<uint8_t>(State::Run)] += start - last_timestamp;
+
+    bool entered = false;
+    {
+        Critical_section section;
+        if (not woken) {    // Interrupt which arrived after polling of tasks cancels sleep
+            power->Enter(state, deadline);
+            entered = true;
+        }
+    }
+
+    uint64_t end = power->Now();
+    if (entered) {
+        statistics.time[static_cast<uint8_t>(state)] += end - start;
+        statistics.entries[static_cast<uint8_t>(state)]++;
+        if (deadline.has_value() && end >= deadline.value()) {
+            uint64_t latency = end - deadline.value();
+            statistics.deadline_wakeups++;
+            statistics.wake_latency_total += latency;
+            if (latency > statistics.wake_latency_max) {
+                statistics.wake_latency_max = latency;
+            }
+        }
+    } else {
+        statistics.time[static_cast<uint8_t>(State::Run)] += end - start;
+    }
+    last_timestamp = end;
+    return false;
+}
+
+void Run_loop::Run(){
+    while (true) {
+        Iterate();
+    }
+}
+
+void Run_loop::Reset_statistics(){
+    statistics = Statistics();
+    last_timestamp = power->Now();
+    accounting = true;
+}
+
+float Run_loop::Duty_cycle() const{
+    uint64_t total = 0;
+    for (uint8_t i = 0; i < Power_control::states; i++) {
+        total += statistics.time[i];
+    }
+    if (total == 0) {
+        return 1.0f;
+    }
+    return static_cast<float>(statistics.time[static_cast<uint8_t>(State::Run)]) / total;
+}
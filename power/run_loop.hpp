@@ -0,0 +1,174 @@
+/**
+ * @file run_loop.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "power/power_control.hpp"
+#include "rtc/rtc_timer.hpp"
+#include "misc/invocation_wrapper.hpp"
+
+/**
+ * @brief   Maximal number of tasks polled by run loop
+ */
+#ifndef HALUP_RUN_LOOP_TASKS
+#define HALUP_RUN_LOOP_TASKS 16
+#endif
+
+/**
+ * @brief   Tickless main loop which sleeps whenever there is no work
+ *          Every iteration dispatches expired timers of RTC_timer_wheel and polls registered tasks,
+ *              if nothing was done, MCU enters deepest allowed power state until next timer expiration or interrupt
+ *          Peripherals which need clock (UART transfer, I2C DMA) lock shallower state by Lock()/Unlock()
+ *          Interrupts which produce work (EXTI of sensors, UART RX) must call Wake(),
+ *              check of wake flag and entering of sleep is done atomically, so no event is missed
+ *
+ *          Example of wiring, serial lines and RTC_timer_wheel invoke registered wake callback from their IRQ
+ *              (HAL callbacks of library enabled by HALUP_HAL_CALLBACKS, see misc/hal_callbacks.hpp), other interrupts call Wake() directly:
+ *              Invocation_wrapper<Run_loop, void, void> wake(&loop, &Run_loop::Wake);
+ *              uart.Wake_notification(&wake);
+ *              void HAL_GPIO_EXTI_Callback(uint16_t pin){ accelerometer_ready = true; loop.Wake(); }
+ */
+class Run_loop {
+public:
+    using State = Power_control::State;
+
+    /**
+     * @brief   Accounting of time spent in power states
+     */
+    struct Statistics {
+        uint64_t time[Power_control::states] = {};      // Time spent in state in us
+        uint32_t entries[Power_control::states] = {};   // Number of entries into state
+        uint64_t wake_latency_max = 0;                  // Maximal delay between deadline and resumed execution in us
+        uint64_t wake_latency_total = 0;                // Sum of delays between deadline and resumed execution in us
+        uint32_t deadline_wakeups = 0;                  // Number of wake ups by deadline
+    };
+
+private:
+    /**
+     * @brief   Control of power states and time
+     */
+    Power_control *power;
+
+    /**
+     * @brief   Timers which determine deadline of sleep, can be nullptr
+     */
+    RTC_timer_wheel *wheel;
+
+    /**
+     * @brief   Tasks polled in every iteration, task returns true if it did some work
+     */
+    Invocation_wrapper_base<bool, void> *tasks[HALUP_RUN_LOOP_TASKS] = {};
+    uint8_t task_count = 0;
+
+    /**
+     * @brief   Number of locks which prevent entering of state (and deeper states)
+     */
+    volatile uint16_t locks[Power_control::states] = {};
+
+    /**
+     * @brief   Set by interrupt, new work is available and loop must not sleep
+     */
+    volatile bool woken = false;
+
+    /**
+     * @brief   Minimal length of sleep in us for which is used Stop state, shorter sleeps use Sleep state
+     */
+    uint32_t stop_threshold = 2000;
+
+    /**
+     * @brief   Accounting of power states
+     */
+    Statistics statistics;
+
+    /**
+     * @brief   Time of end of last accounted interval
+     */
+    uint64_t last_timestamp = 0;
+
+    /**
+     * @brief   False until first accounted interval starts
+     */
+    bool accounting = false;
+
+public:
+    /**
+     * @brief Construct a new Run_loop object
+     *
+     * @param power Control of power states
+     * @param wheel Timers which determine deadline of sleep
+     */
+    Run_loop(Power_control &power, RTC_timer_wheel *wheel = nullptr);
+
+    /**
+     * @brief   Register task polled in every iteration
+     *
+     * @param task  Task which returns true if it did some work
+     * @return true Task was registered
+     * @return false There is no space for task
+     */
+    bool Register(Invocation_wrapper_base<bool, void> *task);
+
+    /**
+     * @brief   Prevent entering of given power state and all deeper states
+     *          Lock(State::Sleep) keeps CPU running, Lock(State::Stop) allows only Sleep
+     *
+     * @param state Shallowest forbidden state
+     */
+    void Lock(State state);
+
+    /**
+     * @brief   Release lock acquired by Lock()
+     *
+     * @param state Shallowest forbidden state used in Lock()
+     */
+    void Unlock(State state);
+
+    /**
+     * @brief   Notify loop about new work, can be called from interrupt
+     */
+    void Wake(){ woken = true; };
+
+    /**
+     * @brief   Set minimal length of sleep for which is used Stop state
+     *          Should be longer than wake up time from Stop including restore of clocks
+     *
+     * @param threshold Length of sleep in us
+     */
+    void Stop_threshold(uint32_t threshold){ stop_threshold = threshold; };
+
+    /**
+     * @brief   Perform one iteration of loop: dispatch timers, poll tasks and sleep if there is no work
+     *
+     * @return true     Some work was done, loop did not sleep
+     * @return false    Loop was sleeping or could not sleep due to lock
+     */
+    bool Iterate();
+
+    /**
+     * @brief   Run loop forever
+     */
+    [[noreturn]] void Run();
+
+    /**
+     * @brief   Return accounting of time spent in power states
+     */
+    const Statistics &Stats() const { return statistics; };
+
+    /**
+     * @brief   Reset accounting of power states
+     */
+    void Reset_statistics();
+
+    /**
+     * @brief   Return ratio of time when CPU was running to total accounted time
+     *
+     * @return float    Duty cycle in range 0-1
+     */
+    float Duty_cycle() const;
+};
@@ -0,0 +1,27 @@
+#include "stm32_power.hpp"
+
+STM32_power::STM32_power(RTC_internal &rtc, Invocation_wrapper_base<void, void> *clock_restore) :
+    rtc(&rtc), clock_restore(clock_restore)
+{ }
+
+uint64_t STM32_power::Now(){
+    return rtc->Monotonic() * 1000;
+}
+
+void STM32_power::Enter(State state, std::optional<uint64_t> deadline){
+    UNUSED_VAR(deadline);   // Wake up is done by RTC alarm
+    if (state == State::Sleep) {
+        HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+    } else if (state == State::Stop) {
+        HAL_SuspendTick();
+#if defined(MCU_FAMILY_STM32_L4)
+        HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
+#else
+        HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+#endif
+        if (clock_restore) {
+            clock_restore->Invoke();
+        }
+        HAL_ResumeTick();
+    }
+}
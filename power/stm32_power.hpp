@@ -0,0 +1,45 @@
+/**
+ * @file stm32_power.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include "global_includes.hpp"
+#include "power/power_control.hpp"
+#include "rtc/rtc.hpp"
+#include "misc/invocation_wrapper.hpp"
+
+/**
+ * @brief   Power control of STM32 via HAL
+ *          Time is measured by RTC, wake up from Stop is done by RTC alarm programmed by RTC_timer_wheel
+ *          On L4 family is used STOP2 mode, other families use STOP with low power regulator
+ */
+class STM32_power : public Power_control {
+private:
+    /**
+     * @brief   RTC which measures time in all power states
+     */
+    RTC_internal *rtc;
+
+    /**
+     * @brief   Callback which restores system clock after wake up from Stop (usually SystemClock_Config)
+     *          MCU runs from MSI/HSI after Stop
+     */
+    Invocation_wrapper_base<void, void> *clock_restore;
+
+public:
+    /**
+     * @brief Construct a new STM32_power object
+     *
+     * @param rtc           Initialized RTC
+     * @param clock_restore Callback which restores system clock after Stop
+     */
+    STM32_power(RTC_internal &rtc, Invocation_wrapper_base<void, void> *clock_restore = nullptr);
+
+    uint64_t Now() override;
+
+    void Enter(State state, std::optional<uint64_t> deadline) override;
+};
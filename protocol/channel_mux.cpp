@@ -0,0 +1,164 @@
+#include "channel_mux.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "misc/critical_section.hpp"
+
+static_assert(HALUP_MUX_PAYLOAD + 1 <= HALUP_FRAME_MAX_SIZE, "Frame of channel must fit into frame of COBS_link");
+
+Channel_mux::Channel_mux(Serial_line &line, uint32_t (*timestamp_source)(), COBS_link::Checksum checksum) :
+    line(&line),
+    link(line, checksum),
+    timestamp_source(timestamp_source),
+    frame_callback(this, &Channel_mux::Demultiplex),
+    transmit_callback(this, &Channel_mux::Transmit)
+{
+    link.Register(&frame_callback);
+    line.Transmit_notification(&transmit_callback);
+}
+
+Channel_mux::~Channel_mux(){
+    line->Transmit_notification(nullptr);
+}
+
+Channel_mux::Channel *Channel_mux::Open(uint8_t id, uint8_t priority, uint8_t weight){
+    if (count >= HALUP_MUX_CHANNELS || Find(id) != nullptr) {
+        return nullptr;
+    }
+    Channel &channel = channels[count++];
+    channel.mux = this;
+    channel.id = id;
+    channel.priority = priority;
+    channel.weight = weight > 0 ? weight : 1;
+    return &channel;
+}
+
+Channel_mux::Channel *Channel_mux::Find(uint8_t id){
+    for (uint8_t i = 0; i < count; i++) {
+        if (channels[i].id == id) {
+            return &channels[i];
+        }
+    }
+    return nullptr;
+}
+
+int Channel_mux::Channel::Send(const char *data, size_t length){
+    if (length == 0) {
+        return 0;
+    }
+    size_t frames = (length + HALUP_MUX_PAYLOAD - 1) / HALUP_MUX_PAYLOAD;
+    {
+        Critical_section section;
+        // Queue is limited in both builds, otherwise burst of logs would grow latency of its channel without limit
+        if (queue.size() + frames > HALUP_MUX_QUEUE) {
+            statistics.dropped += frames;
+            return -1;
+        }
+        uint32_t now = mux->timestamp_source();
+        for (size_t offset = 0; offset < length; offset += HALUP_MUX_PAYLOAD) {
+            size_t chunk = std::min<size_t>(length - offset, HALUP_MUX_PAYLOAD);
+            queue.push_back({Bounded_string<HALUP_MUX_PAYLOAD>(data + offset, chunk), now});
+        }
+    }
+    mux->Transmit();
+    return frames;
+}
+
+Channel_mux::Channel *Channel_mux::Schedule(){
+    // Only channels of highest priority with queued frames compete for line
+    std::optional<uint8_t> level;
+    for (uint8_t i = 0; i < count; i++) {
+        if (!channels[i].queue.empty() && (!level || channels[i].priority > *level)) {
+            level = channels[i].priority;
+        }
+    }
+    if (!level) {
+        return nullptr;
+    }
+
+    // Deficit round robin, channel which gets turn receives quantum proportional to its weight
+    //  and transmits while its deficit covers size of frames, then turn passes to next channel of same priority
+    // Turn is kept by flag of channel, so channels of higher priority do not disturb round robin of lower priorities
+    uint8_t index = count;
+    for (uint8_t i = 0; i < count; i++) {
+        if (channels[i].priority == *level && (channels[i].turn || index == count)) {
+            index = i;
+            if (channels[i].turn) {
+                break;
+            }
+        }
+    }
+
+    // Terminates because deficit of channels with queued frames grows every round
+    while (true) {
+        Channel &channel = channels[index];
+        if (channel.priority == *level) {
+            if (!channel.turn) {
+                channel.turn = true;
+                channel.deficit += HALUP_MUX_QUANTUM * channel.weight;
+            }
+            if (!channel.queue.empty() && channel.queue.front().data.size() <= channel.deficit) {
+                channel.deficit -= channel.queue.front().data.size();
+                return &channel;
+            }
+            channel.turn = false;
+        }
+        index = (index + 1) % count;
+    }
+}
+
+void Channel_mux::Transmit(){
+    uint8_t frame[HALUP_MUX_PAYLOAD + 1];
+    while (true) {
+        size_t length;
+        {
+            Critical_section section;
+            // Next frame is passed after line finishes previous one, transmit notification continues
+            if (transmitting || line->Busy()) {
+                return;
+            }
+            Channel *channel = Schedule();
+            if (channel == nullptr) {
+                return;
+            }
+
+            auto &pending = channel->queue.front();
+            frame[0] = channel->id;
+            std::memcpy(frame + 1, pending.data.data(), pending.data.size());
+            length = pending.data.size() + 1;
+
+            Statistics &statistics = channel->statistics;
+            uint32_t delay = timestamp_source() - pending.queued;
+            statistics.frames_sent++;
+            statistics.bytes_sent += pending.data.size();
+            statistics.delay_last = delay;
+            statistics.delay_max = std::max(statistics.delay_max, delay);
+            statistics.delay_sum += delay;
+
+            channel->queue.erase(channel->queue.begin());
+            if (channel->queue.empty()) {
+                channel->deficit = 0;
+            }
+            transmitting = true;
+        }
+        // Encoding runs with enabled interrupts, notification which arrives meanwhile is handled by next iteration
+        link.Send(frame, length);
+        transmitting = false;
+    }
+}
+
+void Channel_mux::Demultiplex(COBS_link::Frame frame){
+    Channel *channel = frame.length > 0 ? Find(frame.data[0]) : nullptr;
+    if (channel == nullptr) {
+        unknown_frames++;
+        return;
+    }
+    channel->RX_buffer.append(reinterpret_cast<const char *>(frame.data + 1), frame.length - 1);
+    channel->statistics.frames_received++;
+    channel->Received();
+}
+
+unsigned int Channel_mux::Process(){
+    return link.Process();
+}
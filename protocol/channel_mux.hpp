@@ -0,0 +1,272 @@
+/**
+ * @file channel_mux.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "global_includes.hpp"
+#include "misc/invocation_wrapper.hpp"
+#include "misc/no_heap.hpp"
+#include "protocol/cobs_link.hpp"
+#include "uart/serial_line.hpp"
+
+/**
+ * @brief   Maximal number of channels of Channel_mux
+ */
+#ifndef HALUP_MUX_CHANNELS
+#define HALUP_MUX_CHANNELS 4
+#endif
+
+/**
+ * @brief   Maximal number of frames waiting in queue of one channel
+ */
+#ifndef HALUP_MUX_QUEUE
+#define HALUP_MUX_QUEUE 8
+#endif
+
+/**
+ * @brief   Maximal size of data in one frame of channel, longer messages are split into more frames
+ *          Frame with number of channel must fit into HALUP_FRAME_MAX_SIZE and encoded into one message of serial line
+ */
+#ifndef HALUP_MUX_PAYLOAD
+#define HALUP_MUX_PAYLOAD 240
+#endif
+
+/**
+ * @brief   Number of bytes which channel with weight 1 can transmit in one round of scheduler
+ */
+#ifndef HALUP_MUX_QUANTUM
+#define HALUP_MUX_QUANTUM 64
+#endif
+
+/**
+ * @brief   Multiplexer of several logical channels over one serial line, for example logs, telemetry and shell on one UART
+ *          Every channel is Serial_line, so Logger, Shell or COBS_link can use it instead of physical line
+ *          Frames are transferred by COBS_link, first byte of payload is number of channel
+ *          Messages wait in queue of their channel, scheduler passes next frame to line only after previous was transmitted,
+ *              so frame of urgent channel waits at most for one frame on wire instead of whole backlog of other channels
+ *          Channels with higher priority are always served first, channels with same priority share line
+ *              by deficit round robin in ratio of their weights
+ *          Received frames are demultiplexed into RX buffers of channels by Process()
+ *              Channel_mux mux(uart, HAL_GetTick);
+ *              Serial_line &telemetry = *mux.Open(1, 1);           // Priority 1, served first
+ *              Serial_line &logs = *mux.Open(2, 0, 1);             // Priority 0, weight 1
+ *              Serial_line &console = *mux.Open(3, 0, 3);          // Priority 0, three times bandwidth of logs
+ *              Logger logger(logs);
+ *              Shell shell(console);
+ */
+class Channel_mux {
+public:
+    /**
+     * @brief   Statistics of channel, delays are in units of timestamp source
+     *          Delay of frame is time from queuing by Send to passing to serial line
+     */
+    struct Statistics {
+        uint32_t frames_sent     = 0;
+        uint32_t bytes_sent      = 0;
+        uint32_t frames_received = 0;
+        uint32_t dropped         = 0;   // Frames rejected because queue was full
+        uint32_t delay_last      = 0;
+        uint32_t delay_max       = 0;
+        uint64_t delay_sum       = 0;
+
+        /**
+         * @brief   Return average delay of sent frames
+         */
+        uint32_t Delay_average() const { return frames_sent ? delay_sum / frames_sent : 0; };
+    };
+
+    /**
+     * @brief   Logical channel, messages sent to it are queued by multiplexer, RX buffer is filled by Process of multiplexer
+     */
+    class Channel : public Serial_line {
+        friend class Channel_mux;
+
+    private:
+        /**
+         * @brief   Part of message waiting for transmission
+         */
+        struct Pending {
+            Bounded_string<HALUP_MUX_PAYLOAD> data;
+            uint32_t queued;        // Timestamp of queuing
+        };
+
+        Channel_mux *mux = nullptr;
+        uint8_t id = 0;
+        uint8_t priority = 0;
+        uint8_t weight = 1;
+
+        /**
+         * @brief   Number of bytes which can be transmitted before scheduler moves to next channel of same priority
+         */
+        uint32_t deficit = 0;
+
+        /**
+         * @brief   True if channel has turn in round robin of its priority, its quantum was already added to deficit
+         */
+        bool turn = false;
+
+        Bounded_vector<Pending, HALUP_MUX_QUEUE> queue;
+
+        Statistics statistics;
+
+    public:
+        Channel() = default;
+
+        Channel(const Channel &) = delete;
+        Channel &operator=(const Channel &) = delete;
+
+        /**
+         * @brief   Queue message for transmission, message longer than HALUP_MUX_PAYLOAD is split into more frames
+         *
+         * @return int  Number of queued frames, -1 if message does not fit into queue (nothing is queued)
+         */
+        virtual int Send(Text message) override final { return Send(message.data(), message.size()); };
+
+        virtual int Send(const char *data, size_t length) override final;
+
+        using Serial_line::Send;
+
+        /**
+         * @brief   Data are received by Process of multiplexer
+         *
+         * @return int  Actual size of RX buffer
+         */
+        virtual int Receive() override final { return RX_buffer.size(); };
+
+        /**
+         * @brief   Return true if channel has frames waiting for transmission
+         */
+        virtual bool Busy() const override final { return !queue.empty(); };
+
+        /**
+         * @brief   Return number of frames waiting for transmission
+         */
+        size_t Queued() const { return queue.size(); };
+
+        /**
+         * @brief   Return number of channel
+         */
+        uint8_t ID() const { return id; };
+
+        /**
+         * @brief   Return statistics of channel
+         */
+        const Statistics &Stats() const { return statistics; };
+
+        /**
+         * @brief   Reset statistics of channel
+         */
+        void Reset_statistics(){ statistics = Statistics(); };
+    };
+
+private:
+    /**
+     * @brief   Physical line
+     */
+    Serial_line *line;
+
+    /**
+     * @brief   Framing of line, transmits frames and decodes received data
+     */
+    COBS_link link;
+
+    /**
+     * @brief   Source of timestamps for queue delay
+     */
+    uint32_t (*timestamp_source)();
+
+    Channel channels[HALUP_MUX_CHANNELS];
+    uint8_t count = 0;
+
+    /**
+     * @brief   True while frame is passed to line, prevents nested transmission from transmit notification
+     */
+    volatile bool transmitting = false;
+
+    /**
+     * @brief   Number of received frames of unknown channels
+     */
+    uint32_t unknown_frames = 0;
+
+    Invocation_wrapper<Channel_mux, void, COBS_link::Frame> frame_callback;
+
+    Invocation_wrapper<Channel_mux, void, void> transmit_callback;
+
+    /**
+     * @brief   Select channel whose frame is transmitted next, must be called in critical section
+     *
+     * @return Channel*     Channel with frame in front of queue, null if all queues are empty
+     */
+    Channel *Schedule();
+
+    /**
+     * @brief   Deliver received frame into RX buffer of its channel
+     */
+    void Demultiplex(COBS_link::Frame frame);
+
+public:
+    /**
+     * @brief Construct a new Channel_mux object
+     *
+     * @param line              Physical line, its transmit notification is used by multiplexer
+     * @param timestamp_source  Source of timestamps for delay statistics
+     * @param checksum          Checksum of frames
+     */
+    Channel_mux(Serial_line &line, uint32_t (*timestamp_source)() = HAL_GetTick, COBS_link::Checksum checksum = COBS_link::Checksum::CRC16);
+
+    ~Channel_mux();
+
+    // Channels and callbacks of line keep address of multiplexer
+    Channel_mux(const Channel_mux &) = delete;
+    Channel_mux &operator=(const Channel_mux &) = delete;
+
+    /**
+     * @brief   Open new channel
+     *
+     * @param id        Number of channel in frames, must be same on other side
+     * @param priority  Channels with higher priority are served first
+     * @param weight    Share of bandwidth among channels with same priority, at least 1
+     * @return Channel* Channel, null if all channels are used or number is already opened
+     */
+    Channel *Open(uint8_t id, uint8_t priority = 0, uint8_t weight = 1);
+
+    /**
+     * @brief   Return opened channel with given number, null if there is no such channel
+     */
+    Channel *Find(uint8_t id);
+
+    /**
+     * @brief   Pass frames to line while line is not busy
+     *          Called by Send of channels and from transmit notification of line (usually IRQ)
+     */
+    void Transmit();
+
+    /**
+     * @brief   Move received data of line into decoder and deliver complete frames to channels
+     *
+     * @return unsigned int Number of processed bytes
+     */
+    unsigned int Process();
+
+    /**
+     * @brief   Return number of opened channels
+     */
+    uint8_t Channels() const { return count; };
+
+    /**
+     * @brief   Return number of received frames of unknown channels
+     */
+    uint32_t Unknown_frames() const { return unknown_frames; };
+
+    /**
+     * @brief   Return framing layer, contains statistics of checksum and framing errors
+     */
+    const COBS_link &Link() const { return link; };
+};
@@ -0,0 +1,138 @@
+#include "cobs_link.hpp"
+
+#include "protocol/crc.hpp"
+
+COBS_link::COBS_link(Serial_line &line, Checksum checksum) :
+    line(&line), checksum(checksum)
+{ }
+
+void COBS_link::Register(Invocation_wrapper_base<void, Frame> *callback){
+    this->callback = callback;
+}
+
+int COBS_link::Send(const uint8_t *data, size_t length){
+    // Encoded frame must fit into one message of serial line (HALUP_SERIAL_BUFFER in no-heap build)
+    if (length > HALUP_FRAME_MAX_SIZE || Encoded_size(length, checksum) > Serial_line::Text().max_size()) {
+        return -1;
+    }
+
+    uint8_t crc_bytes[sizeof(uint32_t)];
+    if (checksum == Checksum::CRC16) {
+        uint16_t crc = CRC::CRC16(data, length);
+        crc_bytes[0] = crc & 0xff;
+        crc_bytes[1] = crc >> 8;
+    } else {
+        uint32_t crc = CRC::CRC32(data, length);
+        for (int i = 0; i < 4; i++) {
+            crc_bytes[i] = (crc >> (i * 8)) & 0xff;
+        }
+    }
+
+    Serial_line::Text output(Encoded_size(length, checksum), '\0');
+    size_t code_index = 0;
+    size_t write_index = 1;
+    uint8_t code = 1;
+    auto put = [&](uint8_t byte){
+        if (byte == 0) {
+            output[code_index] = code;
+            code_index = write_index++;
+            code = 1;
+        } else {
+            output[write_index++] = byte;
+            code++;
+            if (code == 0xff) {
+                output[code_index] = code;
+                code_index = write_index++;
+                code = 1;
+            }
+        }
+    };
+
+    for (size_t i = 0; i < length; i++) {
+        put(data[i]);
+    }
+    for (uint8_t i = 0; i < static_cast<uint8_t>(checksum); i++) {
+        put(crc_bytes[i]);
+    }
+    output[code_index] = code;
+    output[write_index++] = 0x00;   // Delimiter of frame
+    output.resize(write_index);
+
+    return line->Send(std::move(output));
+}
+
+void COBS_link::Append(uint8_t byte){
+    if (frame_length >= sizeof(frame)) {
+        frame_error = true;
+        return;
+    }
+    frame[frame_length++] = byte;
+}
+
+void COBS_link::Feed(uint8_t byte){
+    if (byte == 0x00) {
+        Finish_frame();
+        return;
+    }
+    if (frame_error) {
+        return;
+    }
+    if (block_remaining == 0) { // Byte is code of new block
+        if (block_zero) {
+            Append(0x00);
+        }
+        block_remaining = byte - 1;
+        block_zero = (byte != 0xff);
+    } else {
+        Append(byte);
+        block_remaining--;
+    }
+}
+
+void COBS_link::Feed(const uint8_t *data, size_t length){
+    for (size_t i = 0; i < length; i++) {
+        Feed(data[i]);
+    }
+}
+
+unsigned int COBS_link::Process(){
+    Serial_line::Text received = line->Read(static_cast<int>(line->Buffer_size()));
+    Feed(reinterpret_cast<const uint8_t *>(received.data()), received.size());
+    return received.size();
+}
+
+void COBS_link::Finish_frame(){
+    size_t checksum_size = static_cast<uint8_t>(checksum);
+    bool empty = (frame_length == 0) && (not frame_error);
+
+    if (frame_error || block_remaining != 0 || (frame_length < checksum_size && not empty)) {
+        framing_errors++;
+    } else if (not empty) {
+        size_t payload_length = frame_length - checksum_size;
+        bool valid;
+        if (checksum == Checksum::CRC16) {
+            uint16_t received_crc = frame[payload_length] | frame[payload_length + 1] << 8;
+            valid = (CRC::CRC16(frame, payload_length) == received_crc);
+        } else {
+            uint32_t received_crc = 0;
+            for (int i = 0; i < 4; i++) {
+                received_crc |= static_cast<uint32_t>(frame[payload_length + i]) << (i * 8);
+            }
+            valid = (CRC::CRC32(frame, payload_length) == received_crc);
+        }
+
+        if (valid) {
+            frames_received++;
+            if (callback) {
+                callback->Invoke(Frame{frame, payload_length});
+            }
+        } else {
+            checksum_errors++;
+        }
+    }
+
+    frame_length = 0;
+    block_remaining = 0;
+    block_zero = false;
+    frame_error = false;
+}
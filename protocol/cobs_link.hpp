@@ -0,0 +1,189 @@
+/**
+ * @file cobs_link.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "uart/serial_line.hpp"
+#include "misc/invocation_wrapper.hpp"
+#include "misc/no_heap.hpp"
+
+/**
+ * @brief   Maximal size of payload of one frame in bytes
+ */
+#ifndef HALUP_FRAME_MAX_SIZE
+#define HALUP_FRAME_MAX_SIZE 256
+#endif
+
+/**
+ * @brief   Binary framed link over serial line
+ *          Every frame is payload followed by CRC (little-endian), encoded by COBS (Consistent Overhead Byte Stuffing)
+ *              and terminated by 0x00, overhead of encoding is 1 byte per 254 bytes of payload
+ *          Received bytes are decoded incrementally, every byte is processed only once
+ *          Complete frames with valid CRC are delivered to registered callback
+ */
+class COBS_link {
+public:
+    /**
+     * @brief   Checksum appended to every frame, value is size of checksum in bytes
+     */
+    enum class Checksum: uint8_t {
+        CRC16 = 2,
+        CRC32 = 4,
+    };
+
+    /**
+     * @brief   Received frame, data are valid only during callback
+     */
+    struct Frame {
+        const uint8_t *data;
+        size_t length;
+    };
+
+private:
+    /**
+     * @brief   Serial line over which are frames transferred
+     */
+    Serial_line *line;
+
+    /**
+     * @brief   Type of checksum of frames
+     */
+    Checksum checksum;
+
+    /**
+     * @brief   Callback which receives complete frames
+     */
+    Invocation_wrapper_base<void, Frame> *callback = nullptr;
+
+    /**
+     * @brief   Decoded part of frame which is currently received
+     */
+    uint8_t frame[HALUP_FRAME_MAX_SIZE + sizeof(uint32_t)];
+
+    /**
+     * @brief   Number of decoded bytes of current frame
+     */
+    size_t frame_length = 0;
+
+    /**
+     * @brief   Number of data bytes remaining in current COBS block, 0 if next byte is code of block
+     */
+    uint8_t block_remaining = 0;
+
+    /**
+     * @brief   True if zero must be inserted before next block (previous block was not full)
+     */
+    bool block_zero = false;
+
+    /**
+     * @brief   True if current frame is damaged and rest of it is skipped until delimiter
+     */
+    bool frame_error = false;
+
+    /**
+     * @brief   Statistics of received frames
+     */
+    uint32_t frames_received = 0;
+    uint32_t checksum_errors = 0;
+    uint32_t framing_errors = 0;
+
+    /**
+     * @brief   Append decoded byte into current frame
+     */
+    void Append(uint8_t byte);
+
+    /**
+     * @brief   Validate frame after delimiter was received and deliver it
+     */
+    void Finish_frame();
+
+public:
+    /**
+     * @brief Construct a new COBS_link object
+     *
+     * @param line      Serial line over which are frames transferred
+     * @param checksum  Type of checksum of frames
+     */
+    COBS_link(Serial_line &line, Checksum checksum = Checksum::CRC16);
+
+    /**
+     * @brief   Register callback which receives complete frames
+     *
+     * @param callback  Callback, nullptr disables delivery of frames
+     */
+    void Register(Invocation_wrapper_base<void, Frame> *callback);
+
+    /**
+     * @brief   Encode payload into frame and send it over serial line
+     *          Frame is encoded directly into transmitted string, no intermediate buffer is used
+     *
+     * @param data      Payload of frame
+     * @param length    Size of payload
+     * @return int      Status code of serial line, -1 if payload is too long
+     */
+    int Send(const uint8_t *data, size_t length);
+
+    /**
+     * @brief   Encode payload into frame and send it over serial line
+     *
+     * @param data      Payload of frame
+     * @return int      Status code of serial line, -1 if payload is too long
+     */
+    int Send(const Byte_vector &data){ return Send(data.data(), data.size()); };
+
+    /**
+     * @brief   Decode received byte, can be called directly from receive IRQ
+     *
+     * @param byte  Received byte
+     */
+    void Feed(uint8_t byte);
+
+    /**
+     * @brief   Decode received bytes
+     *
+     * @param data      Received data
+     * @param length    Number of received bytes
+     */
+    void Feed(const uint8_t *data, size_t length);
+
+    /**
+     * @brief   Move all received bytes from RX buffer of serial line into decoder
+     *
+     * @return unsigned int Number of processed bytes
+     */
+    unsigned int Process();
+
+    /**
+     * @brief   Calculate size of encoded frame including delimiter
+     *
+     * @param length    Size of payload
+     * @param checksum  Type of checksum
+     * @return size_t   Number of bytes transmitted over serial line
+     */
+    static constexpr size_t Encoded_size(size_t length, Checksum checksum){
+        size_t raw_length = length + static_cast<uint8_t>(checksum);
+        return raw_length + raw_length / 254 + 2;
+    }
+
+    /**
+     * @brief   Return number of valid frames received
+     */
+    uint32_t Frames_received() const { return frames_received; };
+
+    /**
+     * @brief   Return number of frames dropped due to invalid checksum
+     */
+    uint32_t Checksum_errors() const { return checksum_errors; };
+
+    /**
+     * @brief   Return number of frames dropped due to invalid encoding or excessive length
+     */
+    uint32_t Framing_errors() const { return framing_errors; };
+};
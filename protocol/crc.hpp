@@ -0,0 +1,110 @@
+/**
+ * @file crc.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief   Table driven CRC calculations, tables are generated at compile time and stored in flash
+ *          CRC16 - CRC-16/CCITT-FALSE (poly 0x1021, init 0xffff, not reflected)
+ *          CRC32 - CRC-32/ISO-HDLC as used by Ethernet and zlib (poly 0x04c11db7 reflected, init and xorout 0xffffffff)
+ */
+namespace CRC {
+    namespace detail {
+        constexpr std::array<uint16_t, 256> CRC16_table(){
+            std::array<uint16_t, 256> table{};
+            for (uint16_t i = 0; i < 256; i++) {
+                uint16_t value = i << 8;
+                for (int bit = 0; bit < 8; bit++) {
+                    value = (value & 0x8000) ? (value << 1) ^ 0x1021 : (value << 1);
+                }
+                table[i] = value;
+            }
+            return table;
+        }
+
+        constexpr std::array<uint32_t, 256> CRC32_table(){
+            std::array<uint32_t, 256> table{};
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t value = i;
+                for (int bit = 0; bit < 8; bit++) {
+                    value = (value & 1) ? (value >> 1) ^ 0xedb88320 : (value >> 1);
+                }
+                table[i] = value;
+            }
+            return table;
+        }
+
+        inline constexpr std::array<uint16_t, 256> crc16_table = CRC16_table();
+        inline constexpr std::array<uint32_t, 256> crc32_table = CRC32_table();
+    }
+
+    /**
+     * @brief   Initial value of CRC16 calculation
+     */
+    inline constexpr uint16_t crc16_init = 0xffff;
+
+    /**
+     * @brief   Update CRC16 by data, can be called repeatedly on fragments of data
+     *
+     * @param crc       Actual value of CRC, crc16_init for first fragment
+     * @param data      Data to process
+     * @param length    Number of bytes
+     * @return uint16_t Updated value of CRC
+     */
+    constexpr uint16_t CRC16_update(uint16_t crc, const uint8_t *data, size_t length){
+        for (size_t i = 0; i < length; i++) {
+            crc = (crc << 8) ^ detail::crc16_table[((crc >> 8) ^ data[i]) & 0xff];
+        }
+        return crc;
+    }
+
+    /**
+     * @brief   Calculate CRC16 of data
+     */
+    constexpr uint16_t CRC16(const uint8_t *data, size_t length){
+        return CRC16_update(crc16_init, data, length);
+    }
+
+    /**
+     * @brief   Initial value of CRC32 calculation
+     */
+    inline constexpr uint32_t crc32_init = 0xffffffff;
+
+    /**
+     * @brief   Update CRC32 by data, can be called repeatedly on fragments of data
+     *          Result must be finished by CRC32_final
+     *
+     * @param crc       Actual value of CRC, crc32_init for first fragment
+     * @param data      Data to process
+     * @param length    Number of bytes
+     * @return uint32_t Updated value of CRC
+     */
+    constexpr uint32_t CRC32_update(uint32_t crc, const uint8_t *data, size_t length){
+        for (size_t i = 0; i < length; i++) {
+            crc = (crc >> 8) ^ detail::crc32_table[(crc ^ data[i]) & 0xff];
+        }
+        return crc;
+    }
+
+    /**
+     * @brief   Finish CRC32 calculation
+     */
+    constexpr uint32_t CRC32_final(uint32_t crc){
+        return crc ^ 0xffffffff;
+    }
+
+    /**
+     * @brief   Calculate CRC32 of data
+     */
+    constexpr uint32_t CRC32(const uint8_t *data, size_t length){
+        return CRC32_final(CRC32_update(crc32_init, data, length));
+    }
+}
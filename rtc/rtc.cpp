@@ -4,6 +4,7 @@ RTC_internal::RTC_internal() {
 }
 
 void RTC_internal::Init(uint8_t async_prediv, uint16_t sync_prediv){
+    this->sync_prediv = sync_prediv;
     hrtc.Instance = RTC;
     hrtc.Init.HourFormat = RTC_HOURFORMAT_24;
     hrtc.Init.AsynchPrediv = async_prediv;
@@ -70,7 +71,62 @@ void RTC_internal::Set_alarm(const Time& time) {
     HAL_RTC_SetAlarm_IT(&hrtc, &sAlarm, RTC_FORMAT_BIN);
 }
 
+void RTC_internal::Set_alarm(uint64_t epoch) {
+    // Alarm is rounded up to nearest subsecond step, so time read in alarm IRQ is not before requested moment
+    uint32_t steps = ((epoch % 1000) * (sync_prediv + 1) + 999) / 1000;
+    if (steps > sync_prediv) {
+        epoch += 1000 - epoch % 1000;
+        steps = 0;
+    }
+    Timestamp timestamp = From_epoch(epoch);
+    sAlarm.AlarmTime.Hours = timestamp.time.hours;
+    sAlarm.AlarmTime.Minutes = timestamp.time.minutes;
+    sAlarm.AlarmTime.Seconds = timestamp.time.seconds;
+    // Subsecond register counts down from sync_prediv
+    sAlarm.AlarmTime.SubSeconds = sync_prediv - steps;
+    sAlarm.AlarmTime.DayLightSaving = RTC_DAYLIGHTSAVING_NONE;
+    sAlarm.AlarmTime.StoreOperation = RTC_STOREOPERATION_RESET;
+    sAlarm.AlarmMask = RTC_ALARMMASK_DATEWEEKDAY;
+    sAlarm.AlarmSubSecondMask = RTC_ALARMSUBSECONDMASK_NONE;
+    sAlarm.AlarmDateWeekDaySel = RTC_ALARMDATEWEEKDAYSEL_DATE;
+    sAlarm.AlarmDateWeekDay = 1;
+    sAlarm.Alarm = RTC_ALARM_A;
+    HAL_RTC_SetAlarm_IT(&hrtc, &sAlarm, RTC_FORMAT_BIN);
+}
+
+void RTC_internal::Disable_alarm() {
+    HAL_RTC_DeactivateAlarm(&hrtc, RTC_ALARM_A);
+}
+
 RTC_internal::Time RTC_internal::Get_alarm() {
     HAL_RTC_GetAlarm(&hrtc, &sAlarm, RTC_ALARM_A, RTC_FORMAT_BIN);
     return {sAlarm.AlarmTime.Hours, sAlarm.AlarmTime.Minutes, sAlarm.AlarmTime.Seconds};
 }
+
+uint64_t RTC_internal::Now() {
+    RTC_TimeTypeDef sTime;
+    RTC_DateTypeDef sDate;
+    // Date must be read after time to unlock shadow registers
+    HAL_RTC_GetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
+    HAL_RTC_GetDate(&hrtc, &sDate, RTC_FORMAT_BIN);
+
+    // Subsecond register counts down from sync_prediv
+    uint32_t subseconds = sTime.SubSeconds > sync_prediv ? 0 : sync_prediv - sTime.SubSeconds;
+    uint16_t milliseconds = subseconds * 1000 / (sync_prediv + 1);
+    return To_epoch({{sTime.Hours, sTime.Minutes, sTime.Seconds}, {sDate.Year, sDate.Month, sDate.Date}}, milliseconds);
+}
+
+void RTC_internal::Set_epoch(uint64_t epoch) {
+    Timestamp timestamp = From_epoch(epoch);
+    Set_time(timestamp.time);
+    Set_date(timestamp.date);
+}
+
+uint64_t RTC_internal::Monotonic() {
+    uint64_t now = Now();
+    if (now + monotonic_offset < monotonic_last) {
+        monotonic_offset = monotonic_last - now;
+    }
+    monotonic_last = now + monotonic_offset;
+    return monotonic_last;
+}
@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include "stm32l4xx_hal.h"
+#include "global_includes.hpp"
 
 #include <cstdint>
 
@@ -19,6 +19,17 @@ class RTC_internal {
 
     RTC_AlarmTypeDef sAlarm;
 
+    /**
+     * @brief   Synchronous prescaler of RTC, determines resolution of subseconds
+     */
+    uint16_t sync_prediv = 255;
+
+    /**
+     * @brief   Last value returned by Monotonic() and offset added to compensate backward jumps of calendar
+     */
+    uint64_t monotonic_last = 0;
+    uint64_t monotonic_offset = 0;
+
 public:
     /**
      * @brief   Structure which represent time in hours, minutes and seconds
@@ -46,6 +57,78 @@ public:
         Date date;
     };
 
+    /**
+     * @brief   Number of days between 1970-01-01 and given date of proleptic Gregorian calendar
+     *          Algorithm from Howard Hinnant "chrono-Compatible Low-Level Date Algorithms", no mktime is needed
+     *
+     * @param year      Full year, for example 2026
+     * @param month     Month 1-12
+     * @param day       Day of month 1-31
+     * @return int32_t  Days since Unix epoch, negative for dates before 1970
+     */
+    static constexpr int32_t Days_from_civil(int32_t year, uint32_t month, uint32_t day){
+        year -= month <= 2;
+        const int32_t era = (year >= 0 ? year : year - 399) / 400;
+        const uint32_t year_of_era = static_cast<uint32_t>(year - era * 400);
+        const uint32_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const uint32_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+        return era * 146097 + static_cast<int32_t>(day_of_era) - 719468;
+    }
+
+    /**
+     * @brief   Date of proleptic Gregorian calendar from number of days since 1970-01-01, inverse of Days_from_civil
+     *
+     * @param days      Days since Unix epoch
+     * @param year      Full year
+     * @param month     Month 1-12
+     * @param day       Day of month 1-31
+     */
+    static constexpr void Civil_from_days(int32_t days, int32_t &year, uint32_t &month, uint32_t &day){
+        days += 719468;
+        const int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+        const uint32_t day_of_era = static_cast<uint32_t>(days - era * 146097);
+        const uint32_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+        const uint32_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+        const uint32_t month_prime = (5 * day_of_year + 2) / 153;
+        day = day_of_year - (153 * month_prime + 2) / 5 + 1;
+        month = month_prime < 10 ? month_prime + 3 : month_prime - 9;
+        year = static_cast<int32_t>(year_of_era) + era * 400 + (month <= 2);
+    }
+
+    /**
+     * @brief   Convert timestamp of RTC into milliseconds since Unix epoch
+     *          Year of RTC is offset from 2000
+     *
+     * @param timestamp     Date and time of RTC
+     * @param milliseconds  Subsecond part of timestamp
+     * @return uint64_t     Milliseconds since 1970-01-01 00:00:00
+     */
+    static constexpr uint64_t To_epoch(const Timestamp &timestamp, uint16_t milliseconds = 0){
+        uint64_t days = Days_from_civil(2000 + timestamp.date.year, timestamp.date.month, timestamp.date.day);
+        uint64_t seconds = days * 86400 + timestamp.time.hours * 3600 + timestamp.time.minutes * 60 + timestamp.time.seconds;
+        return seconds * 1000 + milliseconds;
+    }
+
+    /**
+     * @brief   Convert milliseconds since Unix epoch into timestamp of RTC, subsecond part is discarded
+     *          Valid only for years 2000-2099 which can be represented by RTC
+     *
+     * @param epoch         Milliseconds since 1970-01-01 00:00:00
+     * @return Timestamp    Date and time of RTC
+     */
+    static constexpr Timestamp From_epoch(uint64_t epoch){
+        uint64_t seconds = epoch / 1000;
+        int32_t year = 0;
+        uint32_t month = 0;
+        uint32_t day = 0;
+        Civil_from_days(static_cast<int32_t>(seconds / 86400), year, month, day);
+        uint32_t second_of_day = seconds % 86400;
+        return {
+            {static_cast<uint8_t>(second_of_day / 3600), static_cast<uint8_t>(second_of_day / 60 % 60), static_cast<uint8_t>(second_of_day % 60)},
+            {static_cast<uint8_t>(year - 2000), static_cast<uint8_t>(month), static_cast<uint8_t>(day)}
+        };
+    }
+
 public:
     RTC_internal();
 
@@ -62,4 +145,42 @@ public:
     void Set_alarm(const Time& time);
 
     Time Get_alarm();
+
+    /**
+     * @brief   Set alarm A to given moment including subseconds, date is masked so alarm
+     *              must be less than 24 hours in future
+     *
+     * @param epoch Moment of alarm in milliseconds since 1970-01-01 00:00:00
+     */
+    void Set_alarm(uint64_t epoch);
+
+    /**
+     * @brief   Disable alarm A
+     */
+    void Disable_alarm();
+
+    /**
+     * @brief   Read date and time in one consistent snapshot including subseconds
+     *          Time and date are read from shadow registers, which are locked by reading of time
+     *              until date is read, so there is no race across second boundary
+     *          Resolution of subseconds is 1/(sync_prediv + 1) s
+     *
+     * @return uint64_t Milliseconds since 1970-01-01 00:00:00
+     */
+    uint64_t Now();
+
+    /**
+     * @brief   Set date and time of RTC from milliseconds since Unix epoch, subsecond part is discarded
+     *
+     * @param epoch Milliseconds since 1970-01-01 00:00:00, years 2000-2099
+     */
+    void Set_epoch(uint64_t epoch);
+
+    /**
+     * @brief   Time which never goes backwards, even when calendar of RTC wraps from 2099 to 2000
+     *              or is set to past, backward jumps are compensated by offset
+     *
+     * @return uint64_t Monotonic time in milliseconds
+     */
+    uint64_t Monotonic();
 };
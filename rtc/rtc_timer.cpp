@@ -0,0 +1,219 @@
+#include "rtc_timer.hpp"
+
+#include <algorithm>
+
+RTC_timer_wheel::RTC_timer_wheel(RTC_internal &rtc, uint16_t resolution) :
+    rtc(&rtc), resolution(resolution ? resolution : 1)
+{
+    instance = this;
+}
+
+RTC_timer_wheel::~RTC_timer_wheel(){
+    if (instance == this) {
+        instance = nullptr;
+    }
+}
+
+RTC_timer *&RTC_timer_wheel::Head(uint8_t level, uint8_t slot){
+    if (level == overflow_level) {
+        return overflow;
+    } else if (level == ready_level) {
+        return ready;
+    }
+    return wheel[level][slot];
+}
+
+void RTC_timer_wheel::Link(RTC_timer &timer, uint8_t level, uint8_t slot){
+    RTC_timer *&head = Head(level, slot);
+    timer.level = level;
+    timer.slot = slot;
+    timer.previous = nullptr;
+    timer.next = head;
+    if (head) {
+        head->previous = &timer;
+    }
+    head = &timer;
+    if (level < levels) {
+        occupied[level] |= (uint64_t)1 << slot;
+    }
+}
+
+void RTC_timer_wheel::Unlink(RTC_timer &timer){
+    RTC_timer *&head = Head(timer.level, timer.slot);
+    if (timer.previous) {
+        timer.previous->next = timer.next;
+    } else {
+        head = timer.next;
+    }
+    if (timer.next) {
+        timer.next->previous = timer.previous;
+    }
+    timer.next = nullptr;
+    timer.previous = nullptr;
+    if (timer.level < levels && head == nullptr) {
+        occupied[timer.level] &= ~((uint64_t)1 << timer.slot);
+    }
+}
+
+void RTC_timer_wheel::Insert(RTC_timer &timer){
+    if (timer.expiry <= now) {
+        Link(timer, ready_level, 0);
+        return;
+    }
+    // Timer is stored in lowest level whose window contains both actual tick and expiry
+    for (uint8_t level = 0; level < levels; level++) {
+        uint8_t window_shift = slot_bits * (level + 1);
+        if ((timer.expiry >> window_shift) == (now >> window_shift)) {
+            Link(timer, level, (timer.expiry >> (slot_bits * level)) & (slots - 1));
+            return;
+        }
+    }
+    Link(timer, overflow_level, 0);
+}
+
+void RTC_timer_wheel::Cascade(uint8_t level, uint8_t slot){
+    RTC_timer *timer = Head(level, slot);
+    Head(level, slot) = nullptr;
+    if (level < levels) {
+        occupied[level] &= ~((uint64_t)1 << slot);
+    }
+    while (timer) {
+        RTC_timer *next = timer->next;
+        Insert(*timer);
+        timer = next;
+    }
+}
+
+uint64_t RTC_timer_wheel::Next_event() const{
+    for (uint8_t level = 0; level < levels; level++) {
+        uint8_t index = (now >> (slot_bits * level)) & (slots - 1);
+        uint64_t later_slots = (index == slots - 1) ? 0 : (~(uint64_t)0 << (index + 1));
+        uint64_t candidates = occupied[level] & later_slots;
+        if (candidates) {
+            uint8_t slot = __builtin_ctzll(candidates);
+            uint64_t window = now >> (slot_bits * (level + 1));
+            return ((window << slot_bits) | slot) << (slot_bits * level);
+        }
+    }
+    // Nothing in wheel, next event is start of next window of highest level where overflow is reinserted
+    return ((now >> (slot_bits * levels)) + 1) << (slot_bits * levels);
+}
+
+void RTC_timer_wheel::Advance(uint64_t target){
+    while (now < target) {
+        uint64_t next = Next_event();
+        if (next > target) {
+            now = target;
+            break;
+        }
+        now = next;
+
+        if ((now & (((uint64_t)1 << (slot_bits * levels)) - 1)) == 0) {
+            Cascade(overflow_level, 0);
+        }
+        for (uint8_t level = levels - 1; level > 0; level--) {
+            if ((now & (((uint64_t)1 << (slot_bits * level)) - 1)) == 0) {
+                Cascade(level, (now >> (slot_bits * level)) & (slots - 1));
+            }
+        }
+        Cascade(0, now & (slots - 1));  // Timers of slot expired, they are moved to ready list
+    }
+}
+
+void RTC_timer_wheel::Update(){
+    uint64_t current = rtc->Monotonic() / resolution;
+    if (not synchronized) {
+        now = current;
+        synchronized = true;
+    }
+    Advance(current);
+}
+
+void RTC_timer_wheel::Start(RTC_timer &timer, uint32_t delay, uint32_t period){
+    Cancel(timer);
+    Update();
+    timer.expiry = now + (delay + resolution - 1) / resolution;
+    timer.period = (period + resolution - 1) / resolution;
+    timer.active = true;
+    Insert(timer);
+    Program_alarm();
+}
+
+void RTC_timer_wheel::Cancel(RTC_timer &timer){
+    if (timer.active) {
+        Unlink(timer);
+        timer.active = false;
+    }
+}
+
+unsigned int RTC_timer_wheel::Dispatch(){
+    pending = false;
+    Update();
+
+    unsigned int invoked = 0;
+    while (ready) {
+        RTC_timer *timer = ready;
+        Unlink(*timer);
+        timer->active = false;
+        if (timer->period) {    // Reschedule before callback, so callback can cancel timer
+            uint64_t missed = (now - timer->expiry) / timer->period;
+            timer->expiry += timer->period * (missed + 1);
+            timer->active = true;
+            Insert(*timer);
+        }
+        if (timer->callback) {
+            timer->callback->Invoke();
+        }
+        invoked++;
+    }
+
+    Program_alarm();
+    return invoked;
+}
+
+std::optional<uint64_t> RTC_timer_wheel::Next_expiry() const{
+    if (ready) {
+        return now * resolution;
+    }
+    for (uint8_t level = 0; level < levels; level++) {
+        uint8_t index = (now >> (slot_bits * level)) & (slots - 1);
+        uint64_t later_slots = (index == slots - 1) ? 0 : (~(uint64_t)0 << (index + 1));
+        uint64_t candidates = occupied[level] & later_slots;
+        if (candidates) {
+            // First nonempty slot contains the nearest timer, but slots of higher levels are not sorted
+            uint64_t nearest = UINT64_MAX;
+            for (RTC_timer *timer = wheel[level][__builtin_ctzll(candidates)]; timer; timer = timer->next) {
+                nearest = std::min(nearest, timer->expiry);
+            }
+            return nearest * resolution;
+        }
+    }
+    if (overflow) {
+        uint64_t nearest = UINT64_MAX;
+        for (RTC_timer *timer = overflow; timer; timer = timer->next) {
+            nearest = std::min(nearest, timer->expiry);
+        }
+        return nearest * resolution;
+    }
+    return {};
+}
+
+void RTC_timer_wheel::Program_alarm(){
+    auto next = Next_expiry();
+    if (not next.has_value()) {
+        rtc->Disable_alarm();
+        return;
+    }
+    uint64_t current = rtc->Monotonic();
+    if (next.value() <= current) {
+        pending = true;
+        return;
+    }
+    // Alarm compares only time of day, more distant expirations are reached by intermediate alarms
+    uint64_t delay = std::min<uint64_t>(next.value() - current, 23ULL * 3600 * 1000);
+    rtc->Set_alarm(rtc->Now() + delay);
+    // Near moment can pass during programming, alarm would then match same time of day after almost 24 h
+    if (rtc->Monotonic() >= current + delay) {
+        pending = true;
+    }
+}
@@ -0,0 +1,270 @@
+/**
+ * @file rtc_timer.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "rtc/rtc.hpp"
+#include "misc/invocation_wrapper.hpp"
+
+class RTC_timer_wheel;
+
+/**
+ * @brief   Software timer driven by RTC_timer_wheel
+ *          Object is owned by application (static allocation), wheel only links timers into its slots
+ */
+class RTC_timer {
+    friend class RTC_timer_wheel;
+
+private:
+    /**
+     * @brief   Neighbours in list of slot in which is timer stored
+     */
+    RTC_timer *next = nullptr;
+    RTC_timer *previous = nullptr;
+
+    /**
+     * @brief   Tick in which timer expires
+     */
+    uint64_t expiry = 0;
+
+    /**
+     * @brief   Period of timer in ticks, 0 for one-shot timer
+     */
+    uint32_t period = 0;
+
+    /**
+     * @brief   Level and slot of wheel in which is timer stored
+     */
+    uint8_t level = 0;
+    uint8_t slot = 0;
+
+    /**
+     * @brief   True if timer is linked into wheel
+     */
+    bool active = false;
+
+    /**
+     * @brief   Callback invoked after expiration of timer
+     */
+    Invocation_wrapper_base<void, void> *callback;
+
+public:
+    /**
+     * @brief Construct a new RTC_timer object
+     *
+     * @param callback  Callback invoked by RTC_timer_wheel::Dispatch after expiration of timer
+     */
+    RTC_timer(Invocation_wrapper_base<void, void> *callback) :
+        callback(callback)
+    { }
+
+    /**
+     * @brief   Return true if timer is running
+     */
+    bool Active() const { return active; };
+};
+
+/**
+ * @brief   Hierarchical timer wheel which multiplexes many software timers onto alarm A of RTC
+ *          Wheel has 4 levels of 64 slots, insertion and cancellation of timer is O(1)
+ *          Timers further than 64^4 ticks are kept in overflow list
+ *          Nearest expiry is programmed into RTC alarm including subseconds, so MCU can sleep until then
+ *          Alarm IRQ only marks wheel as pending, callbacks are invoked from Dispatch() in main loop
+ *
+ *          Alarm callback of HAL forwards IRQ to wheel of RTC (see misc/hal_callbacks.hpp):
+ *              void HAL_RTC_AlarmAEventCallback(RTC_HandleTypeDef *hrtc){ RTC_timer_wheel::Of(hrtc)->Alarm(); }
+ */
+class RTC_timer_wheel {
+private:
+    static constexpr uint8_t levels = 4;
+    static constexpr uint8_t slot_bits = 6;
+    static constexpr uint8_t slots = 1 << slot_bits;
+
+    /**
+     * @brief   Pseudo levels used for timers outside of wheel
+     */
+    static constexpr uint8_t overflow_level = levels;
+    static constexpr uint8_t ready_level = levels + 1;
+
+    /**
+     * @brief   RTC used as source of time and for wake up by alarm
+     */
+    RTC_internal *rtc;
+
+    /**
+     * @brief   Length of one tick in milliseconds
+     */
+    uint16_t resolution;
+
+    /**
+     * @brief   Tick to which was wheel advanced, ticks are counted from start of monotonic time of RTC
+     */
+    uint64_t now = 0;
+
+    /**
+     * @brief   False until wheel is aligned with time of RTC for first time
+     */
+    bool synchronized = false;
+
+    /**
+     * @brief   Lists of timers in slots of all levels and bitmaps of nonempty slots
+     */
+    RTC_timer *wheel[levels][slots] = {};
+    uint64_t occupied[levels] = {};
+
+    /**
+     * @brief   Timers too far in future for wheel
+     */
+    RTC_timer *overflow = nullptr;
+
+    /**
+     * @brief   Expired timers waiting for invocation of callback
+     */
+    RTC_timer *ready = nullptr;
+
+    /**
+     * @brief   Set by alarm IRQ, wheel must be advanced
+     */
+    volatile bool pending = false;
+
+    /**
+     * @brief   Callback invoked by alarm IRQ, wakes main loop
+     */
+    Invocation_wrapper_base<void, void> *wake_callback = nullptr;
+
+    /**
+     * @brief   Wheel which uses alarm of RTC, MCU has single RTC
+     */
+    static inline RTC_timer_wheel *instance = nullptr;
+
+    /**
+     * @brief   Return head of list for given level and slot
+     */
+    RTC_timer *&Head(uint8_t level, uint8_t slot);
+
+    /**
+     * @brief   Link timer into list
+     */
+    void Link(RTC_timer &timer, uint8_t level, uint8_t slot);
+
+    /**
+     * @brief   Unlink timer from list in which it is stored
+     */
+    void Unlink(RTC_timer &timer);
+
+    /**
+     * @brief   Place timer into slot according to its expiry and actual tick
+     */
+    void Insert(RTC_timer &timer);
+
+    /**
+     * @brief   Move all timers from slot into lower levels
+     */
+    void Cascade(uint8_t level, uint8_t slot);
+
+    /**
+     * @brief   Return tick of nearest slot which must be processed
+     */
+    uint64_t Next_event() const;
+
+    /**
+     * @brief   Advance wheel to given tick, expired timers are moved to ready list
+     */
+    void Advance(uint64_t target);
+
+    /**
+     * @brief   Advance wheel to current monotonic time of RTC
+     */
+    void Update();
+
+    /**
+     * @brief   Program nearest expiry into RTC alarm
+     */
+    void Program_alarm();
+
+public:
+    /**
+     * @brief Construct a new RTC_timer_wheel object
+     *
+     * @param rtc           Initialized RTC
+     * @param resolution    Length of one tick in milliseconds
+     */
+    RTC_timer_wheel(RTC_internal &rtc, uint16_t resolution = 10);
+
+    /**
+     * @brief   Release alarm of RTC
+     */
+    ~RTC_timer_wheel();
+
+    // Alarm IRQ and timers keep address of wheel
+    RTC_timer_wheel(const RTC_timer_wheel &) = delete;
+    RTC_timer_wheel &operator=(const RTC_timer_wheel &) = delete;
+
+    /**
+     * @brief   Return wheel which uses alarm of RTC, used by HAL callback
+     *
+     * @param handle    Handle which triggered callback
+     * @return RTC_timer_wheel*     Wheel or null if there is no wheel for handle
+     */
+    static RTC_timer_wheel *Of(const RTC_HandleTypeDef *handle){ return handle == &hrtc ? instance : nullptr; };
+
+    /**
+     * @brief   Start timer, already running timer is restarted
+     *
+     * @param timer     Timer to start
+     * @param delay     Delay of first expiration in ms, rounded up to ticks
+     * @param period    Period of next expirations in ms, 0 for one-shot timer
+     */
+    void Start(RTC_timer &timer, uint32_t delay, uint32_t period = 0);
+
+    /**
+     * @brief   Stop timer, callback of timer will not be invoked
+     *
+     * @param timer Timer to stop
+     */
+    void Cancel(RTC_timer &timer);
+
+    /**
+     * @brief   Notify wheel about alarm, must be called from HAL_RTC_AlarmAEventCallback
+     */
+    void Alarm(){
+        pending = true;
+        if (wake_callback) {
+            wake_callback->Invoke();
+        }
+    };
+
+    /**
+     * @brief   Register callback which is invoked from alarm IRQ, usually Run_loop::Wake
+     *
+     * @param callback  Callback to invoke, nullptr disables notification
+     */
+    void Wake_notification(Invocation_wrapper_base<void, void> *callback){ wake_callback = callback; };
+
+    /**
+     * @brief   Return true if alarm occurred and Dispatch() should be called
+     */
+    bool Pending() const { return pending; };
+
+    /**
+     * @brief   Advance wheel to current time, invoke callbacks of expired timers and program next alarm
+     *          Must be called from main loop (not from IRQ)
+     *
+     * @return unsigned int Number of invoked callbacks
+     */
+    unsigned int Dispatch();
+
+    /**
+     * @brief   Return monotonic time of nearest expiration
+     *
+     * @return std::optional<uint64_t>  Monotonic time of RTC in ms, empty if no timer is running
+     */
+    std::optional<uint64_t> Next_expiry() const;
+};
@@ -1,26 +1,73 @@
 #include "LIS2DW12.hpp"
 
 LIS2DW12::LIS2DW12(I2C_master master, unsigned char address):
-    I2C_device(master, address)
+    bus(std::in_place_type<I2C_device>, master, address)
 {
 }
 
+LIS2DW12::LIS2DW12(SPI_master &master, Pin *chip_select):
+    bus(std::in_place_type<SPI_device>, master, chip_select, 0x80)
+{
+}
+
+std::optional<Byte_vector> LIS2DW12::Read_registers(uint16_t address, uint8_t address_size, unsigned int length){
+    return std::visit([&](auto &device){ return device.Read_registers(address, address_size, length); }, bus);
+}
+
+bool LIS2DW12::Write_registers(uint16_t address, uint8_t address_size, const Byte_vector &data){
+    return std::visit([&](auto &device){ return device.Write_registers(address, address_size, data); }, bus);
+}
+
 uint8_t LIS2DW12::ID(){
-    return Register(Registers::WHO_AM_I);
+    return Register_map::Read<Map::WHO_AM_I>(*this).value_or(0x00);
 }
 
 array<int16_t, 3> LIS2DW12::Acceleration(){
-    array<int16_t, 3> acceleration;
-    auto register_values = Read(static_cast<uint8_t>(Registers::OUT_X_L),6).value();
-    acceleration[0] = (register_values[0] | register_values[1] << 8);
-    acceleration[1] = (register_values[2] | register_values[3] << 8);
-    acceleration[2] = (register_values[4] | register_values[5] << 8);
+    array<int16_t, 3> acceleration = {};
+    // All axis are read by one transfer
+    auto register_values = Register_map::Read_burst<Map::OUT_X, Map::OUT_Y, Map::OUT_Z>(*this);
+    if(register_values.has_value()){
+        acceleration = {std::get<0>(*register_values), std::get<1>(*register_values), std::get<2>(*register_values)};
+    }
     return acceleration;
 }
 
+bool LIS2DW12::Fifo(Fifo_mode mode, uint8_t threshold){
+    uint8_t value = Map::FTH::Insert(Map::FMODE::Insert(0, mode), threshold);
+    return Register_map::Write<Map::FIFO_CTRL>(*this, value);
+}
+
+uint8_t LIS2DW12::Fifo_samples(){
+    return Register_map::Read_field<Map::DIFF>(*this).value_or(0);
+}
+
+LIS2DW12::Samples LIS2DW12::Drain(){
+    Samples samples;
+    uint8_t count = Fifo_samples();
+    if(count == 0){
+        return samples;
+    }
+    auto data = Read_registers(static_cast<uint8_t>(Registers::OUT_X_L), 1, count * sample_size);
+    if(!data || data->size() < count * sample_size){
+        return samples;
+    }
+    samples.reserve(count);
+    for(uint8_t i = 0; i < count; i++){
+        samples.push_back(Sample(data->data() + i * sample_size));
+    }
+    return samples;
+}
+
+std::array<int16_t, 3> LIS2DW12::Sample(const uint8_t *data){
+    size_t offset = 0;
+    int16_t x = Register_map::Take<Map::OUT_X>(data, offset);
+    int16_t y = Register_map::Take<Map::OUT_Y>(data, offset);
+    int16_t z = Register_map::Take<Map::OUT_Z>(data, offset);
+    return {x, y, z};
+}
 
 uint8_t LIS2DW12::Register(LIS2DW12::Registers register_name){
-        auto register_data = Read(static_cast<uint8_t>(register_name),1);
+        auto register_data = Read_registers(static_cast<uint8_t>(register_name), 1, 1);
         if(register_data.has_value() == false){
             return 0x00;
         }
@@ -28,6 +75,6 @@ uint8_t LIS2DW12::Register(LIS2DW12::Registers register_name){
 }
 
 uint LIS2DW12::Register(LIS2DW12::Registers register_name, uint8_t &value){
-        auto data = vector<uint8_t>{value};
-        return Write(static_cast<uint8_t>(register_name), data);
+        auto data = Byte_vector{value};
+        return Write_registers(static_cast<uint8_t>(register_name), 1, data);
 }
@@ -8,15 +8,19 @@
 #pragma once
 
 #include <array>
-#include <vector>
+#include <variant>
 
 #include "i2c/i2c_device.hpp"
+#include "i2c/register_map.hpp"
+#include "spi/spi_device.hpp"
 
 /**
  * @brief   LIS2DW12: MEMS digital output motion sensor - high-performance ultra-low-power 3-axis accelerometer
- *          Only basic functionality is implemented, (no interrupts fifo, fall/tap detection)
+ *          Sensor is connected by I2C or SPI, register API is same for both buses
+ *          SPI (up to 10 MHz) is required to drain full FIFO at 1600 Hz ODR, I2C at 400 kHz spends most of time on bus
+ *          Only basic functionality is implemented, (no interrupts, fall/tap detection)
  */
-class LIS2DW12 : public I2C_device
+class LIS2DW12 : public Register_device
 {
 public:
     enum class Registers: uint8_t {
@@ -37,6 +41,8 @@ public:
         OUT_Y_H = 0x2b,
         OUT_Z_L = 0x2c,
         OUT_Z_H = 0x2d,
+        FIFO_CTRL    = 0x2e,
+        FIFO_SAMPLES = 0x2f,
         CTRL7   = 0x3f
     };
 
@@ -122,16 +128,100 @@ public:
         Filtering_cutoff BW_FILT    : 2; // Bandwidth selection
     };
 
+    enum class Fifo_mode: uint8_t {
+        Bypass                  = 0b000, // FIFO is turned off
+        FIFO                    = 0b001, // Data are stored until FIFO is full
+        Continuous_to_FIFO      = 0b011, // Stream mode until trigger is deasserted, then FIFO mode
+        Bypass_to_continuous    = 0b100, // Bypass mode until trigger is deasserted, then continuous mode
+        Continuous              = 0b110, // Older samples are overwritten when FIFO is full
+    };
+
+    /**
+     * @brief Number of samples stored in FIFO
+     */
+    static constexpr uint8_t fifo_depth = 32;
+
+    /**
+     * @brief Size of one sample of FIFO (X, Y, Z) in bytes
+     */
+    static constexpr uint8_t sample_size = 6;
+
+    /**
+     * @brief Samples of FIFO [X,Y,Z], whole FIFO fits into one register transfer
+     */
+    using Samples = Bounded_vector<std::array<int16_t, 3>, fifo_depth>;
+
+private:
+    /**
+     * @brief Bus to which is sensor connected
+     */
+    std::variant<I2C_device, SPI_device> bus;
+
+    /**
+     * @brief 8-bit registers addressed by 8-bit address, address is incremented during transfer if IF_ADD_INC is set
+     */
+    using Layout = Register_map::Layout<uint8_t, uint8_t, Register_map::Endian::Little>;
+
 public:
+    /**
+     * @brief Register map of sensor, outputs are 16-bit little-endian values in pairs of registers
+     */
+    struct Map {
+        using WHO_AM_I  = Register_map::Register<Layout, Registers::WHO_AM_I, Register_map::Access::Read_only>;
+        using CTRL1     = Register_map::Register<Layout, Registers::CTRL1>;
+        using CTRL2     = Register_map::Register<Layout, Registers::CTRL2>;
+        using CTRL6     = Register_map::Register<Layout, Registers::CTRL6>;
+        using STATUS    = Register_map::Register<Layout, Registers::STATUS, Register_map::Access::Read_only>;
+        using OUT_X     = Register_map::Register<Layout, Registers::OUT_X_L, Register_map::Access::Read_only, int16_t>;
+        using OUT_Y     = Register_map::Register<Layout, Registers::OUT_Y_L, Register_map::Access::Read_only, int16_t>;
+        using OUT_Z     = Register_map::Register<Layout, Registers::OUT_Z_L, Register_map::Access::Read_only, int16_t>;
+        using FIFO_CTRL = Register_map::Register<Layout, Registers::FIFO_CTRL>;
+        using FIFO_SAMPLES = Register_map::Register<Layout, Registers::FIFO_SAMPLES, Register_map::Access::Read_only>;
+
+        using ODR       = Register_map::Field<CTRL1, 0xf0, Data_rate>;
+        using MODE      = Register_map::Field<CTRL1, 0x0c, Modes>;
+        using LP_MODE   = Register_map::Field<CTRL1, 0x03, Low_power_modes>;
+        using IF_ADD_INC = Register_map::Field<CTRL2, 0x04, bool>;
+        using FS        = Register_map::Field<CTRL6, 0x30, Full_scale>;
+        using DRDY      = Register_map::Field<STATUS, 0x01, bool>;
+        using FMODE     = Register_map::Field<FIFO_CTRL, 0xe0, Fifo_mode>;
+        using FTH       = Register_map::Field<FIFO_CTRL, 0x1f>;
+        using DIFF      = Register_map::Field<FIFO_SAMPLES, 0x3f>;
+        using FIFO_OVR  = Register_map::Field<FIFO_SAMPLES, 0x40, bool>;
+    };
 
         /**
-         * @brief Construct a new LIS2DW12 object
+         * @brief Construct a new LIS2DW12 object connected by I2C
          *
          * @param master
          * @param address   I2C address in 8-biz format (stuffed with 0 at the end)
          */
         LIS2DW12(I2C_master master, unsigned char address);
 
+        /**
+         * @brief Construct a new LIS2DW12 object connected by SPI
+         *        Read flag is 0x80, address is incremented by IF_ADD_INC as over I2C
+         *
+         * @param master        SPI bus, must outlive sensor
+         * @param chip_select   Chip select of sensor
+         */
+        LIS2DW12(SPI_master &master, Pin *chip_select);
+
+        std::optional<Byte_vector> Read_registers(uint16_t address, uint8_t address_size, unsigned int length) override;
+
+        bool Write_registers(uint16_t address, uint8_t address_size, const Byte_vector &data) override;
+
+        /**
+         * @brief Return I2C device of sensor, nullptr if sensor is connected by SPI
+         */
+        I2C_device *I2C(){ return std::get_if<I2C_device>(&bus); };
+
+        /**
+         * @brief Return SPI device of sensor, nullptr if sensor is connected by I2C
+         *        Can be used for DMA read of FIFO, samples are decoded by Sample()
+         */
+        SPI_device *SPI(){ return std::get_if<SPI_device>(&bus); };
+
         /**
          * @brief   Reads ID from sensor register (0x0f)
          *
@@ -158,8 +248,37 @@ public:
         /**
          * @brief Read acceleration values for all axis
          *
-         * @return array<uint16_t, 3> [X,Y,Z] acceleration values
+         * @return array<uint16_t, 3> [X,Y,Z] acceleration values, zeros if read failed
          */
         std::array<int16_t, 3> Acceleration();
 
+        /**
+         * @brief Configure FIFO
+         *
+         * @param mode      Mode of FIFO
+         * @param threshold Number of samples which sets FIFO_FTH flag
+         * @return true     Configuration was written
+         */
+        bool Fifo(Fifo_mode mode, uint8_t threshold = 0);
+
+        /**
+         * @brief Return number of unread samples in FIFO, 0 if read failed
+         */
+        uint8_t Fifo_samples();
+
+        /**
+         * @brief Read all unread samples from FIFO by one burst transfer
+         *        Address of output registers rolls over from OUT_Z_H to OUT_X_L while FIFO is enabled
+         *
+         * @return Samples [X,Y,Z] samples from oldest, empty if read failed
+         */
+        Samples Drain();
+
+        /**
+         * @brief Decode sample from output registers
+         *
+         * @param data  sample_size bytes starting at OUT_X_L
+         */
+        static std::array<int16_t, 3> Sample(const uint8_t *data);
+
     };
@@ -10,6 +10,7 @@
 #include <stdint.h>
 
 #include "i2c/i2c_device.hpp"
+#include "i2c/register_map.hpp"
 
 /**
  * @brief   High-Accuracy, Low-Power, Digital Temperature Sensor with I2C Interface
@@ -39,6 +40,25 @@ public:
         One_shot = 0b11,
     };
 
+private:
+    /**
+     * @brief 8-bit pointer to 16-bit big-endian registers, pointer is not incremented during transfer
+     */
+    using Layout = Register_map::Layout<uint8_t, uint16_t, Register_map::Endian::Big, false>;
+
+public:
+    /**
+     * @brief Register map of sensor
+     */
+    struct Map {
+        using Temp_Result   = Register_map::Register<Layout, Registers::Temp_Result, Register_map::Access::Read_only, int16_t>;
+        using Configuration = Register_map::Register<Layout, Registers::Configuration>;
+        using Device_ID     = Register_map::Register<Layout, Registers::Device_ID, Register_map::Access::Read_only>;
+
+        using Mode          = Register_map::Field<Configuration, 0x0c00, TMP117::Mode>;
+        using Data_ready    = Register_map::Field<Configuration, 0x2000, bool>;
+    };
+
     /**
      * @brief Construct a new TMP117 object
      *
@@ -0,0 +1,307 @@
+#include "shell.hpp"
+
+#include <cstring>
+
+Shell::Shell(Serial_line &line, const char *prompt) :
+    line(&line), prompt(prompt)
+{
+    Register("help", &help_handler, "List available commands");
+}
+
+uint16_t Shell::Child(uint16_t node, char character) const{
+    uint16_t low = nodes[node].first;
+    uint16_t high = low + nodes[node].children;
+    while (low < high) {
+        uint16_t middle = (low + high) / 2;
+        char candidate = nodes[edges[middle]].character;
+        if (candidate == character) {
+            return edges[middle];
+        } else if (candidate < character) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return none;
+}
+
+uint16_t Shell::Insert(uint16_t node, char character){
+    uint16_t new_node = node_count++;
+    nodes[new_node] = Node();
+    nodes[new_node].character = character;
+
+    // Node without children starts its range at end of edges, other ranges are not affected
+    if (nodes[node].children == 0) {
+        nodes[node].first = edge_count;
+    }
+    uint16_t position = nodes[node].first;
+    while (position < nodes[node].first + nodes[node].children && nodes[edges[position]].character < character) {
+        position++;
+    }
+    memmove(&edges[position + 1], &edges[position], (edge_count - position) * sizeof(edges[0]));
+    edges[position] = new_node;
+    edge_count++;
+    for (uint16_t i = 0; i < new_node; i++) {
+        if (i != node && nodes[i].children > 0 && nodes[i].first >= position) {
+            nodes[i].first++;
+        }
+    }
+    nodes[node].children++;
+    return new_node;
+}
+
+uint16_t Shell::Walk(const char *text, size_t length) const{
+    uint16_t node = 0;
+    for (size_t i = 0; i < length && node != none; i++) {
+        node = Child(node, text[i]);
+    }
+    return node;
+}
+
+bool Shell::Register(const char *name, Handler *handler, const char *help){
+    if (name == nullptr || handler == nullptr || name[0] == '\0' || command_count >= HALUP_SHELL_COMMANDS) {
+        return false;
+    }
+    size_t length = strlen(name);
+    if (memchr(name, ' ', length) != nullptr || memchr(name, '"', length) != nullptr) {
+        return false;
+    }
+
+    // Find shared prefix with existing commands and check if remaining characters fit into trie
+    uint16_t node = 0;
+    size_t shared = 0;
+    while (shared < length) {
+        uint16_t child = Child(node, name[shared]);
+        if (child == none) {
+            break;
+        }
+        node = child;
+        shared++;
+    }
+    if (shared == length && nodes[node].command != none) {
+        return false;
+    }
+    if (node_count + (length - shared) > HALUP_SHELL_TRIE_NODES) {
+        return false;
+    }
+
+    // Insert missing characters, registration is done at start, so moving of edges does not matter
+    for (size_t i = shared; i < length; i++) {
+        node = Insert(node, name[i]);
+    }
+
+    nodes[node].command = command_count;
+    commands[command_count++] = {name, help, handler};
+    return true;
+}
+
+int Shell::Execute(char *text){
+    char *tokens[HALUP_SHELL_MAX_ARGUMENTS];
+    uint8_t count = 0;
+    char *position = text;
+
+    while (*position != '\0' && count < HALUP_SHELL_MAX_ARGUMENTS) {
+        while (*position == ' ') {
+            position++;
+        }
+        if (*position == '\0') {
+            break;
+        }
+        if (*position == '"') {
+            tokens[count++] = ++position;
+            while (*position != '\0' && *position != '"') {
+                position++;
+            }
+        } else {
+            tokens[count++] = position;
+            while (*position != '\0' && *position != ' ') {
+                position++;
+            }
+        }
+        if (*position != '\0') {
+            *position++ = '\0';
+        }
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+    while (*position == ' ') {
+        position++;
+    }
+    if (*position != '\0') {
+        line->Send("Too many arguments, maximum is ");
+        line->Send(HALUP_SHELL_MAX_ARGUMENTS - 1);
+        line->Send("\r\n");
+        return -1;
+    }
+
+    uint16_t node = Walk(tokens[0], strlen(tokens[0]));
+    if (node == none || nodes[node].command == none) {
+        line->Send("Unknown command: ");
+        line->Send(Serial_line::Text(tokens[0]));
+        line->Send("\r\n");
+        return -1;
+    }
+    return commands[nodes[node].command].handler->Invoke(Arguments{count, tokens});
+}
+
+unsigned int Shell::Process(){
+    Serial_line::Text received = line->Read(static_cast<int>(line->Buffer_size()));
+    for (char character : received) {
+        Input(character);
+    }
+    return received.length();
+}
+
+void Shell::Prompt(){
+    line->Send(prompt);
+}
+
+void Shell::Escape_input(char character){
+    uint8_t byte = static_cast<uint8_t>(character);
+    switch (escape) {
+        case Escape::Start:
+            escape = (character == '[') ? Escape::CSI : (character == 'O') ? Escape::SS3 : Escape::None;
+            return;
+        case Escape::CSI:
+            // Parameter (0x30-0x3f) and intermediate (0x20-0x2f) bytes continue sequence, final byte ends it
+            if (byte >= 0x20 && byte <= 0x3f) {
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+    escape = Escape::None;
+    if (character == 'A' && history_position < history_count) {
+        Recall(history_position + 1);
+    } else if (character == 'B' && history_position > 0) {
+        Recall(history_position - 1);
+    }
+}
+
+void Shell::Input(char character){
+    // Escape sequences: ESC [ A (up), ESC [ B (down), ESC O A/B in application mode, others are ignored
+    if (escape != Escape::None) {
+        Escape_input(character);
+        return;
+    }
+
+    bool line_feed_after_return = carriage_return && (character == '\n');
+    carriage_return = (character == '\r');
+
+    if (character == '\033') {
+        escape = Escape::Start;
+    } else if (line_feed_after_return) {
+        return;
+    } else if (character == '\r' || character == '\n') {
+        line->Send("\r\n");
+        edit_line[edit_length] = '\0';
+        if (edit_length > 0) {
+            Remember(edit_line, edit_length);
+        }
+        int result = Execute(edit_line);
+        if (result > 0 || result < -1) {
+            line->Send("Error: ");
+            line->Send(result);
+            line->Send("\r\n");
+        }
+        edit_length = 0;
+        history_position = 0;
+        Prompt();
+    } else if (character == '\b' || character == 0x7f) {
+        if (edit_length > 0) {
+            edit_length--;
+            line->Send("\b \b");
+        }
+    } else if (character == '\t') {
+        Complete();
+    } else if (character >= ' ' && character < 0x7f) {
+        if (edit_length < HALUP_SHELL_LINE_SIZE - 1) {
+            edit_line[edit_length++] = character;
+            line->Send(Serial_line::Text(1, character));
+        }
+    }
+}
+
+void Shell::Complete(){
+    if (memchr(edit_line, ' ', edit_length) != nullptr) {   // Only command names are completed
+        return;
+    }
+    uint16_t node = Walk(edit_line, edit_length);
+    if (node == none) {
+        return;
+    }
+
+    // Extend line while there is only one possible continuation
+    size_t original_length = edit_length;
+    while (nodes[node].command == none && nodes[node].children == 1) {
+        if (edit_length >= HALUP_SHELL_LINE_SIZE - 1) {
+            break;
+        }
+        node = edges[nodes[node].first];
+        edit_line[edit_length++] = nodes[node].character;
+    }
+
+    if (nodes[node].command != none && nodes[node].children == 0) {
+        if (edit_length < HALUP_SHELL_LINE_SIZE - 1) {
+            edit_line[edit_length++] = ' ';
+        }
+        line->Send(Serial_line::Text(edit_line + original_length, edit_length - original_length));
+    } else if (edit_length != original_length) {
+        line->Send(Serial_line::Text(edit_line + original_length, edit_length - original_length));
+    } else {    // Ambiguous, list candidates and reprint line
+        line->Send("\r\n");
+        List(node);
+        Prompt();
+        line->Send(Serial_line::Text(edit_line, edit_length));
+    }
+}
+
+void Shell::List(uint16_t node){
+    if (nodes[node].command != none) {
+        line->Send(commands[nodes[node].command].name);
+        line->Send("\r\n");
+    }
+    for (uint16_t edge = nodes[node].first; edge < nodes[node].first + nodes[node].children; edge++) {
+        List(edges[edge]);
+    }
+}
+
+void Shell::Remember(const char *text, uint8_t length){
+    if (history_count > 0 && strcmp(history[history_newest], text) == 0) {
+        return;
+    }
+    history_newest = (history_newest + 1) % HALUP_SHELL_HISTORY;
+    memcpy(history[history_newest], text, length);
+    history[history_newest][length] = '\0';
+    if (history_count < HALUP_SHELL_HISTORY) {
+        history_count++;
+    }
+}
+
+void Shell::Recall(uint8_t position){
+    history_position = position;
+    if (position == 0) {
+        edit_length = 0;
+    } else {
+        const char *entry = history[(history_newest + HALUP_SHELL_HISTORY - (position - 1)) % HALUP_SHELL_HISTORY];
+        edit_length = strlen(entry);
+        memcpy(edit_line, entry, edit_length);
+    }
+    line->Send("\r\033[K");
+    Prompt();
+    line->Send(Serial_line::Text(edit_line, edit_length));
+}
+
+int Shell::Help(Arguments arguments){
+    UNUSED_VAR(arguments);
+    for (uint16_t i = 0; i < command_count; i++) {
+        line->Send(commands[i].name);
+        line->Send(" - ");
+        line->Send(commands[i].help);
+        line->Send("\r\n");
+    }
+    return 0;
+}
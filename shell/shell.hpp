@@ -0,0 +1,268 @@
+/**
+ * @file shell.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "uart/serial_line.hpp"
+#include "misc/invocation_wrapper.hpp"
+
+/**
+ * @brief   Maximal length of command line
+ */
+#ifndef HALUP_SHELL_LINE_SIZE
+#define HALUP_SHELL_LINE_SIZE 96
+#endif
+
+/**
+ * @brief   Maximal number of tokens (command and arguments) on line
+ */
+#ifndef HALUP_SHELL_MAX_ARGUMENTS
+#define HALUP_SHELL_MAX_ARGUMENTS 8
+#endif
+
+/**
+ * @brief   Number of lines stored in history
+ */
+#ifndef HALUP_SHELL_HISTORY
+#define HALUP_SHELL_HISTORY 4
+#endif
+
+/**
+ * @brief   Maximal number of registered commands
+ */
+#ifndef HALUP_SHELL_COMMANDS
+#define HALUP_SHELL_COMMANDS 32
+#endif
+
+/**
+ * @brief   Maximal number of nodes of command trie, each character of command name which is not shared
+ *              with another command occupies one node
+ */
+#ifndef HALUP_SHELL_TRIE_NODES
+#define HALUP_SHELL_TRIE_NODES 256
+#endif
+
+/**
+ * @brief   Interactive command shell over serial line
+ *          Commands are stored in trie in static storage, children of node are sorted and found by binary search,
+ *              so lookup takes at most log2(95) comparisons per character of command name regardless of command count
+ *          Line is tokenized in place, handlers receive pointers into line buffer, no allocation is performed
+ *          Supports line editing by backspace, tab completion of command names and history (arrows up/down)
+ *          Other escape sequences of terminal (Delete, Home, End, function keys) are consumed and ignored
+ *
+ *          Handler example for register introspection of NFC tag:
+ *              int Dump(Shell::Arguments args){ line.Send(nfc.Format_register(ST25DV0xK::Registers_system::GPO)); return 0; }
+ *              shell.Register("gpo", new Invocation_wrapper<App, int, Shell::Arguments>(this, &App::Dump), "Print GPO register");
+ */
+class Shell {
+public:
+    /**
+     * @brief   Arguments of command, values[0] is name of command
+     */
+    struct Arguments {
+        uint8_t count;
+        char **values;
+    };
+
+    /**
+     * @brief   Handler of command, returned value is reported if not zero
+     */
+    using Handler = Invocation_wrapper_base<int, Arguments>;
+
+private:
+    /**
+     * @brief   Index which represents missing node or command
+     */
+    static constexpr uint16_t none = 0xffff;
+
+    /**
+     * @brief   Node of command trie, children of node are contiguous range of edges sorted by character
+     */
+    struct Node {
+        char character     = '\0';
+        uint8_t children   = 0;
+        uint16_t first     = 0;
+        uint16_t command   = none;
+    };
+
+    /**
+     * @brief   State of parser of escape sequences
+     */
+    enum class Escape: uint8_t {
+        None,
+        Start,      // ESC received
+        CSI,        // ESC [ received, parameters until final byte follow
+        SS3,        // ESC O received, single final byte follows (arrows in application mode)
+    };
+
+    /**
+     * @brief   Registered command
+     */
+    struct Command {
+        const char *name;
+        const char *help;
+        Handler *handler;
+    };
+
+    /**
+     * @brief   Serial line on which shell operates
+     */
+    Serial_line *line;
+
+    /**
+     * @brief   Prompt printed before every line
+     */
+    const char *prompt;
+
+    /**
+     * @brief   Nodes of command trie, node 0 is root
+     */
+    Node nodes[HALUP_SHELL_TRIE_NODES];
+    uint16_t node_count = 1;
+
+    /**
+     * @brief   Indexes of child nodes, children of every node are stored together sorted by character
+     */
+    uint16_t edges[HALUP_SHELL_TRIE_NODES];
+    uint16_t edge_count = 0;
+
+    /**
+     * @brief   Registered commands
+     */
+    Command commands[HALUP_SHELL_COMMANDS];
+    uint16_t command_count = 0;
+
+    /**
+     * @brief   Line which is currently edited
+     */
+    char edit_line[HALUP_SHELL_LINE_SIZE];
+    uint8_t edit_length = 0;
+
+    /**
+     * @brief   History of executed lines, stored as ring
+     */
+    char history[HALUP_SHELL_HISTORY][HALUP_SHELL_LINE_SIZE];
+    uint8_t history_count = 0;
+    uint8_t history_newest = 0;
+
+    /**
+     * @brief   Position in history during browsing, 0 is edited line, 1 is newest history entry
+     */
+    uint8_t history_position = 0;
+
+    /**
+     * @brief   State of parser of escape sequences
+     */
+    Escape escape = Escape::None;
+
+    /**
+     * @brief   Previous character was carriage return, following line feed is ignored
+     */
+    bool carriage_return = false;
+
+    /**
+     * @brief   Find child of node with given character by binary search
+     */
+    uint16_t Child(uint16_t node, char character) const;
+
+    /**
+     * @brief   Insert new node with given character as child of node, edges of following nodes are moved
+     *
+     * @return uint16_t Index of new node
+     */
+    uint16_t Insert(uint16_t node, char character);
+
+    /**
+     * @brief   Process character of escape sequence, arrows up and down browse history
+     */
+    void Escape_input(char character);
+
+    /**
+     * @brief   Walk trie along given text
+     *
+     * @return uint16_t Node reached at end of text, none if text is not prefix of any command
+     */
+    uint16_t Walk(const char *text, size_t length) const;
+
+    /**
+     * @brief   Print names of all commands in subtree of node
+     */
+    void List(uint16_t node);
+
+    /**
+     * @brief   Process one received character
+     */
+    void Input(char character);
+
+    /**
+     * @brief   Complete command name in edited line
+     */
+    void Complete();
+
+    /**
+     * @brief   Replace edited line by entry from history
+     */
+    void Recall(uint8_t position);
+
+    /**
+     * @brief   Store line into history
+     */
+    void Remember(const char *text, uint8_t length);
+
+    /**
+     * @brief   Built-in command help
+     */
+    int Help(Arguments arguments);
+
+    /**
+     * @brief   Wrapper of built-in command help
+     */
+    Invocation_wrapper<Shell, int, Arguments> help_handler{this, &Shell::Help};
+
+public:
+    /**
+     * @brief Construct a new Shell object, built-in command help is registered
+     *
+     * @param line      Serial line on which shell operates
+     * @param prompt    Prompt printed before every line
+     */
+    Shell(Serial_line &line, const char *prompt = "> ");
+
+    /**
+     * @brief   Register new command
+     *
+     * @param name      Name of command, string must be valid during whole life of shell
+     * @param handler   Handler of command
+     * @param help      Description of command printed by help
+     * @return true     Command was registered
+     * @return false    Command already exists, name is invalid or there is no space for command
+     */
+    bool Register(const char *name, Handler *handler, const char *help = "");
+
+    /**
+     * @brief   Tokenize line in place and invoke handler of command
+     *          Tokens are separated by spaces, double quotes group text with spaces into single token
+     *
+     * @param text      Line to execute, is modified by tokenization
+     * @return int      Value returned by handler, -1 if command is unknown or line has too many tokens, 0 for empty line
+     */
+    int Execute(char *text);
+
+    /**
+     * @brief   Process characters received by serial line, should be called periodically or after line notification
+     *
+     * @return unsigned int Number of processed characters
+     */
+    unsigned int Process();
+
+    /**
+     * @brief   Print prompt, used after start of shell
+     */
+    void Prompt();
+};
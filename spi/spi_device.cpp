@@ -0,0 +1,106 @@
+#include "spi_device.hpp"
+
+SPI_device::SPI_device(SPI_master &master, Pin *chip_select, uint8_t read_flag, uint8_t increment_flag) :
+    master(&master), chip_select(chip_select), read_flag(read_flag), increment_flag(increment_flag)
+{
+    Deselect();
+}
+
+void SPI_device::Select(){
+    if (chip_select) {
+        chip_select->Set(false);
+    }
+}
+
+void SPI_device::Deselect(){
+    if (chip_select) {
+        chip_select->Set(true);
+    }
+}
+
+Byte_vector SPI_device::Header(uint16_t address, uint8_t address_size, bool read, unsigned int length) const{
+    Byte_vector header(address_size);
+    for (uint8_t i = 0; i < address_size; i++) {
+        header[i] = static_cast<uint8_t>(address >> (8 * (address_size - 1 - i)));
+    }
+    if (read) {
+        header[0] |= read_flag;
+    }
+    if (length > 1) {
+        header[0] |= increment_flag;
+    }
+    return header;
+}
+
+bool SPI_device::Transmit(const Byte_vector &data){
+    // Chip select of other device is asserted during its DMA transfer
+    if (master->Busy()) {
+        return false;
+    }
+    Select();
+    bool result = master->Transmit(data.data(), data.size());
+    Deselect();
+    return result;
+}
+
+std::optional<Byte_vector> SPI_device::Receive(unsigned int length){
+    Byte_vector data(length);
+    if (data.size() < length || master->Busy()) {
+        return {};
+    }
+    Select();
+    bool result = master->Receive(data.data(), length);
+    Deselect();
+    if (!result) {
+        return {};
+    }
+    return data;
+}
+
+std::optional<Byte_vector> SPI_device::Transfer(const Byte_vector &data){
+    Byte_vector received(data.size());
+    if (master->Busy()) {
+        return {};
+    }
+    Select();
+    bool result = master->Transfer(data.data(), received.data(), data.size());
+    Deselect();
+    if (!result) {
+        return {};
+    }
+    return received;
+}
+
+std::optional<Byte_vector> SPI_device::Read_registers(uint16_t address, uint8_t address_size, unsigned int length){
+    Byte_vector header = Header(address, address_size, true, length);
+    Byte_vector data(length);
+    if (data.size() < length || master->Busy()) {
+        return {};
+    }
+    // Address and data are transferred in same frame of chip select
+    Select();
+    bool result = master->Transmit(header.data(), header.size()) && master->Receive(data.data(), length);
+    Deselect();
+    if (!result) {
+        return {};
+    }
+    return data;
+}
+
+bool SPI_device::Write_registers(uint16_t address, uint8_t address_size, const Byte_vector &data){
+    Byte_vector frame = Header(address, address_size, false, data.size());
+    frame.insert(frame.end(), data.begin(), data.end());
+    return Transmit(frame);
+}
+
+bool SPI_device::Read_DMA(uint16_t address, uint8_t address_size, uint16_t length, Invocation_wrapper_base<void, bool> *callback){
+    if (master->Busy()) {
+        return false;
+    }
+    dma_transmit = Header(address, address_size, true, length);
+    dma_header = address_size;
+    dma_transmit.resize(address_size + length, 0x00);
+    dma_receive.assign(dma_transmit.size(), 0x00);
+    Select();
+    return master->Transfer_DMA(dma_transmit.data(), dma_receive.data(), dma_transmit.size(), chip_select, callback);
+}
@@ -0,0 +1,121 @@
+/**
+ * @file spi_device.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "misc/register_device.hpp"
+#include "spi/spi_master.hpp"
+
+/**
+ * @brief   Device connected to SPI bus with own chip select
+ *          Register access follows convention of sensors: address of register is transmitted first,
+ *              read is marked by flag in first byte of address, data follow in same frame of chip select
+ *          Example of ST sensors: read flag 0x80, some parts require also flag of address increment (0x40)
+ */
+class SPI_device : public Register_device {
+private:
+    SPI_master *master = nullptr;
+
+    /**
+     * @brief   Chip select of device, active in low level, nullptr if chip select is driven by peripheral
+     */
+    Pin *chip_select = nullptr;
+
+    /**
+     * @brief   Flag added to first byte of register address during read
+     */
+    uint8_t read_flag = 0x80;
+
+    /**
+     * @brief   Flag added to first byte of register address during transfer of multiple bytes
+     */
+    uint8_t increment_flag = 0x00;
+
+    /**
+     * @brief   Buffers of DMA read, valid until next DMA read
+     */
+    Byte_vector dma_transmit;
+    Byte_vector dma_receive;
+
+    /**
+     * @brief   Number of address bytes at start of DMA buffers
+     */
+    uint8_t dma_header = 0;
+
+    /**
+     * @brief   Return register address with flags, which is transmitted before data
+     */
+    Byte_vector Header(uint16_t address, uint8_t address_size, bool read, unsigned int length) const;
+
+    void Select();
+
+    void Deselect();
+
+public:
+    SPI_device() = default;
+
+    /**
+     * @brief Construct a new SPI_device object
+     *
+     * @param master            SPI bus to which is device connected, must outlive device
+     * @param chip_select       Chip select of device, nullptr if driven by peripheral
+     * @param read_flag         Flag of read in first byte of register address
+     * @param increment_flag    Flag of address increment in first byte of register address
+     */
+    SPI_device(SPI_master &master, Pin *chip_select, uint8_t read_flag = 0x80, uint8_t increment_flag = 0x00);
+
+    /**
+     * @brief   Transmit data to device in one frame of chip select
+     *
+     * @return true     Data were transmitted
+     */
+    bool Transmit(const Byte_vector &data);
+
+    /**
+     * @brief   Receive data from device in one frame of chip select
+     *
+     * @param length    Number of bytes to be received
+     * @return std::optional<Byte_vector>  Received data, empty if transfer failed
+     */
+    std::optional<Byte_vector> Receive(unsigned int length);
+
+    /**
+     * @brief   Full duplex transfer in one frame of chip select
+     *
+     * @return std::optional<Byte_vector>  Data received during transfer, empty if transfer failed
+     */
+    std::optional<Byte_vector> Transfer(const Byte_vector &data);
+
+    std::optional<Byte_vector> Read_registers(uint16_t address, uint8_t address_size, unsigned int length) override;
+
+    bool Write_registers(uint16_t address, uint8_t address_size, const Byte_vector &data) override;
+
+    /**
+     * @brief   Start read of registers by DMA, chip select is released after completion
+     *          Received data are available by Data() after callback is invoked
+     *
+     * @param address       Address of first register
+     * @param address_size  Size of register address in bytes
+     * @param length        Number of bytes to read
+     * @param callback      Invoked after completion with result of transfer
+     * @return true         Transfer was started
+     */
+    bool Read_DMA(uint16_t address, uint8_t address_size, uint16_t length, Invocation_wrapper_base<void, bool> *callback);
+
+    /**
+     * @brief   Return data received by last DMA read
+     */
+    const uint8_t *Data() const { return dma_receive.data() + dma_header; };
+
+    /**
+     * @brief   Return bus of device
+     */
+    SPI_master &Master() const { return *master; };
+};
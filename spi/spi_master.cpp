@@ -0,0 +1,92 @@
+#include "spi_master.hpp"
+
+#include "misc/probe.hpp"
+#include "trace/bus_trace.hpp"
+
+SPI_master::SPI_master(SPI_HandleTypeDef *handler, uint32_t speed, uint8_t index) :
+    handler(handler), speed(speed), index(index)
+{
+    instances.Insert(handler, this);
+}
+
+SPI_master::~SPI_master(){
+    if (Of(handler) == this) {
+        instances.Erase(handler);
+    }
+}
+
+uint32_t SPI_master::Timeout(uint32_t length) const{
+    uint32_t bus_speed = speed ? speed : 1000000;
+    // One more ms because tick can increment right after start of transfer
+    return (8 * length * 1000 + bus_speed - 1) / bus_speed + 1;
+}
+
+bool SPI_master::Transmit(const uint8_t *data, uint16_t length){
+    HALUP_PROBE("spi.transmit");
+    if (busy) {
+        return false;
+    }
+    uint32_t start = Bus_trace::Start();
+    HAL_StatusTypeDef status = HAL_SPI_Transmit(handler, const_cast<uint8_t *>(data), length, Timeout(length));
+    Bus_trace::Record(Trace::Bus::SPI, index, length ? data[0] : 0, Trace::Operation::Transmit, status, handler->ErrorCode, length, start);
+    return status == HAL_OK;
+}
+
+bool SPI_master::Receive(uint8_t *data, uint16_t length){
+    HALUP_PROBE("spi.receive");
+    if (busy) {
+        return false;
+    }
+    uint32_t start = Bus_trace::Start();
+    HAL_StatusTypeDef status = HAL_SPI_Receive(handler, data, length, Timeout(length));
+    Bus_trace::Record(Trace::Bus::SPI, index, 0, Trace::Operation::Receive, status, handler->ErrorCode, length, start);
+    return status == HAL_OK;
+}
+
+bool SPI_master::Transfer(const uint8_t *transmit, uint8_t *receive, uint16_t length){
+    HALUP_PROBE("spi.transfer");
+    if (busy) {
+        return false;
+    }
+    uint32_t start = Bus_trace::Start();
+    HAL_StatusTypeDef status = HAL_SPI_TransmitReceive(handler, const_cast<uint8_t *>(transmit), receive, length, Timeout(length));
+    Bus_trace::Record(Trace::Bus::SPI, index, length ? transmit[0] : 0, Trace::Operation::Receive, status, handler->ErrorCode, length, start);
+    return status == HAL_OK;
+}
+
+bool SPI_master::Transfer_DMA(const uint8_t *transmit, uint8_t *receive, uint16_t length, Pin *chip_select, Invocation_wrapper_base<void, bool> *callback){
+    if (busy || length == 0) {
+        return false;
+    }
+    busy = true;
+    dma_select = chip_select;
+    dma_callback = callback;
+    dma_command = transmit[0];
+    dma_length = length;
+    dma_start = Bus_trace::Start();
+    if (HAL_SPI_TransmitReceive_DMA(handler, const_cast<uint8_t *>(transmit), receive, length) != HAL_OK) {
+        busy = false;
+        if (chip_select) {
+            chip_select->Set(true);
+        }
+        Bus_trace::Record(Trace::Bus::SPI, index, dma_command, Trace::Operation::Receive, HAL_ERROR, handler->ErrorCode, length, dma_start);
+        return false;
+    }
+    return true;
+}
+
+void SPI_master::Complete(bool success){
+    if (!busy) {
+        return;
+    }
+    if (dma_select) {
+        dma_select->Set(true);
+    }
+    Bus_trace::Record(Trace::Bus::SPI, index, dma_command, Trace::Operation::Receive, success ? HAL_OK : HAL_ERROR,
+                      handler->ErrorCode, dma_length, dma_start);
+    busy = false;
+    // Callback can start next transfer
+    if (dma_callback) {
+        dma_callback->Invoke(success);
+    }
+}
@@ -0,0 +1,156 @@
+/**
+ * @file spi_master.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "global_includes.hpp"
+#include "gpio/pin.hpp"
+#include "misc/handle_map.hpp"
+#include "misc/invocation_wrapper.hpp"
+
+/**
+ * @brief   Maximal number of SPI_master objects which receive HAL callbacks
+ */
+#ifndef HALUP_SPI_BUSES
+#define HALUP_SPI_BUSES 4
+#endif
+
+/**
+ * @brief   SPI bus in master role, chip select of devices is driven by SPI_device
+ *          Blocking transfers use timeout computed from length and speed of bus,
+ *              DMA transfer releases chip select and invokes callback after completion
+ *          Object is registered under its HAL handle, completion of DMA is forwarded from HAL callbacks
+ *              by SPI_master::Of (see misc/hal_callbacks.hpp):
+ *              void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi){ SPI_master::Of(hspi)->Complete(); }
+ *              void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi){ SPI_master::Of(hspi)->Complete(false); }
+ */
+class SPI_master {
+private:
+    SPI_HandleTypeDef *handler = nullptr;
+
+    /**
+     * @brief   Speed of bus (SCK) in Hz
+     */
+    uint32_t speed = 1000000;
+
+    /**
+     * @brief   Index of bus in records of Bus_trace
+     */
+    uint8_t index = 0;
+
+    /**
+     * @brief   True while DMA transfer is in progress, blocking transfers are refused meanwhile
+     */
+    volatile bool busy = false;
+
+    /**
+     * @brief   Chip select and callback of running DMA transfer
+     */
+    Pin *dma_select = nullptr;
+    Invocation_wrapper_base<void, bool> *dma_callback = nullptr;
+
+    /**
+     * @brief   First byte, length and start of running DMA transfer, used by Bus_trace
+     */
+    uint8_t dma_command = 0;
+    uint16_t dma_length = 0;
+    uint32_t dma_start = 0;
+
+    /**
+     * @brief   Objects of SPI buses indexed by their HAL handles
+     */
+    static inline Handle_map<SPI_HandleTypeDef, SPI_master *, HALUP_SPI_BUSES> instances;
+
+public:
+    SPI_master() = default;
+
+    /**
+     * @brief Construct a new SPI_master object
+     *
+     * @param handler   HAL handler of SPI peripheral
+     * @param speed     Speed of bus in Hz, used for computation of timeouts
+     * @param index     Index of bus in records of Bus_trace
+     */
+    SPI_master(SPI_HandleTypeDef *handler, uint32_t speed = 1000000, uint8_t index = 0);
+
+    /**
+     * @brief   Remove SPI_master from routing of HAL callbacks
+     */
+    ~SPI_master();
+
+    // HAL callbacks keep address of object
+    SPI_master(const SPI_master &) = delete;
+    SPI_master &operator=(const SPI_master &) = delete;
+
+    /**
+     * @brief   Return SPI_master object of HAL handle, used by HAL callbacks
+     *
+     * @param handle        Handle which triggered callback
+     * @return SPI_master*  Object constructed with handle, null if there is no such object
+     */
+    static SPI_master *Of(const SPI_HandleTypeDef *handle){
+        SPI_master **instance = instances.Find(handle);
+        return instance ? *instance : nullptr;
+    };
+
+    /**
+     * @brief   Return timeout of blocking transfer in ms
+     *
+     * @param length    Number of transferred bytes
+     */
+    uint32_t Timeout(uint32_t length) const;
+
+    /**
+     * @brief   Transmit data, received bytes are discarded
+     *
+     * @return true     Data were transmitted
+     */
+    bool Transmit(const uint8_t *data, uint16_t length);
+
+    /**
+     * @brief   Receive data, dummy bytes are transmitted meanwhile
+     *
+     * @return true     Data were received
+     */
+    bool Receive(uint8_t *data, uint16_t length);
+
+    /**
+     * @brief   Full duplex transfer, every transmitted byte is exchanged for received byte
+     *
+     * @param transmit  Transmitted data
+     * @param receive   Buffer for received data of same length
+     * @return true     Transfer was successful
+     */
+    bool Transfer(const uint8_t *transmit, uint8_t *receive, uint16_t length);
+
+    /**
+     * @brief   Start full duplex transfer by DMA, buffers must be valid until completion
+     *          Chip select must be already activated, it is released by Complete() or when transfer cannot be started
+     *
+     * @param transmit      Transmitted data
+     * @param receive       Buffer for received data of same length
+     * @param chip_select   Chip select of device, can be nullptr
+     * @param callback      Invoked after completion with result of transfer, can be nullptr
+     * @return true         Transfer was started
+     * @return false        Bus is busy or transfer cannot be started
+     */
+    bool Transfer_DMA(const uint8_t *transmit, uint8_t *receive, uint16_t length, Pin *chip_select, Invocation_wrapper_base<void, bool> *callback);
+
+    /**
+     * @brief   Finish DMA transfer, called from HAL_SPI_TxRxCpltCallback or HAL_SPI_ErrorCallback
+     *
+     * @param success   False if transfer was finished by error
+     */
+    void Complete(bool success = true);
+
+    /**
+     * @brief   Return true if DMA transfer is in progress
+     */
+    bool Busy() const { return busy; };
+};
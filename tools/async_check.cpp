@@ -0,0 +1,208 @@
+/**
+ * @file async_check.cpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ *
+ * Host check of coroutines, several coroutines run concurrently in Run_loop against simulated I2C bus, UART and RTC
+ * Covers symmetric transfer between tasks, release of detached frames, completion inside Start() and exhaustion of frame pool
+ * Usage: async_check, returns 0 if all checks passed
+ * Build: g++ -std=c++20 -DMCU_FAMILY_HOST -DHALUP_HAL_CALLBACKS=1 -I.. async_check.cpp <sources> -o async_check
+ *        sources are all .cpp files of host, i2c and async
+ *            and gpio/pin.cpp, spi/spi_master.cpp, spi/spi_device.cpp, uart/serial_line.cpp, uart/uart.cpp,
+ *            rtc/rtc.cpp, rtc/rtc_timer.cpp, power/run_loop.cpp, misc/hal_callbacks.cpp, misc/probe.cpp,
+ *            trace/bus_trace.cpp, trace/trace_record.cpp
+ */
+
+#include <cstdio>
+#include <optional>
+
+#include "async/awaitable.hpp"
+#include "host/simulated_devices.hpp"
+#include "host/simulated_power.hpp"
+#include "host/simulated_uart.hpp"
+#include "host/virtual_clock.hpp"
+#include "power/run_loop.hpp"
+#include "uart/uart.hpp"
+
+namespace {
+    unsigned int failures = 0;
+
+    void Check(bool condition, const char *name){
+        std::printf("%s %s\n", condition ? "ok  " : "FAIL", name);
+        if (not condition) {
+            failures++;
+        }
+    }
+
+    /**
+     * @brief   One-shot measurement of TMP117, example of awaitable.hpp
+     */
+    Async::Task<std::optional<int16_t>> Measure(I2C_device &sensor, RTC_timer_wheel &wheel){
+        Byte_vector one_shot = {0x0c, 0x00};
+        bool configured = co_await Async::Write(sensor, 0x01, 1, one_shot);
+        if (!configured) {
+            co_return std::nullopt;
+        }
+        co_await Async::Sleep_for(wheel, 16);
+        auto data = co_await Async::Read(sensor, 0x00, 1, 2);
+        if (!data) {
+            co_return std::nullopt;
+        }
+        co_return static_cast<int16_t>(((*data)[0] << 8) | (*data)[1]);
+    }
+
+    /**
+     * @brief   Read given number of lines, runs detached
+     */
+    Async::Task<> Read_lines(Serial_line &line, int count, string &received){
+        for (int i = 0; i < count; i++) {
+            received += co_await Async::Line(line);
+        }
+    }
+
+    /**
+     * @brief   Periodic work interleaved with other coroutines, runs detached
+     */
+    Async::Task<> Tick(RTC_timer_wheel &wheel, int count, int &ticks){
+        for (int i = 0; i < count; i++) {
+            co_await Async::Sleep_for(wheel, 5);
+            ticks++;
+        }
+    }
+
+    /**
+     * @brief   Chain of tasks which finish without suspension, continuation is resumed by symmetric transfer
+     */
+    Async::Task<int> Depth(int level){
+        if (level == 0) {
+            co_return 0;
+        }
+        int below = co_await Depth(level - 1);
+        co_return below + 1;
+    }
+
+    /**
+     * @brief   Operation whose callback is invoked before Start() returns, like transfer finished by IRQ of higher priority
+     */
+    class Immediate : public Async::Completion<bool> {
+    private:
+        bool Start() override {
+            Invoke(true);
+            return true;
+        };
+
+    public:
+        bool await_resume() const { return result && done; };
+    };
+
+    Async::Task<> Complete_immediately(int &resumed){
+        bool result = co_await Immediate();
+        resumed += result ? 1 : 100;
+    }
+
+    Async::Task<> Idle(){
+        co_return;
+    }
+
+    Async::Task<int> Await_invalid(Async::Task<int> &&invalid){
+        int value = co_await std::move(invalid);
+        co_return value + 1;
+    }
+}
+
+int main(){
+    Simulated_I2C_bus bus(400000);
+    I2C_HandleTypeDef hi2c = {&bus, 0};
+    Simulated_TMP117 tmp117_model(0x90);
+    bus.Attach(tmp117_model);
+    tmp117_model.Temperature(23.5f);
+    I2C_master master(&hi2c, 400000);
+    I2C_device tmp117(master, 0x90);
+
+    Simulated_UART console_port(115200);
+    UART_HandleTypeDef hconsole = {&console_port, 0};
+    UART console(&hconsole);
+    console.Receive();      // Arms reception, stores empty temporal buffer
+    console.Clear_buffer();
+
+    RTC_internal rtc;
+    rtc.Init();
+    RTC_timer_wheel wheel(rtc, 1);
+    Simulated_power power(rtc);
+    Run_loop loop(power, &wheel);
+    Invocation_wrapper<Run_loop, void, void> loop_wake(&loop, &Run_loop::Wake);
+    wheel.Wake_notification(&loop_wake);
+    console.Wake_notification(&loop_wake);
+    Async::Scheduler::Attach(loop);
+
+    // Concurrent coroutines, owned measurement is started directly, others are detached
+    string received;
+    int ticks = 0;
+    auto measure = Measure(tmp117, wheel);
+    measure.Start();
+    Check(Async::Scheduler::Spawn(Read_lines(console, 2, received)), "spawn reader");
+    Check(Async::Scheduler::Spawn(Tick(wheel, 3, ticks)), "spawn ticker");
+    console_port.Inject("HELLO\r\n", 4000000);
+    console_port.Inject("WORLD\r\n", 8000000);
+
+    uint64_t start = Virtual_clock::Now();
+    for (int i = 0; i < 1000 && not (measure.Done() && ticks == 3 && received.size() == 14); i++) {
+        loop.Iterate();
+    }
+    uint64_t elapsed = Virtual_clock::Now() - start;
+
+    Check(measure.Done() && measure.Result().has_value() && measure.Result()->has_value(), "measurement finished");
+    Check(measure.Done() && **measure.Result() == static_cast<int16_t>(23.5f / 0.0078125f), "measured temperature");
+    Check(elapsed >= 16000000 && elapsed < 25000000, "measurement slept 16 ms");
+    Check(ticks == 3, "ticker woke 3 times");
+    Check(received == "HELLO\r\nWORLD\r\n", "lines received");
+    Check(Async::Scheduler::Idle(), "scheduler idle");
+    Check(Async::Frame_pool::Used() == 1, "detached frames released");
+    measure = {};
+    Check(Async::Frame_pool::Used() == 0, "owned frame released");
+
+    // Six nested tasks finish within one Start(), each resumes its caller from final suspension
+    auto depth = Depth(6);
+    depth.Start();
+    Check(depth.Done() && depth.Result() == 6, "symmetric transfer through nested tasks");
+    depth = {};
+
+    // Callback invoked inside Start() queues coroutine, which is resumed once by Scheduler
+    int resumed = 0;
+    auto immediate = Complete_immediately(resumed);
+    immediate.Start();
+    Check(resumed == 0 && not Async::Scheduler::Idle(), "completion inside Start queues coroutine");
+    Async::Scheduler::Run();
+    Check(resumed == 1 && immediate.Done() && Async::Scheduler::Idle(), "completion inside Start resumes once");
+    immediate = {};
+
+    // Exhausted pool creates invalid task, which is refused by Spawn and awaited with default result
+    Async::Task<> held[Async::Frame_pool::frames];
+    for (auto &task : held) {
+        task = Idle();
+    }
+    uint32_t refused = Async::Frame_pool::Failures();
+    Check(Async::Frame_pool::Used() == Async::Frame_pool::frames, "pool exhausted");
+    Async::Task<> overflow = Idle();
+    Check(not overflow.Valid() && not overflow.Done(), "exhausted pool gives invalid task");
+    Check(not Async::Scheduler::Spawn(Idle()), "spawn of invalid task is refused");
+    Async::Task<int> invalid = Depth(1);
+    Check(Async::Frame_pool::Failures() == refused + 3, "refused allocations counted");
+    held[0] = {};
+    auto awaiting = Await_invalid(std::move(invalid));
+    awaiting.Start();
+    Check(awaiting.Done() && awaiting.Result() == 1, "invalid task awaited with default result");
+    awaiting = {};
+    for (auto &task : held) {
+        task = {};
+    }
+    Check(Async::Frame_pool::Used() == 0, "all frames released");
+
+    std::printf("peak frames %u, refused allocations %u\n", Async::Frame_pool::Peak(), Async::Frame_pool::Failures());
+    if (failures) {
+        std::printf("%u checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,398 @@
+/**
+ * @file benchmark.cpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ *
+ * Host benchmark of public operations of drivers against simulated hardware
+ * Reports wall time, heap allocations, I2C transactions, bytes, modeled bus time and elapsed simulated time per operation
+ * Usage: benchmark [--json] [--filter text] [--batch operations] [--batches count]
+ * Build: g++ -std=c++17 -O2 -DMCU_FAMILY_HOST -DHALUP_HAL_CALLBACKS=1 -I.. benchmark.cpp ../benchmark/benchmark.cpp <sources> -o benchmark
+ *        sources are all .cpp files of host, i2c, spi, sensors, nfc and memory/eeprom
+ *            and gpio/pin.cpp, uart/serial_line.cpp, uart/uart.cpp, rtc/rtc.cpp, rtc/rtc_timer.cpp, misc/probe.cpp,
+ *            misc/hal_callbacks.cpp, usb/usb_cdc.cpp, trace/bus_trace.cpp, trace/trace_record.cpp,
+ *            codec/sample_encoder.cpp, log/logger.cpp, log/log_record.cpp, power/run_loop.cpp
+ */
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "benchmark/benchmark.hpp"
+#include "codec/sample_encoder.hpp"
+#include "color.hpp"
+#include "host/simulated_devices.hpp"
+#include "host/simulated_power.hpp"
+#include "host/virtual_clock.hpp"
+#include "i2c/i2c_bus_group.hpp"
+#include "i2c/i2c_device.hpp"
+#include "i2c/i2c_registry.hpp"
+#include "log/logger.hpp"
+#include "misc/invocation_wrapper.hpp"
+#include "misc/number_format.hpp"
+#include "nfc/ST25DV0xK.hpp"
+#include "power/run_loop.hpp"
+#include "rtc/rtc_timer.hpp"
+#include "sensors/LIS2DW12.hpp"
+#include "sensors/TMP117.hpp"
+#include "uart/serial_line.hpp"
+#include "uart/uart.hpp"
+
+namespace {
+    /**
+     * @brief   Serial line without transport, received data are pushed directly into RX buffer
+     */
+    class Benchmark_line : public Serial_line {
+    public:
+        using Serial_line::Send;
+
+        int Send(Text message) override { return message.length(); };
+
+        int Receive() override { return 0; };
+
+        void Push(const string &data){
+            RX_buffer.append(data);
+            Received();
+        }
+    };
+
+    class Counter {
+    public:
+        uint32_t value = 0;
+
+        void Increment(){ value++; };
+    };
+
+    /**
+     * @brief   Sensor with data ready interrupt, IRQ only sets flag and wakes run loop, task reads temperature
+     */
+    class Data_ready {
+    public:
+        Run_loop *loop;
+        TMP117 *sensor;
+        bool ready = false;
+        uint32_t processed = 0;
+
+        Data_ready(Run_loop &loop, TMP117 &sensor) :
+            loop(&loop), sensor(&sensor)
+        { }
+
+        void Interrupt(){
+            ready = true;
+            loop->Wake();
+        };
+
+        bool Poll(){
+            if (not ready) {
+                return false;
+            }
+            ready = false;
+            sensor->Temperature();
+            processed++;
+            return true;
+        };
+    };
+
+    /**
+     * @brief   Task which reads commands terminated by CRLF from serial line
+     */
+    class Command_reader {
+    public:
+        Serial_line *line;
+        uint32_t commands = 0;
+
+        Command_reader(Serial_line &line) :
+            line(&line)
+        { }
+
+        bool Poll(){
+            if (not line->Line_available("\r\n")) {
+                return false;
+            }
+            line->Read(string("\r\n"));
+            commands++;
+            return true;
+        };
+    };
+}
+
+int main(int argc, char *argv[]){
+    bool json = false;
+    std::string filter;
+    uint32_t batch_size = 1000;
+    uint32_t batches = 10;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batch_size = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--batches") == 0 && i + 1 < argc) {
+            batches = std::atoi(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--json] [--filter text] [--batch operations] [--batches count]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Simulated hardware, EEPROM without write cycle so writes can follow each other
+    Simulated_I2C_bus bus(400000);
+    I2C_HandleTypeDef hi2c = {&bus, 0};
+    Simulated_TMP117 tmp117_model(0x90);
+    Simulated_LIS2DW12 lis2dw12_model(0x32);
+    Simulated_M24xx eeprom_model(0xa0, 4096, 32, 0);
+    Simulated_ST25DV st25dv_model(2048);
+    bus.Attach(tmp117_model);
+    bus.Attach(lis2dw12_model);
+    bus.Attach(eeprom_model);
+    bus.Attach(st25dv_model);
+    tmp117_model.Temperature(21.5f);
+    lis2dw12_model.Acceleration(120, -340, 16000);
+
+    I2C_master master(&hi2c, 400000);
+    I2C_device eeprom(master, 0xa0);
+    TMP117 tmp117(master, 0x90);
+    LIS2DW12 lis2dw12(master, 0x32);
+    ST25DV0xK st25dv(master, 0xae, nullptr, 16);
+    I2C_registry registry(master);
+
+    Benchmark_line line;
+
+    // Sent messages are transmitted by UART, Send waits for space in TX buffer, so bytes and time on wire are measured
+    Simulated_UART serial(115200);
+    UART_HandleTypeDef huart = {&serial, 0};
+    serial.Capture(false);
+    UART uart(&huart);
+    uart.Overflow_policy(UART::Overflow::Block, 1000);
+    auto drain = [&](uint32_t){
+        while (uart.Busy()) {
+            Virtual_clock::Wait_for_interrupt();
+        }
+    };
+    Counter counter;
+    Invocation_wrapper<Counter, void, void> wrapper(&counter, &Counter::Increment);
+    Invocation_wrapper_base<void, void> *callback = &wrapper;
+
+    // Board with three I2C peripherals, six sensors are placed round robin on first one, two or three buses
+    Simulated_I2C_bus board_buses[3] = {Simulated_I2C_bus(400000), Simulated_I2C_bus(400000), Simulated_I2C_bus(400000)};
+    I2C_HandleTypeDef board_handles[3] = {{&board_buses[0], 0}, {&board_buses[1], 0}, {&board_buses[2], 0}};
+    Simulated_TMP117 board_tmp117[4] = {Simulated_TMP117(0x90), Simulated_TMP117(0x92), Simulated_TMP117(0x94), Simulated_TMP117(0x96)};
+    Simulated_LIS2DW12 board_lis2dw12[2] = {Simulated_LIS2DW12(0x30), Simulated_LIS2DW12(0x32)};
+    Simulated_I2C_device *board_models[6] = {
+        &board_tmp117[0], &board_lis2dw12[0], &board_tmp117[1], &board_lis2dw12[1], &board_tmp117[2], &board_tmp117[3]
+    };
+    const uint8_t board_addresses[6] = {0x90, 0x30, 0x92, 0x32, 0x94, 0x96};
+    const uint8_t board_registers[6] = {0x00, 0xa8, 0x00, 0xa8, 0x00, 0x00};  // Temperature, acceleration with increment
+    const uint8_t board_lengths[6] = {2, 6, 2, 6, 2, 2};
+    uint8_t board_data[6][6];
+    I2C_master board_masters[3] = {
+        I2C_master(&board_handles[0], 400000, 1), I2C_master(&board_handles[1], 400000, 2), I2C_master(&board_handles[2], 400000, 3)
+    };
+
+    I2C_bus_group groups[3];
+    for (uint8_t buses = 1; buses <= 3; buses++) {
+        I2C_bus_group &group = groups[buses - 1];
+        for (uint8_t i = 0; i < buses; i++) {
+            group.Add(board_masters[i]);
+        }
+        for (uint8_t i = 0; i < 6; i++) {
+            group.Read(I2C_device(board_masters[i % buses], board_addresses[i]), board_registers[i], 1, board_data[i], board_lengths[i]);
+        }
+    }
+
+    auto place = [&](uint8_t buses){
+        for (auto &board_bus : board_buses) {
+            for (auto model : board_models) {
+                board_bus.Detach(*model);
+            }
+        }
+        for (uint8_t i = 0; i < 6; i++) {
+            board_buses[i % buses].Attach(*board_models[i]);
+        }
+    };
+
+    auto read_all = [&](I2C_bus_group &group){
+        group.Start();
+        while (group.Busy()) {
+            Virtual_clock::Wait_for_interrupt();
+        }
+    };
+
+    Benchmark benchmark(batch_size, batches);
+    benchmark.Observe(bus);
+    benchmark.Observe(serial);
+    for (auto &board_bus : board_buses) {
+        benchmark.Observe(board_bus);
+    }
+
+    benchmark.Register("i2c_device/read_u8_1", [&](){ eeprom.Read<uint8_t>(0x10, 1); });
+    benchmark.Register("i2c_device/read_u16_32", [&](){ eeprom.Read<uint16_t>(0x0100, 32); });
+    benchmark.Register("i2c_device/write_u16_4", [&](){ eeprom.Write<uint16_t>(0x0200, {1, 2, 3, 4}); });
+    benchmark.Register("i2c_device/write_u16_32", [&](){ eeprom.Write<uint16_t>(0x0300, Byte_vector(32, 0x55)); });
+    benchmark.Register("lis2dw12/acceleration", [&](){ lis2dw12.Acceleration(); });
+    benchmark.Register("lis2dw12/id", [&](){ lis2dw12.ID(); });
+    benchmark.Register("tmp117/temperature", [&](){ tmp117.Temperature(); });
+    benchmark.Register("tmp117/data_ready", [&](){ tmp117.Data_ready(); });
+    benchmark.Register("st25dv/read_memory_16", [&](){ st25dv.Read_memory(0x0040, 16); });
+    benchmark.Register("st25dv/read_memory_256", [&](){ st25dv.Read_memory(0x0100, 256); });
+    benchmark.Register("st25dv/id", [&](){ st25dv.ID(); });
+    benchmark.Register("i2c_registry/scan", [&](){ registry.Scan(); });
+
+    benchmark.Register("i2c_bus_group/read_all_blocking", [&](){
+            for (uint8_t i = 0; i < 6; i++) {
+                I2C_device(board_masters[0], board_addresses[i]).Read<uint8_t>(board_registers[i], board_lengths[i]);
+            }
+        },
+        [&](uint32_t){ place(1); });
+    benchmark.Register("i2c_bus_group/read_all_1bus", [&](){ read_all(groups[0]); }, [&](uint32_t){ place(1); });
+    benchmark.Register("i2c_bus_group/read_all_2bus", [&](){ read_all(groups[1]); }, [&](uint32_t){ place(2); });
+    benchmark.Register("i2c_bus_group/read_all_3bus", [&](){ read_all(groups[2]); }, [&](uint32_t){ place(3); });
+
+    benchmark.Register("serial_line/read_delimiter", [&](){ line.Read(string("\r\n")); },
+        [&](uint32_t count){
+            line.Clear_buffer();
+            for (uint32_t i = 0; i < count; i++) {
+                line.Push("AT+VALUE=12345,67890\r\n");
+            }
+        });
+    benchmark.Register("serial_line/read_length", [&](){ line.Read(22); },
+        [&](uint32_t count){
+            line.Clear_buffer();
+            for (uint32_t i = 0; i < count; i++) {
+                line.Push("AT+VALUE=12345,67890\r\n");
+            }
+        });
+
+    // Line of 4 kB arrives in fragments of 16 B, main loop polls Read after every fragment
+    const string fragment(16, 'x');
+    auto read_fragmented = [&](const string &delimiter){
+        for (int i = 0; i < 256; i++) {
+            line.Push(fragment);
+            line.Read(delimiter);
+        }
+        line.Push(delimiter);
+        line.Read(delimiter);
+    };
+    benchmark.Register("serial_line/read_fragmented_4k_crlf", [&](){ read_fragmented("\r\n"); },
+        [&](uint32_t){ line.Clear_buffer(); });
+    benchmark.Register("serial_line/read_fragmented_4k_lf", [&](){ read_fragmented("\n"); },
+        [&](uint32_t){ line.Clear_buffer(); });
+
+    int32_t integer = -1234567;
+    float real = 21.53125f;
+    benchmark.Register("serial_line/send_int_to_string", [&](){ uart.Send(std::to_string(integer)); }, drain);
+    benchmark.Register("serial_line/send_int", [&](){ uart.Send(integer); }, drain);
+    benchmark.Register("serial_line/send_float_to_string", [&](){ uart.Send(std::to_string(real)); }, drain);
+    benchmark.Register("serial_line/send_float", [&](){ uart.Send(real); }, drain);
+    benchmark.Register("serial_line/send_fixed", [&](){ uart.Send(Number::Fixed(real, 2)); }, drain);
+    benchmark.Register("serial_line/send_hex", [&](){ uart.Send(Number::Hex(0xbeefu, 8)); }, drain);
+    benchmark.Register("serial_line/send_binary", [&](){ uart.Send(Number::Binary(uint8_t(0x5a), 8)); }, drain);
+
+    // Deferred logging at call site against formatting of string and sending it, processing is measured separately
+    Logger recorder(line);
+    Logger text_logger(uart);
+    Logger binary_logger(uart, Logger::Output::Binary);
+    int16_t axis = -340;
+    uint32_t counter_value = 3000000000u;
+    benchmark.Register("log/record_3_args", [&](){
+        LOG_INFO(recorder, "T {} C, x {} n {}", real, axis, counter_value);
+        recorder.Clear();
+    });
+    benchmark.Register("log/record_process_text", [&](){
+        LOG_INFO(text_logger, "T {} C, x {} n {}", real, axis, counter_value);
+        text_logger.Process();
+    }, drain);
+    benchmark.Register("log/record_process_binary", [&](){
+        LOG_INFO(binary_logger, "T {} C, x {} n {}", real, axis, counter_value);
+        binary_logger.Process();
+    }, drain);
+    benchmark.Register("log/send_to_string", [&](){
+        uart.Send("T " + std::to_string(real) + " C, x " + std::to_string(axis) + " n " + std::to_string(counter_value) + "\r\n");
+    }, drain);
+
+    // One sample of accelerometer per operation, full block is encoded every 64th sample
+    Sample_encoder encoder(3);
+    std::array<int16_t, 3> acceleration = {120, -340, 8192};
+    uint32_t step = 0;
+    benchmark.Register("sample_encoder/add_3x16", [&](){
+        step++;
+        acceleration[0] += (step % 7) - 3;
+        acceleration[1] += (step % 5) - 2;
+        encoder.Add(acceleration);
+    });
+
+    benchmark.Register("dye/colorize", [&](){ dye::colorize("light_green", "temperature ok"); });
+    benchmark.Register("dye/static", [&](){ (dye::bold + dye::red)("temperature high"); });
+
+    benchmark.Register("invocation_wrapper/invoke", [&](){ callback->Invoke(); });
+
+    // Tickless run loops, power states are modeled by Simulated_power, every operation waits for one wake up
+    // Timers run in time base of RTC like on MCU, alarm with default prescalers has resolution of 1/256 s
+    RTC_internal rtc;
+    rtc.Init();
+    RTC_timer_wheel wheel(rtc, 1);
+    Simulated_power rtc_power(rtc);
+    Run_loop timer_loop(rtc_power, &wheel);
+    Invocation_wrapper<Run_loop, void, void> timer_loop_wake(&timer_loop, &Run_loop::Wake);
+    wheel.Wake_notification(&timer_loop_wake);
+    benchmark.Observe(timer_loop);
+
+    Counter expirations;
+    Invocation_wrapper<Counter, void, void> expiration(&expirations, &Counter::Increment);
+    RTC_timer timer(&expiration);
+    auto wait_for_timer = [&](uint32_t delay){
+        uint32_t expected = expirations.value + 1;
+        wheel.Start(timer, delay);
+        while (expirations.value < expected) {
+            timer_loop.Iterate();
+        }
+    };
+
+    // Interrupts are accounted in time base of Virtual_clock with resolution of 1 us
+    Simulated_power power;
+    Run_loop loop(power);
+    Invocation_wrapper<Run_loop, void, void> loop_wake(&loop, &Run_loop::Wake);
+    benchmark.Observe(loop);
+
+    Data_ready data_ready(loop, tmp117);
+    Invocation_wrapper<Data_ready, void, void> data_ready_irq(&data_ready, &Data_ready::Interrupt);
+    Invocation_wrapper<Data_ready, bool, void> data_ready_task(&data_ready, &Data_ready::Poll);
+    loop.Register(&data_ready_task);
+
+    Simulated_UART console_port(115200);
+    UART_HandleTypeDef hconsole = {&console_port, 0};
+    UART console(&hconsole);
+    console.Wake_notification(&loop_wake);
+    console.Receive();      // Arms reception, stores empty temporal buffer
+    console.Clear_buffer();
+    Command_reader reader(console);
+    Invocation_wrapper<Command_reader, bool, void> reader_task(&reader, &Command_reader::Poll);
+    loop.Register(&reader_task);
+
+    benchmark.Register("run_loop/timer_10ms_stop", [&](){ wait_for_timer(10); });
+    benchmark.Register("run_loop/timer_1ms_sleep", [&](){ wait_for_timer(1); });
+    benchmark.Register("run_loop/exti_1ms_read_tmp117", [&](){
+        uint32_t expected = data_ready.processed + 1;
+        power.Schedule(Virtual_clock::Now_us() + 1000, &data_ready_irq);
+        while (data_ready.processed < expected) {
+            loop.Iterate();
+        }
+    });
+    benchmark.Register("run_loop/uart_command_1ms", [&](){
+        uint32_t expected = reader.commands + 1;
+        console_port.Inject("AT+VALUE=12345\r\n", 1000000);
+        while (reader.commands < expected) {
+            loop.Iterate();
+        }
+    });
+
+    auto results = benchmark.Run(filter);
+    if (json) {
+        Benchmark::Print_json(std::cout, results);
+    } else {
+        Benchmark::Print_table(std::cout, results);
+    }
+    return 0;
+}
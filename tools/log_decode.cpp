@@ -0,0 +1,41 @@
+/**
+ * @file log_decode.cpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ *
+ * Host tool which decodes binary output of Logger into text lines
+ * Usage: log_decode [file], data are read from standard input if file is not given
+ * Build: g++ -std=c++17 -I.. log_decode.cpp ../log/log_decoder.cpp ../log/log_record.cpp -o log_decode
+ */
+
+#include <cstdio>
+#include <iostream>
+
+#include "log/log_decoder.hpp"
+
+int main(int argc, char *argv[]){
+    FILE *input = stdin;
+    if (argc > 1) {
+        input = std::fopen(argv[1], "rb");
+        if (input == nullptr) {
+            std::cerr << "Cannot open " << argv[1] << std::endl;
+            return 1;
+        }
+    }
+
+    Log_decoder decoder([](const Log_decoder::Event &event){
+        std::cout << Log_decoder::Format_line(event) << std::endl;
+    });
+
+    uint8_t data[256];
+    size_t length;
+    while ((length = std::fread(data, 1, sizeof(data), input)) > 0) {
+        decoder.Feed(data, length);
+    }
+
+    if (decoder.Skipped() || decoder.Unknown()) {
+        std::cerr << "Skipped bytes: " << decoder.Skipped() << ", events without definition: " << decoder.Unknown() << std::endl;
+    }
+    return 0;
+}
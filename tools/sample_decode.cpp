@@ -0,0 +1,73 @@
+/**
+ * @file sample_decode.cpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ *
+ * Host tool which decodes sample stream compressed by Sample_encoder into CSV lines (index,channel 0,channel 1,...)
+ * Usage: sample_decode [file [first count]], data are read from standard input if file is not given
+ *        Only samples first..first+count-1 are decoded if range is given
+ * Build: g++ -std=c++17 -I.. sample_decode.cpp ../codec/sample_decoder.cpp -o sample_decode
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#include "codec/sample_decoder.hpp"
+
+int main(int argc, char *argv[]){
+    FILE *input = stdin;
+    if (argc > 1) {
+        input = std::fopen(argv[1], "rb");
+        if (input == nullptr) {
+            std::cerr << "Cannot open " << argv[1] << std::endl;
+            return 1;
+        }
+    }
+
+    Sample_decoder decoder;
+    uint8_t data[256];
+    size_t length;
+    while ((length = std::fread(data, 1, sizeof(data), input)) > 0) {
+        decoder.Feed(data, length);
+    }
+
+    size_t channels = decoder.Channels();
+    if (channels == 0) {
+        std::cerr << "No valid block found" << std::endl;
+        return 1;
+    }
+
+    // Index of every sample is taken from blocks, so gaps after damaged blocks stay visible
+    uint32_t first = argc > 3 ? std::strtoul(argv[2], nullptr, 0) : 0;
+    uint32_t count = argc > 3 ? std::strtoul(argv[3], nullptr, 0) : UINT32_MAX;
+    uint64_t last = static_cast<uint64_t>(first) + count;
+    for (const Sample_decoder::Block &block : decoder.Blocks()) {
+        uint64_t block_first = block.header.index;
+        uint64_t block_last = block_first + block.header.count;
+        if (block_last <= first || block_first >= last) {
+            continue;
+        }
+        uint32_t from = std::max<uint64_t>(first, block_first);
+        uint32_t to = std::min(last, block_last);
+        std::vector<int32_t> samples = decoder.Read(from, to - from);
+        for (uint32_t sample = 0; sample < to - from; sample++) {
+            std::cout << from + sample;
+            for (size_t channel = 0; channel < channels; channel++) {
+                std::cout << ',' << samples[sample * channels + channel];
+            }
+            std::cout << '\n';
+        }
+    }
+
+    uint64_t raw = decoder.Samples() * channels * sizeof(int16_t);
+    std::cerr << "Blocks: " << decoder.Blocks().size() << ", samples: " << decoder.Samples()
+              << ", compressed: " << decoder.Size() << " B, ratio to 16-bit samples: "
+              << static_cast<double>(raw) / decoder.Size() << std::endl;
+    if (decoder.Skipped() || decoder.Damaged()) {
+        std::cerr << "Skipped bytes: " << decoder.Skipped() << ", damaged blocks: " << decoder.Damaged() << std::endl;
+    }
+    return 0;
+}
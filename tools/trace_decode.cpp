@@ -0,0 +1,59 @@
+/**
+ * @file trace_decode.cpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ *
+ * Host tool which decodes binary image of Bus_trace into timeline and per device bus occupancy
+ * Usage: trace_decode [file], image is read from standard input if file is not given
+ *        image can be captured from serial line after Bus_trace::Export or read out of EEPROM
+ * Build: g++ -std=c++17 -I.. trace_decode.cpp ../trace/trace_decoder.cpp ../trace/trace_record.cpp -o trace_decode
+ */
+
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "trace/trace_decoder.hpp"
+
+int main(int argc, char *argv[]){
+    FILE *input = stdin;
+    if (argc > 1) {
+        input = std::fopen(argv[1], "rb");
+        if (input == nullptr) {
+            std::cerr << "Cannot open " << argv[1] << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<uint8_t> image;
+    uint8_t data[256];
+    size_t length;
+    while ((length = std::fread(data, 1, sizeof(data), input)) > 0) {
+        image.insert(image.end(), data, data + length);
+    }
+
+    Trace_decoder decoder;
+    if (!decoder.Decode(image.data(), image.size())) {
+        std::cerr << "Input is not trace image" << std::endl;
+        return 1;
+    }
+
+    for (auto &event : decoder.Events()) {
+        std::cout << Trace_decoder::Format_line(event) << std::endl;
+    }
+
+    char line[128];
+    std::snprintf(line, sizeof(line), "\n%u transactions in %.3f us, %u older overwritten\n",
+        static_cast<unsigned>(decoder.Events().size()), decoder.Span(), decoder.Overwritten());
+    std::cout << line;
+    std::snprintf(line, sizeof(line), "%-6s %-5s %8s %7s %9s %12s %7s\n", "bus", "addr", "count", "errors", "bytes", "busy us", "busy %");
+    std::cout << line;
+    for (auto &device : decoder.Statistics()) {
+        std::snprintf(line, sizeof(line), "%-6s 0x%02x  %8u %7u %9llu %12.3f %6.2f%%\n",
+            Trace_decoder::Bus_name(device.source).c_str(), device.address, device.transactions, device.errors,
+            static_cast<unsigned long long>(device.bytes), device.busy, device.share * 100);
+        std::cout << line;
+    }
+    return 0;
+}
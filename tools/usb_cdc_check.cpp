@@ -0,0 +1,124 @@
+/**
+ * @file usb_cdc_check.cpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ *
+ * Host check of USB_CDC against simulated full speed bulk device
+ * Covers batching of messages into 64 B packets, flush timeout, ZLP after transfer ending on full packet,
+ *     NAK of host while RX buffer is full and arming of reception after Read, reports throughput
+ * Usage: usb_cdc_check, returns 0 if all checks passed
+ * Build: g++ -std=c++17 -DMCU_FAMILY_HOST -DHALUP_HAL_CALLBACKS=1 -I.. usb_cdc_check.cpp <sources> -o usb_cdc_check
+ *        sources are all .cpp files of host, i2c, spi, sensors, nfc and memory/eeprom
+ *            and gpio/pin.cpp, uart/serial_line.cpp, uart/uart.cpp, rtc/rtc.cpp, rtc/rtc_timer.cpp, misc/probe.cpp,
+ *            misc/hal_callbacks.cpp, usb/usb_cdc.cpp, trace/bus_trace.cpp, trace/trace_record.cpp
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "host/simulated_usb.hpp"
+#include "host/virtual_clock.hpp"
+#include "usb/usb_cdc.hpp"
+
+namespace {
+    unsigned int failures = 0;
+
+    void Check(bool condition, const char *name){
+        std::printf("%s %s\n", condition ? "ok  " : "FAIL", name);
+        if (not condition) {
+            failures++;
+        }
+    }
+
+    /**
+     * @brief   Move time by given number of ms, Tick() is called every ms like from SysTick
+     */
+    void Run_for(USB_CDC &cdc, uint32_t ms){
+        for (uint32_t i = 0; i < ms; i++) {
+            Virtual_clock::Advance(1000000);
+            cdc.Tick();
+        }
+    }
+}
+
+int main(){
+    Simulated_USB_CDC device;
+    hUsbDeviceFS.Instance = &device;
+    USB_CDC cdc(&hUsbDeviceFS);
+
+    // Small messages wait for flush timeout and leave in one short packet
+    for (int i = 0; i < 10; i++) {
+        cdc.Send("abc");
+    }
+    Check(device.Stats().transfers == 0, "short messages are batched");
+    Run_for(cdc, HALUP_USB_FLUSH_TIMEOUT + 1);
+    Check(device.Take_output() == "abcabcabcabcabcabcabcabcabcabc", "batch delivered");
+    Check(device.Stats().transfers == 1 && device.Stats().packets_in == 1 && cdc.Stats().flushes == 1, "batch flushed in one packet after timeout");
+
+    // Full packets are sent without waiting, transfer which ends on full packet is terminated by ZLP
+    uint32_t packets = device.Stats().packets_in;
+    uint32_t flushes = cdc.Stats().flushes;
+    string block(128, 'x');
+    for (int i = 0; i < 8; i++) {
+        cdc.Send(block.c_str() + i * 16, 16);
+    }
+    Check(device.Stats().transfers == 2, "full packet sent immediately");
+    Virtual_clock::Advance(1000000);
+    Check(device.Take_output() == block && device.Pending().empty(), "host read completed");
+    Check(device.Stats().packets_in - packets == 3 && device.Stats().zlps == 1 && cdc.Stats().flushes == flushes, "two full packets and ZLP");
+
+    // Throughput, 100 kB in 16 B messages, producer refills TX buffer every 100 us
+    packets = device.Stats().packets_in;
+    string expected;
+    uint32_t sent = 0;
+    uint64_t start = Virtual_clock::Now();
+    while (sent < 100000) {
+        char line[17];
+        std::snprintf(line, sizeof(line), "%015u\n", static_cast<unsigned int>(sent));
+        if (cdc.Send(line, 16) >= 0) {
+            expected.append(line, 16);
+            sent += 16;
+            continue;
+        }
+        Virtual_clock::Advance(100000);
+        cdc.Tick();
+    }
+    while (cdc.Busy()) {
+        Virtual_clock::Advance(100000);
+        cdc.Tick();
+    }
+    Virtual_clock::Advance(1000000);
+    string output = device.Take_output();
+    double seconds = (Virtual_clock::Now() - start) / 1e9;
+    double throughput = output.size() / seconds / 1000;
+    uint32_t stream_packets = device.Stats().packets_in - packets;
+    std::printf("100 kB in %u packets (%u since start), %u transfers, %.0f kB/s\n",
+        stream_packets, device.Stats().packets_in, device.Stats().transfers, throughput);
+    Check(output == expected && device.Pending().empty(), "stream delivered intact");
+    Check(stream_packets == (100000 + Simulated_USB_CDC::packet_size - 1) / Simulated_USB_CDC::packet_size, "stream sent in full packets");
+    Check(throughput >= 1150 && throughput <= 1216, "throughput at limit of full speed bulk endpoint");
+
+    // Reception stops when next packet would not fit, host is NAKed until Read frees space
+    string input(1000, 'r');
+    device.Inject(input);
+    Virtual_clock::Advance(10000000);
+    uint32_t buffered = cdc.Buffer_size();
+    uint32_t received = device.Stats().packets_out;
+    Check(buffered <= HALUP_SERIAL_BUFFER && buffered > HALUP_SERIAL_BUFFER - Simulated_USB_CDC::packet_size, "RX buffer filled");
+    Virtual_clock::Advance(10000000);
+    Check(device.Stats().packets_out == received && cdc.Buffer_size() == buffered, "host NAKed while RX buffer is full");
+    string read;
+    while (read.size() < input.size()) {
+        size_t length = cdc.Buffer_size();
+        read += string(cdc.Read(length));
+        Virtual_clock::Advance(1000000);
+    }
+    Check(read == input, "reception armed after Read, no data lost");
+
+    if (failures) {
+        std::printf("%u checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include "bus_trace.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "i2c/i2c_device.hpp"
+#include "misc/critical_section.hpp"
+#include "uart/serial_line.hpp"
+
+void Bus_trace::Store(const Trace::Record &record){
+    Critical_section section;
+    if (frozen) {
+        return;
+    }
+    records[head & (HALUP_TRACE_RECORDS - 1)] = record;
+    head++;
+
+    if (countdown < 0 && trigger && record.status != 0) {
+        countdown = post_trigger;
+    } else if (countdown > 0) {
+        countdown--;
+    }
+    if (countdown == 0) {
+        frozen = true;
+    }
+}
+
+void Bus_trace::Unfreeze(){
+    Critical_section section;
+    frozen = false;
+    countdown = -1;
+}
+
+void Bus_trace::Freeze_on_error(bool enable, uint16_t after){
+    Critical_section section;
+    trigger = enable;
+    post_trigger = after;
+    countdown = -1;
+}
+
+void Bus_trace::Clear(){
+    Critical_section section;
+    head = 0;
+    frozen = false;
+    countdown = -1;
+}
+
+uint16_t Bus_trace::Count(){
+    return std::min<uint32_t>(head, HALUP_TRACE_RECORDS);
+}
+
+uint32_t Bus_trace::Overwritten(){
+    return head - Count();
+}
+
+const Trace::Record &Bus_trace::Get(uint16_t index){
+    return records[(head - Count() + index) & (HALUP_TRACE_RECORDS - 1)];
+}
+
+Trace::Header Bus_trace::Header(uint16_t count){
+    Trace::Header header;
+    header.count = count;
+    header.overwritten = Overwritten();
+    header.frequency = Probe::Frequency();
+    return header;
+}
+
+size_t Bus_trace::Serialize(uint8_t *buffer, size_t capacity){
+    if (capacity < Trace::header_size) {
+        return 0;
+    }
+    Critical_section section;
+    uint16_t count = std::min<size_t>(Count(), (capacity - Trace::header_size) / Trace::record_size);
+
+    Trace::Encode(Header(count), buffer);
+    for (uint16_t i = 0; i < count; i++) {
+        Trace::Encode(Get(i), buffer + Trace::header_size + i * Trace::record_size);
+    }
+    return Trace::header_size + count * Trace::record_size;
+}
+
+size_t Bus_trace::Serialize(size_t offset, uint8_t *buffer, size_t length){
+    static_assert(Trace::header_size == Trace::record_size, "Header and records are encoded into same block");
+    Critical_section section;
+    uint8_t block[Trace::record_size];
+    size_t size = Image_size();
+    size_t written = 0;
+    while (written < length && offset < size) {
+        // Header is block 0, records follow
+        size_t index = offset / Trace::record_size;
+        if (index == 0) {
+            Trace::Encode(Header(Count()), block);
+        } else {
+            Trace::Encode(Get(index - 1), block);
+        }
+        size_t skip = offset % Trace::record_size;
+        size_t chunk = std::min(Trace::record_size - skip, length - written);
+        std::memcpy(buffer + written, block + skip, chunk);
+        written += chunk;
+        offset += chunk;
+    }
+    return written;
+}
+
+void Bus_trace::Export(Serial_line &line){
+    bool was_frozen = frozen;
+    frozen = true;
+
+    // Image is sent by messages of maximal length of serial line, whole image at once if heap is used
+    size_t size = Image_size();
+    size_t offset = 0;
+    while (offset < size) {
+        Serial_line::Text message(std::min(size - offset, Serial_line::Text().max_size()), '\0');
+        offset += Serialize(offset, reinterpret_cast<uint8_t *>(message.data()), message.size());
+        line.Send(std::move(message));
+    }
+
+    frozen = was_frozen;
+}
+
+bool Bus_trace::Store(I2C_device &memory, uint16_t address, uint16_t page_size){
+    bool was_frozen = frozen;
+    frozen = true;
+
+    // EEPROM does not acknowledge during write cycle of previous page, so every page is retried
+    constexpr uint8_t attempts = 10;
+    bool success = true;
+    size_t size = Image_size();
+    size_t offset = 0;
+    while (success && offset < size) {
+        uint16_t position = address + offset;
+        size_t chunk = std::min<size_t>(size - offset, page_size - (position % page_size));
+        Byte_vector page(chunk);
+        Serialize(offset, page.data(), chunk);
+        success = false;
+        for (uint8_t attempt = 0; attempt < attempts && !success; attempt++) {
+            success = memory.Write<uint16_t>(position, page);
+            if (!success) {
+                HAL_Delay(1);
+            }
+        }
+        offset += chunk;
+    }
+
+    frozen = was_frozen;
+    return success;
+}
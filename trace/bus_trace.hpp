@@ -0,0 +1,204 @@
+/**
+ * @file bus_trace.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "global_includes.hpp"
+#include "misc/probe.hpp"
+#include "trace/trace_record.hpp"
+
+/**
+ * @brief   Enables recording of bus transactions, when 0 recording calls in drivers are removed
+ */
+#ifndef HALUP_TRACE
+#define HALUP_TRACE 1
+#endif
+
+/**
+ * @brief   Number of records in circular trace buffer, must be power of two
+ */
+#ifndef HALUP_TRACE_RECORDS
+#define HALUP_TRACE_RECORDS 64
+#endif
+
+class Serial_line;
+class I2C_device;
+
+/**
+ * @brief   Always-on tracer of bus transactions
+ *          Drivers record every transaction (bus, device, operation, length, HAL status and error code,
+ *              start and end timestamp from Probe::Now()) into fixed circular buffer, oldest records are overwritten
+ *          Trace can be frozen on first failed transaction so the history leading to error is preserved
+ *          Frozen trace is exported as binary image to serial line or stored into EEPROM,
+ *              image is decoded on host side by Trace_decoder (tools/trace_decode.cpp)
+ *          Recording is protected by critical section and can be used from IRQ handlers
+ */
+class Bus_trace {
+private:
+    static_assert((HALUP_TRACE_RECORDS & (HALUP_TRACE_RECORDS - 1)) == 0, "Number of trace records must be power of two");
+    static_assert(HALUP_TRACE_RECORDS <= UINT16_MAX, "Number of trace records must fit into header of image");
+
+    static inline Trace::Record records[HALUP_TRACE_RECORDS] = {};
+
+    /**
+     * @brief   Total number of recorded transactions, index of next record is head modulo size of buffer
+     */
+    static inline uint32_t head = 0;
+
+    static inline bool frozen = false;
+
+    /**
+     * @brief   Freeze trace when transaction fails
+     */
+    static inline bool trigger = false;
+
+    /**
+     * @brief   Number of records which are stored after failed transaction before trace is frozen
+     */
+    static inline uint16_t post_trigger = 0;
+
+    /**
+     * @brief   Remaining records until freeze, negative if trigger did not occur yet
+     */
+    static inline int32_t countdown = -1;
+
+    /**
+     * @brief   Store record into buffer
+     */
+    static void Store(const Trace::Record &record);
+
+    /**
+     * @brief   Return header of image with given number of records
+     */
+    static Trace::Header Header(uint16_t count);
+
+public:
+    /**
+     * @brief   Return timestamp of start of transaction
+     */
+    static inline uint32_t Start(){ return Probe::Now(); };
+
+    /**
+     * @brief   Record finished transaction, end of transaction is current time
+     *
+     * @param bus       Type of bus
+     * @param index     Index of bus of given type (0-15)
+     * @param address   Address of device (8-bit I2C address), 0 if bus has no addressing
+     * @param operation Type of transaction
+     * @param status    HAL status of transaction
+     * @param error     Error code from HAL handle
+     * @param length    Number of transferred bytes
+     * @param start     Timestamp from Start()
+     */
+    static inline void Record(Trace::Bus bus, uint8_t index, uint8_t address, Trace::Operation operation,
+                              uint8_t status, uint32_t error, uint16_t length, uint32_t start){
+#if HALUP_TRACE
+        Trace::Record record;
+        record.source = Trace::Source(bus, index);
+        record.address = address;
+        record.operation = operation;
+        record.status = status;
+        record.length = length;
+        record.error = static_cast<uint16_t>(error);
+        record.start = start;
+        record.end = Probe::Now();
+        Store(record);
+#else
+        (void)bus; (void)index; (void)address; (void)operation;
+        (void)status; (void)error; (void)length; (void)start;
+#endif
+    }
+
+    /**
+     * @brief   Stop recording, content of buffer is preserved
+     */
+    static void Freeze(){ frozen = true; };
+
+    /**
+     * @brief   Resume recording and rearm trigger
+     */
+    static void Unfreeze();
+
+    /**
+     * @brief   Return true if recording is stopped
+     */
+    static bool Frozen(){ return frozen; };
+
+    /**
+     * @brief   Freeze trace after failed transaction
+     *
+     * @param enable    Enables trigger
+     * @param after     Number of transactions recorded after failed one before freezing
+     */
+    static void Freeze_on_error(bool enable, uint16_t after = 0);
+
+    /**
+     * @brief   Remove all records and resume recording
+     */
+    static void Clear();
+
+    /**
+     * @brief   Return number of valid records in buffer
+     */
+    static uint16_t Count();
+
+    /**
+     * @brief   Return number of records which were overwritten by newer ones
+     */
+    static uint32_t Overwritten();
+
+    /**
+     * @brief   Return record, index 0 is the oldest one
+     */
+    static const Trace::Record &Get(uint16_t index);
+
+    /**
+     * @brief   Return size of binary image with all valid records
+     */
+    static size_t Image_size(){ return Trace::header_size + Count() * Trace::record_size; };
+
+    /**
+     * @brief   Write binary image of trace into buffer
+     *
+     * @param buffer    Target buffer
+     * @param capacity  Size of target buffer, only whole records which fit are written
+     * @return size_t   Number of written bytes, 0 if header does not fit
+     */
+    static size_t Serialize(uint8_t *buffer, size_t capacity);
+
+    /**
+     * @brief   Write part of binary image with all valid records into buffer, image is encoded block by block,
+     *              so large image can be streamed through small buffer
+     *
+     * @param offset    Position in image of first written byte
+     * @param buffer    Target buffer
+     * @param length    Number of bytes to write
+     * @return size_t   Number of written bytes, less than length at end of image
+     */
+    static size_t Serialize(size_t offset, uint8_t *buffer, size_t length);
+
+    /**
+     * @brief   Send binary image to serial line, trace is frozen during export
+     *
+     * @param line  Serial line to which is image sent
+     */
+    static void Export(Serial_line &line);
+
+    /**
+     * @brief   Store binary image into I2C EEPROM, trace is frozen during writing
+     *          Image is written by pages, every page is repeated until EEPROM finishes previous write cycle
+     *
+     * @param memory    EEPROM with 16-bit memory address
+     * @param address   Address in memory where image starts
+     * @param page_size Size of page of EEPROM, writes do not cross page boundary
+     * @return true     Whole image was written
+     * @return false    EEPROM did not accept some page
+     */
+    static bool Store(I2C_device &memory, uint16_t address, uint16_t page_size = 16);
+};
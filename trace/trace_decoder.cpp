@@ -0,0 +1,98 @@
+#include "trace_decoder.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <utility>
+
+bool Trace_decoder::Decode(const uint8_t *data, size_t length){
+    events.clear();
+    if (length < Trace::header_size || !Trace::Decode(data, header) || header.frequency == 0) {
+        return false;
+    }
+
+    size_t count = std::min<size_t>(header.count, (length - Trace::header_size) / Trace::record_size);
+    double resolution = 1e6 / header.frequency;
+    uint32_t previous = 0;
+    int64_t time = 0;
+    int64_t earliest = 0;
+    std::vector<int64_t> times;
+    for (size_t i = 0; i < count; i++) {
+        Event event;
+        Trace::Decode(data + Trace::header_size + i * Trace::record_size, event.record);
+        // Records are stored when transfer completes (interrupt transfers, concurrent buses),
+        //  so start can precede start of previous record, signed differences of wrapping timestamps are accumulated
+        if (i > 0) {
+            time += static_cast<int32_t>(event.record.start - previous);
+        }
+        previous = event.record.start;
+        earliest = std::min(earliest, time);
+        times.push_back(time);
+        event.duration = event.record.Duration() * resolution;
+        events.push_back(event);
+    }
+
+    for (size_t i = 0; i < events.size(); i++) {
+        events[i].start = (times[i] - earliest) * resolution;
+    }
+    std::stable_sort(events.begin(), events.end(), [](const Event &a, const Event &b){ return a.start < b.start; });
+    return true;
+}
+
+double Trace_decoder::Span() const {
+    double span = 0;
+    for (auto &event : events) {
+        span = std::max(span, event.start + event.duration);
+    }
+    return span;
+}
+
+std::vector<Trace_decoder::Occupancy> Trace_decoder::Statistics() const {
+    std::map<std::pair<uint8_t, uint8_t>, Occupancy> devices;
+    for (auto &event : events) {
+        Occupancy &device = devices[{event.record.source, event.record.address}];
+        device.source = event.record.source;
+        device.address = event.record.address;
+        device.transactions++;
+        device.errors += event.record.status != 0;
+        device.bytes += event.record.length;
+        device.busy += event.duration;
+    }
+
+    double span = Span();
+    std::vector<Occupancy> result;
+    for (auto &[key, device] : devices) {
+        device.share = span > 0 ? device.busy / span : 0;
+        result.push_back(device);
+    }
+    return result;
+}
+
+std::string Trace_decoder::Bus_name(uint8_t source){
+    Trace::Record record;
+    record.source = source;
+    const char *type = "BUS";
+    switch (record.Bus_type()) {
+        case Trace::Bus::I2C:  type = "I2C";  break;
+        case Trace::Bus::UART: type = "UART"; break;
+        case Trace::Bus::SPI:  type = "SPI";  break;
+    }
+    return type + std::to_string(record.Bus_index());
+}
+
+std::string Trace_decoder::Format_line(const Event &event){
+    static const char *operations[] = {"TX", "RX", "PING"};
+    static const char *statuses[] = {"OK", "ERROR", "BUSY", "TIMEOUT"};
+
+    const Trace::Record &record = event.record;
+    uint8_t operation = static_cast<uint8_t>(record.operation);
+    char line[128];
+    int length = std::snprintf(line, sizeof(line), "%12.3f us  +%10.3f us  %-5s 0x%02x %-4s %5u B  %s",
+        event.start, event.duration, Bus_name(record.source).c_str(), record.address,
+        operation < 3 ? operations[operation] : "?", record.length,
+        record.status < 4 ? statuses[record.status] : "?");
+    if (record.status != 0 && length > 0 && static_cast<size_t>(length) < sizeof(line)) {
+        std::snprintf(line + length, sizeof(line) - length, " (error 0x%04x)", record.error);
+    }
+    return line;
+}
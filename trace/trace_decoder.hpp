@@ -0,0 +1,90 @@
+/**
+ * @file trace_decoder.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "trace/trace_record.hpp"
+
+/**
+ * @brief   Host side decoder of binary image exported by Bus_trace
+ *          Timestamps are unwrapped and converted to µs from earliest start, events are sorted by start
+ */
+class Trace_decoder {
+public:
+    /**
+     * @brief   Decoded transaction with unwrapped time
+     */
+    struct Event {
+        Trace::Record record;
+        double start;    // µs from earliest start of traced transactions
+        double duration; // µs
+    };
+
+    /**
+     * @brief   Statistics of one device on one bus
+     */
+    struct Occupancy {
+        uint8_t source = 0;
+        uint8_t address = 0;
+        uint32_t transactions = 0;
+        uint32_t errors = 0;
+        uint64_t bytes = 0;
+        double busy = 0;  // µs
+        double share = 0; // Fraction of traced time span
+    };
+
+private:
+    Trace::Header header;
+
+    std::vector<Event> events;
+
+public:
+    /**
+     * @brief   Decode image
+     *
+     * @param data      Image data starting by header
+     * @param length    Length of data
+     * @return true     Image is valid, records which are not complete are ignored
+     * @return false    Header is missing or invalid
+     */
+    bool Decode(const uint8_t *data, size_t length);
+
+    /**
+     * @brief   Return decoded transactions ordered by start
+     */
+    const std::vector<Event> &Events() const { return events; };
+
+    /**
+     * @brief   Return number of records which were overwritten on target before export
+     */
+    uint32_t Overwritten() const { return header.overwritten; };
+
+    /**
+     * @brief   Return time from earliest start to latest end of transaction in µs
+     */
+    double Span() const;
+
+    /**
+     * @brief   Return occupancy of bus by every device, sorted by source and address
+     */
+    std::vector<Occupancy> Statistics() const;
+
+    /**
+     * @brief   Return name of bus, example "I2C0"
+     */
+    static std::string Bus_name(uint8_t source);
+
+    /**
+     * @brief   Format transaction into timeline line
+     *          Example: "    1520.250 us  +231.500 us  I2C0 0x90 TX    3 B  OK"
+     */
+    static std::string Format_line(const Event &event);
+};
@@ -0,0 +1,71 @@
+#include "trace_record.hpp"
+
+namespace {
+    constexpr uint8_t magic[4] = {'H', 'T', 'R', 'C'};
+
+    void Put16(uint8_t *buffer, uint16_t value){
+        buffer[0] = value & 0xff;
+        buffer[1] = value >> 8;
+    }
+
+    void Put32(uint8_t *buffer, uint32_t value){
+        Put16(buffer, value & 0xffff);
+        Put16(buffer + 2, value >> 16);
+    }
+
+    uint16_t Get16(const uint8_t *buffer){
+        return buffer[0] | (buffer[1] << 8);
+    }
+
+    uint32_t Get32(const uint8_t *buffer){
+        return Get16(buffer) | (static_cast<uint32_t>(Get16(buffer + 2)) << 16);
+    }
+}
+
+void Trace::Encode(const Header &header, uint8_t *buffer){
+    for (size_t i = 0; i < sizeof(magic); i++) {
+        buffer[i] = magic[i];
+    }
+    buffer[4] = version;
+    buffer[5] = record_size;
+    Put16(buffer + 6, header.count);
+    Put32(buffer + 8, header.overwritten);
+    Put32(buffer + 12, header.frequency);
+}
+
+void Trace::Encode(const Record &record, uint8_t *buffer){
+    buffer[0] = record.source;
+    buffer[1] = record.address;
+    buffer[2] = static_cast<uint8_t>(record.operation);
+    buffer[3] = record.status;
+    Put16(buffer + 4, record.length);
+    Put16(buffer + 6, record.error);
+    Put32(buffer + 8, record.start);
+    Put32(buffer + 12, record.end);
+}
+
+bool Trace::Decode(const uint8_t *buffer, Header &header){
+    for (size_t i = 0; i < sizeof(magic); i++) {
+        if (buffer[i] != magic[i]) {
+            return false;
+        }
+    }
+    if (buffer[4] != version || buffer[5] != record_size) {
+        return false;
+    }
+    header.count = Get16(buffer + 6);
+    header.overwritten = Get32(buffer + 8);
+    header.frequency = Get32(buffer + 12);
+    return true;
+}
+
+void Trace::Decode(const uint8_t *buffer, Record &record){
+    record.source = buffer[0];
+    record.address = buffer[1];
+    record.operation = static_cast<Operation>(buffer[2]);
+    record.status = buffer[3];
+    record.length = Get16(buffer + 4);
+    record.error = Get16(buffer + 6);
+    record.start = Get32(buffer + 8);
+    record.end = Get32(buffer + 12);
+}
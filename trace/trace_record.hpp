@@ -0,0 +1,109 @@
+/**
+ * @file trace_record.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief   Format of bus transaction records shared by Bus_trace on target and Trace_decoder on host side
+ *          Exported image: header followed by records from oldest to newest, all multibyte values are little-endian
+ *          Header:  magic "HTRC" (4B), version (1B), record size (1B), record count (2B),
+ *                   number of overwritten records (4B), frequency of timestamps in Hz (4B)
+ *          Record:  source (1B), address (1B), operation (1B), status (1B), length (2B), error (2B),
+ *                   start (4B), end (4B)
+ */
+namespace Trace {
+    /**
+     * @brief   Type of bus, stored in upper nibble of source, lower nibble is index of bus
+     */
+    enum class Bus: uint8_t {
+        I2C  = 0,
+        UART = 1,
+        SPI  = 2,
+    };
+
+    /**
+     * @brief   Type of transaction
+     */
+    enum class Operation: uint8_t {
+        Transmit = 0,
+        Receive  = 1,
+        Probe    = 2,
+    };
+
+    /**
+     * @brief   One bus transaction
+     *          Status is HAL_StatusTypeDef (0 - OK, 1 - Error, 2 - Busy, 3 - Timeout),
+     *              error contains lower bits of ErrorCode of HAL handle
+     *          Start and end are values of Probe::Now() and wraps around
+     */
+    struct Record {
+        uint8_t source = 0;
+        uint8_t address = 0;
+        Operation operation = Operation::Transmit;
+        uint8_t status = 0;
+        uint16_t length = 0;
+        uint16_t error = 0;
+        uint32_t start = 0;
+        uint32_t end = 0;
+
+        Bus Bus_type() const { return static_cast<Bus>(source >> 4); };
+
+        uint8_t Bus_index() const { return source & 0x0f; };
+
+        uint32_t Duration() const { return end - start; };
+    };
+
+    inline constexpr uint8_t version = 1;
+
+    inline constexpr size_t header_size = 16;
+
+    inline constexpr size_t record_size = 16;
+
+    /**
+     * @brief   Information from header of image
+     */
+    struct Header {
+        uint16_t count = 0;
+        uint32_t overwritten = 0;
+        uint32_t frequency = 0;
+    };
+
+    /**
+     * @brief   Compose source byte from type and index of bus
+     */
+    constexpr uint8_t Source(Bus bus, uint8_t index){
+        return (static_cast<uint8_t>(bus) << 4) | (index & 0x0f);
+    }
+
+    /**
+     * @brief   Write header of image into buffer of header_size bytes
+     */
+    void Encode(const Header &header, uint8_t *buffer);
+
+    /**
+     * @brief   Write record into buffer of record_size bytes
+     */
+    void Encode(const Record &record, uint8_t *buffer);
+
+    /**
+     * @brief   Read header of image
+     *
+     * @param buffer    Buffer of header_size bytes
+     * @param header    Decoded header
+     * @return true     Header is valid
+     * @return false    Magic, version or record size does not match
+     */
+    bool Decode(const uint8_t *buffer, Header &header);
+
+    /**
+     * @brief   Read record from buffer of record_size bytes
+     */
+    void Decode(const uint8_t *buffer, Record &record);
+}
@@ -1,24 +1,160 @@
 #include "serial_line.hpp"
 
-string Serial_line::Read(int length){
-    string output = RX_buffer.substr(0, length);
-    RX_buffer.erase(0, length);
+#include <cstring>
+
+#include "misc/critical_section.hpp"
+
+Serial_line::Text Serial_line::Read(int length){
+    Text output;
+    {
+        // RX IRQ appends into buffer and scans it when line callback is registered
+        Critical_section section;
+        output = RX_buffer.substr(0, length);
+        RX_buffer.erase(0, length);
+        Scan_consumed(output.length());
+    }
+    Consumed();
     return output;
 }
 
-string Serial_line::Read(string delimiter){
-    size_t position = RX_buffer.find(delimiter, 0);
-    if (position != string::npos) {
-        string output = RX_buffer.substr(0, position + delimiter.length());
-        RX_buffer.erase(0, position + delimiter.length());
-        return output;
-    } else {
-        return "";
+Serial_line::Text Serial_line::Read(std::string_view delimiter){
+    Text output;
+    bool next_line;
+    {
+        // Scanner is shared with RX IRQ, which scans buffer when line callback is registered
+        Critical_section section;
+        Scan_delimiter(delimiter);
+        size_t end = Scan();
+        if (end == Text::npos) {
+            return "";
+        }
+        output = RX_buffer.substr(0, end);
+        RX_buffer.erase(0, end);
+        Scan_consumed(end);
+        next_line = line_callback && (Scan() != Text::npos);
     }
+    Consumed();
+    // Notify about next line which is already in buffer
+    if (next_line) {
+        line_callback->Invoke();
+    }
+    return output;
+}
+
+bool Serial_line::Line_available(std::string_view delimiter){
+    Critical_section section;
+    Scan_delimiter(delimiter);
+    return Scan() != Text::npos;
+}
+
+void Serial_line::Line_notification(std::string_view delimiter, Invocation_wrapper_base<void, void> *callback){
+    Critical_section section;
+    Scan_delimiter(delimiter);
+    line_callback = callback;
 }
 
 int Serial_line::Clear_buffer(){
-    unsigned int length = RX_buffer.length();
-    RX_buffer = "";
+    unsigned int length;
+    {
+        Critical_section section;
+        length = RX_buffer.length();
+        RX_buffer = "";
+        Scan_consumed(length);
+    }
+    Consumed();
     return length;
 }
+
+void Serial_line::Received(){
+    if (wake_callback) {
+        wake_callback->Invoke();
+    }
+    if (line_callback == nullptr || scan_match != Text::npos) {
+        return;
+    }
+    if (Scan() != Text::npos) {
+        line_callback->Invoke();
+    }
+}
+
+void Serial_line::Transmitted(){
+    if (transmit_callback) {
+        transmit_callback->Invoke();
+    }
+    if (wake_callback) {
+        wake_callback->Invoke();
+    }
+}
+
+void Serial_line::Scan_delimiter(std::string_view delimiter){
+    if (delimiter == std::string_view(scan_delimiter)) {
+        return;
+    }
+    scan_delimiter = Delimiter(delimiter);
+    scan_position = 0;
+    scan_state = 0;
+    scan_match = Text::npos;
+
+    // Build KMP failure table
+    scan_failure.assign(scan_delimiter.length(), 0);
+    size_t prefix = 0;
+    for (size_t i = 1; i < scan_delimiter.length(); i++) {
+        while (prefix > 0 && scan_delimiter[i] != scan_delimiter[prefix]) {
+            prefix = scan_failure[prefix - 1];
+        }
+        if (scan_delimiter[i] == scan_delimiter[prefix]) {
+            prefix++;
+        }
+        scan_failure[i] = prefix;
+    }
+}
+
+size_t Serial_line::Scan(){
+    if (scan_match != Text::npos || scan_delimiter.empty()) {
+        return scan_match;
+    }
+    const char *data = RX_buffer.data();
+    size_t size = RX_buffer.size();
+
+    if (scan_delimiter.length() == 1) {
+        const void *found = memchr(data + scan_position, scan_delimiter[0], size - scan_position);
+        if (found) {
+            scan_match = static_cast<const char *>(found) - data + 1;
+            scan_position = scan_match;
+            scan_state = 1;
+        } else {
+            scan_position = size;
+        }
+        return scan_match;
+    }
+
+    while (scan_position < size) {
+        char character = data[scan_position++];
+        while (scan_state > 0 && character != scan_delimiter[scan_state]) {
+            scan_state = scan_failure[scan_state - 1];
+        }
+        if (character == scan_delimiter[scan_state]) {
+            scan_state++;
+        }
+        if (scan_state == scan_delimiter.length()) {
+            scan_match = scan_position;
+            break;
+        }
+    }
+    return scan_match;
+}
+
+void Serial_line::Scan_consumed(size_t length){
+    // Start of partial or complete match of delimiter
+    size_t match_start = scan_position - scan_state;
+    if (length <= match_start) {
+        scan_position -= length;
+        if (scan_match != Text::npos) {
+            scan_match -= length;
+        }
+    } else {    // Match was consumed or cut, rescan rest of buffer
+        scan_position = 0;
+        scan_state = 0;
+        scan_match = Text::npos;
+    }
+}
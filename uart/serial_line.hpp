@@ -7,21 +7,128 @@
 
 #pragma once
 
+#include <cstring>
 #include <vector>
 #include <string>
+#include <string_view>
+
+#include "misc/invocation_wrapper.hpp"
+#include "misc/no_heap.hpp"
+#include "misc/number_format.hpp"
 
 using namespace std;
 
+/**
+ * @brief   Maximal length of delimiter of Serial_line in no-heap build
+ */
+#ifndef HALUP_SERIAL_DELIMITER
+#define HALUP_SERIAL_DELIMITER 8
+#endif
+
 /**
  * @brief   Common interface and basic functions for serial line interfaces like UART on USB CDC VCP
  */
 class Serial_line
 {
+public:
+    /**
+     * @brief   Text of messages and RX buffer, in no-heap build limited to HALUP_SERIAL_BUFFER characters
+     */
+    using Text = Bounded_string<HALUP_SERIAL_BUFFER>;
+
+    /**
+     * @brief   Delimiter of lines, in no-heap build limited to HALUP_SERIAL_DELIMITER characters
+     */
+    using Delimiter = Bounded_string<HALUP_SERIAL_DELIMITER>;
+
 protected:
     /**
      * @brief String of characters, which was received by serial line
+     *        In no-heap build characters which do not fit into buffer are dropped
+     */
+    Text RX_buffer = "";
+
+private:
+    /**
+     * @brief   Delimiter for which is RX buffer scanned
+     */
+    Delimiter scan_delimiter = "";
+
+    /**
+     * @brief   KMP failure table of scan delimiter, length of longest proper prefix which is also suffix
+     */
+    Bounded_vector<size_t, HALUP_SERIAL_DELIMITER> scan_failure;
+
+    /**
+     * @brief   Position in RX buffer from which continues scanning, bytes before were already examined
+     */
+    size_t scan_position = 0;
+
+    /**
+     * @brief   Number of delimiter characters matched at the scan position
+     */
+    size_t scan_state = 0;
+
+    /**
+     * @brief   Position after end of found delimiter, Text::npos if delimiter was not found yet
+     */
+    size_t scan_match = Text::npos;
+
+    /**
+     * @brief   Callback invoked when delimiter of line notification arrives
+     */
+    Invocation_wrapper_base<void, void> *line_callback = nullptr;
+
+    /**
+     * @brief   Callback invoked when all sent messages were transmitted
+     */
+    Invocation_wrapper_base<void, void> *transmit_callback = nullptr;
+
+    /**
+     * @brief   Callback invoked after every reception and completed transmission, wakes main loop
+     */
+    Invocation_wrapper_base<void, void> *wake_callback = nullptr;
+
+    /**
+     * @brief   Select delimiter of scanner, scanning restarts if delimiter is changed
+     *
+     * @param delimiter Delimiter to search for
+     */
+    void Scan_delimiter(std::string_view delimiter);
+
+    /**
+     * @brief   Continue scanning of RX buffer from last position until delimiter is found
+     *          Single character delimiters are searched by memchr, longer by KMP matcher
+     *
+     * @return size_t   Position after end of delimiter, Text::npos if delimiter is not in buffer
+     */
+    size_t Scan();
+
+    /**
+     * @brief   Update scanner after given number of characters were removed from start of RX buffer
+     *
+     * @param length    Number of removed characters
      */
-    string RX_buffer = "";
+    void Scan_consumed(size_t length);
+
+protected:
+    /**
+     * @brief   Must be called by implementation after new characters were added into RX buffer
+     *          Invokes wake callback and line notification callback if delimiter arrived
+     */
+    void Received();
+
+    /**
+     * @brief   Must be called by implementation with asynchronous transmission when its transmit queue becomes empty
+     *          Invokes transmit notification callback and wake callback
+     */
+    void Transmitted();
+
+    /**
+     * @brief   Called after characters were removed from RX buffer by Read or Clear_buffer,
+     *              implementation can resume reception which was throttled due to full buffer
+     */
+    virtual void Consumed(){ };
 
 public:
 
@@ -36,18 +143,31 @@ public:
      * @param message   String to send
      * @return int      Status code, depends on transmit layer
      */
-    virtual int Send(string message) = 0;
+    virtual int Send(Text message) = 0;
 
     /**
-     * @brief Send anything what can be casted to string over serial line
+     * @brief   Sends characters from buffer of caller via Serial line
+     *          Implementation can copy characters directly into its transmit queue, default creates Text
      *
-     * @tparam send__type   Type of message which will be converted to string and sended over serial line
-     * @param message       Value or text of message
+     * @param data      Characters to send
+     * @param length    Number of characters
+     * @return int      Status code, depends on transmit layer
+     */
+    virtual int Send(const char *data, size_t length){
+        return Send(Text(data, length));
+    }
+
+    /**
+     * @brief Send number over serial line, number is formatted on stack without allocation (see misc/number_format.hpp)
+     *
+     * @tparam send__type   Integer, float or wrapper Number::Hex, Number::Binary, Number::Fixed
+     * @param message       Value of message
      * @return int          Error code
      */
     template <typename send__type>
     int Send(send__type message){
-        return Send(to_string(message));
+        char text[Number::max_length];
+        return Send(text, Number::Format(text, sizeof(text), message));
     }
 
     /**
@@ -57,7 +177,7 @@ public:
      * @return int      Error code
      */
     int Send(const char* message){
-        return Send(string(message));
+        return Send(message, strlen(message));
     }
 
     /**
@@ -72,18 +192,64 @@ public:
      *          After this operation data which are returned are removed from buffer
      *
      * @param length    Number of characters to read
-     * @return string   Message from start of buffer with given length
+     * @return Text     Message from start of buffer with given length
      */
-    string Read(int length);
+    Text Read(int length);
 
     /**
      * @brief   Read part of buffer which is before delimiter in string
      *          After this operation data which are returned are removed from buffer
+     *          Scanning continues from position where previous call ended, so every received
+     *              character is examined only once while line is arriving
+     *          Scanning and removal run in critical section, scanner is shared with RX IRQ (see Line_notification)
      *
      * @param delimiter     Delimiter which borders which part of string is read
-     * @return string       Message from start of buffer to delimiter (delimiter is included)
+     * @return Text         Message from start of buffer to delimiter (delimiter is included)
+     */
+    Text Read(std::string_view delimiter);
+
+    /**
+     * @brief   Check if RX buffer contains delimiter, buffer is not modified
+     *
+     * @param delimiter     Delimiter which borders line
+     * @return true         Complete line is available and can be read by Read(delimiter)
+     * @return false        Delimiter was not received yet
+     */
+    bool Line_available(std::string_view delimiter);
+
+    /**
+     * @brief   Register callback which is invoked when line terminated by delimiter is available
+     *          Callback is invoked from context which receives data (usually IRQ) and
+     *              again after Read(delimiter) if next line is already in buffer
+     *
+     * @param delimiter Delimiter which borders line
+     * @param callback  Callback to invoke, nullptr disables notification
+     */
+    void Line_notification(std::string_view delimiter, Invocation_wrapper_base<void, void> *callback);
+
+    /**
+     * @brief   Register callback which is invoked when transmission of all sent messages is completed
+     *          Callback is invoked from context of transmission (usually IRQ), used to feed line by next message
+     *
+     * @param callback  Callback to invoke, nullptr disables notification
+     */
+    void Transmit_notification(Invocation_wrapper_base<void, void> *callback){ transmit_callback = callback; };
+
+    /**
+     * @brief   Register callback which is invoked after every received data and completed transmission
+     *          Callback is invoked from IRQ, usually wakes main loop which sleeps:
+     *              Invocation_wrapper<Run_loop, void, void> wake(&loop, &Run_loop::Wake);
+     *              uart.Wake_notification(&wake);
+     *
+     * @param callback  Callback to invoke, nullptr disables notification
+     */
+    void Wake_notification(Invocation_wrapper_base<void, void> *callback){ wake_callback = callback; };
+
+    /**
+     * @brief   Return true if previously sent messages are still transmitted
+     *          Lines which transmit synchronously are never busy
      */
-    string Read(string delimiter);
+    virtual bool Busy() const { return false; };
 
     /**
      * @brief   Return number of characters in RX buffer
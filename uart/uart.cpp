@@ -1,43 +1,179 @@
 #include "uart.hpp"
 
-UART::UART(UART_HandleTypeDef *UART_Handler_set){
+#include "misc/critical_section.hpp"
+#include "misc/probe.hpp"
+#include "trace/bus_trace.hpp"
+
+UART::UART(UART_HandleTypeDef *UART_Handler_set, uint8_t index) :
+    index(index)
+{
     UART_Handler = UART_Handler_set;
+    instances.Insert(UART_Handler, this);
+    TX_buffer.reserve(HALUP_UART_QUEUE);
 
     //HAL_UART_Receive_IT(UART_Handler_set, UART_buffer_temp, 1);
 }
 
-int UART::Send(string message){
+UART::~UART(){
+    if (Of(UART_Handler) == this) {
+        instances.Erase(UART_Handler);
+    }
+}
+
+int UART::Send(Text message){
+    HALUP_PROBE("uart.send");
     if (message.length() == 0) {
         return 0;
     }
-    // Save message to buffer if UART is now busy
+    if (!Await_space()) {
+        return -1;
+    }
+    // Transmission complete IRQ removes messages from front of buffer, producer in IRQ can add them
+    Critical_section section;
+    if (!Admit()) {
+        return -1;
+    }
+    TX_buffer.emplace_back(std::move(message));
+    return Queued();
+}
+
+int UART::Send(const char *data, size_t length){
+    HALUP_PROBE("uart.send");
+    if (length == 0) {
+        return 0;
+    }
+    if (!Await_space()) {
+        return -1;
+    }
+    Critical_section section;
+    if (!Admit()) {
+        return -1;
+    }
+    TX_buffer.emplace_back(data, length);
+    return Queued();
+}
+
+int UART::Queued(){
+    // Message waits in buffer if UART is now busy
     if (busy) {
-        TX_buffer.emplace_back(message);
         return TX_buffer.size();
     }
     // Send message and set UART as busy
     busy = true;
-    TX_buffer.emplace_back(message);
-    HAL_UART_Transmit_IT(UART_Handler, (unsigned char *) TX_buffer.front().c_str(), TX_buffer.front().length());
-    return message.length();
+    Transmit_front();
+    return TX_buffer.front().length();
 }
 
-int UART::Send_pool(string message){
-    return HAL_UART_Transmit(UART_Handler, (unsigned char *) message.c_str(), message.length(), HAL_MAX_DELAY);
+bool UART::Await_space(){
+    if (overflow != Overflow::Block || TX_buffer.size() < HALUP_UART_QUEUE) {
+        return true;
+    }
+    // Space is released by transmission complete IRQ, which cannot preempt IRQ waiting for it
+    if (__get_IPSR() != 0) {
+        return false;
+    }
+    // Transmission complete IRQ also wakes core
+    uint32_t start = HAL_GetTick();
+    while (TX_buffer.size() >= HALUP_UART_QUEUE) {
+        if (HAL_GetTick() - start >= block_timeout) {
+            return false;
+        }
+        __WFI();
+    }
+    return true;
+}
+
+bool UART::Admit(){
+    if (TX_buffer.size() < HALUP_UART_QUEUE) {
+        return true;
+    }
+    switch (overflow) {
+        case Overflow::Drop_oldest: {
+            // Message in front is just transmitted, oldest waiting message follows it
+            size_t oldest = busy ? 1 : 0;
+            if (TX_buffer.size() > oldest) {
+                TX_buffer.erase(TX_buffer.begin() + oldest);
+                dropped++;
+            }
+            return TX_buffer.size() < HALUP_UART_QUEUE;
+        }
+        case Overflow::Drop_newest:
+            dropped++;
+            return false;
+        default:
+            // Space released by Await_space was taken by producer in IRQ
+            return false;
+    }
+}
+
+void UART::Transmit_front(){
+    // Software CTS, transmission continues by Clear_to_send
+    if (cts && cts->Read()) {
+        stalled = true;
+        return;
+    }
+    transmit_start = Bus_trace::Start();
+    HAL_StatusTypeDef status = HAL_UART_Transmit_IT(UART_Handler, (unsigned char *) TX_buffer.front().c_str(), TX_buffer.front().length());
+    // Successful transmission is recorded after it is completed in Resend
+    if (status != HAL_OK) {
+        Bus_trace::Record(Trace::Bus::UART, index, 0, Trace::Operation::Transmit, status, UART_Handler->ErrorCode, TX_buffer.front().length(), transmit_start);
+    }
+}
+
+int UART::Send_pool(Text message){
+    uint32_t start = Bus_trace::Start();
+    HAL_StatusTypeDef status = HAL_UART_Transmit(UART_Handler, (unsigned char *) message.c_str(), message.length(), HAL_MAX_DELAY);
+    Bus_trace::Record(Trace::Bus::UART, index, 0, Trace::Operation::Transmit, status, UART_Handler->ErrorCode, message.length(), start);
+    return status;
 }
 
 int UART::Receive(){
+    HALUP_PROBE("uart.receive");
     RX_buffer.push_back(UART_buffer_temp[0]);
+    if (rts && !throttled && RX_buffer.size() >= rx_high) {
+        rts->Set(true);
+        throttled = true;
+    }
+    Received();
     HAL_UART_Receive_IT(UART_Handler, UART_buffer_temp, 1);
     return 0;
 }
 
 int UART::Resend(){
+    Bus_trace::Record(Trace::Bus::UART, index, 0, Trace::Operation::Transmit, HAL_OK, UART_Handler->ErrorCode, TX_buffer.front().length(), transmit_start);
     TX_buffer.erase(TX_buffer.begin()); // Erase message which transfer is complete
     if (TX_buffer.size() > 0) {         // Send next message in line
-        HAL_UART_Transmit_IT(UART_Handler, (unsigned char *) TX_buffer.front().c_str(), TX_buffer.front().length());
+        Transmit_front();
     } else  { // Now is UART unoccupied
         busy = false;
+        Transmitted();
     }
     return TX_buffer.size();
 }
+
+void UART::Flow_control(Pin *rts, Pin *cts, size_t rx_high, size_t rx_low){
+    this->rts = rts;
+    this->cts = cts;
+    this->rx_high = rx_high;
+    this->rx_low = rx_low;
+    throttled = false;
+    if (rts) {
+        rts->Set(false);
+    }
+}
+
+void UART::Consumed(){
+    Critical_section section;
+    if (throttled && RX_buffer.size() <= rx_low) {
+        rts->Set(false);
+        throttled = false;
+    }
+}
+
+void UART::Clear_to_send(){
+    Critical_section section;
+    if (stalled && !(cts && cts->Read())) {
+        stalled = false;
+        Transmit_front();
+    }
+}
@@ -31,22 +31,59 @@
 #include <vector>
 #include <string>
 
+#include "gpio/pin.hpp"
+#include "misc/handle_map.hpp"
 #include "uart/serial_line.hpp"
 
 using namespace std;
 
+/**
+ * @brief   Maximal number of messages waiting for transmission by UART, including transmitted one
+ *          Limit applies also to normal build, so memory of TX buffer cannot grow by fast producer
+ */
+#ifndef HALUP_UART_QUEUE
+#define HALUP_UART_QUEUE 8
+#endif
+
+/**
+ * @brief   Maximal number of UART objects which receive HAL callbacks
+ */
+#ifndef HALUP_UARTS
+#define HALUP_UARTS 4
+#endif
+
 /**
  * @brief   Perform communication over peripheral UART of MCU
  *          Contains HAL handler which is used to configuration and transmition
  *          Supports IRQ via IRQ Handler which is invocated after receiving of a byte
  *          Received bytes are stored as string and can be read out by length or delimeter
+ *          Object is registered under its HAL handle, HAL callbacks find it by UART::Of (see misc/hal_callbacks.hpp)
+ *          TX buffer holds at most HALUP_UART_QUEUE messages, behavior of Send with full buffer is selected by Overflow
+ *          Flow control by RTS/CTS:
+ *              Hardware flow control of peripheral (HwFlowCtl in CubeMX) pauses transmission per byte and needs no support
+ *              Software RTS pin is deasserted when RX buffer reaches high threshold and asserted again
+ *                  when reading drops it to low threshold, difference between high threshold and capacity
+ *                  of RX buffer must cover bytes which sender transmits before it reacts
+ *              Software CTS pin is checked before every message, transmission continues by Clear_to_send()
+ *                  called from EXTI callback of CTS pin
  */
 class UART: public Serial_line {
+public:
+    /**
+     * @brief   Behavior of Send when TX buffer is full
+     */
+    enum class Overflow: uint8_t {
+        Would_block,    // Message is rejected, caller can retry later
+        Drop_newest,    // Message is rejected and counted as dropped
+        Drop_oldest,    // Oldest message waiting for transmission is dropped in favor of new one
+        Block,          // Send waits until message fits or timeout expires, message is rejected when sent from IRQ
+    };
+
 private:
     /**
      * @brief Pointer to HAL handler structure which is passed in constructor
      */
-    UART_HandleTypeDef *UART_Handler;
+    UART_HandleTypeDef *UART_Handler = nullptr;
 
     /**
      * @brief Temporal buffer to which are saved data during receive
@@ -56,13 +93,102 @@ private:
     /**
      * @brief Vector of messages which are wainting to be send over UART
      */
-    vector<string> TX_buffer;
+    Bounded_vector<Text, HALUP_UART_QUEUE> TX_buffer;
 
     /**
      * @brief Status flag of UART, if true is something is currently transmitted
      */
     bool busy = false;
 
+    /**
+     * @brief Behavior of Send when TX buffer is full
+     */
+    Overflow overflow = Overflow::Would_block;
+
+    /**
+     * @brief Timeout of blocking Send in ms
+     */
+    uint32_t block_timeout = 0;
+
+    /**
+     * @brief Number of messages dropped due to full TX buffer
+     */
+    uint32_t dropped = 0;
+
+    /**
+     * @brief Output request to send, active low, null if not used
+     */
+    Pin *rts = nullptr;
+
+    /**
+     * @brief Input clear to send, active low, null if not used
+     */
+    Pin *cts = nullptr;
+
+    /**
+     * @brief Size of RX buffer at which is RTS deasserted and at which is asserted again
+     */
+    size_t rx_high = 0;
+    size_t rx_low = 0;
+
+    /**
+     * @brief RTS is deasserted, sender should pause
+     */
+    volatile bool throttled = false;
+
+    /**
+     * @brief Transmission waits for CTS
+     */
+    volatile bool stalled = false;
+
+    /**
+     * @brief Index of UART in records of Bus_trace
+     */
+    uint8_t index = 0;
+
+    /**
+     * @brief Timestamp of start of currently transmitted message, used by Bus_trace
+     */
+    uint32_t transmit_start = 0;
+
+    /**
+     * @brief Objects of UARTs indexed by their HAL handles
+     */
+    static inline Handle_map<UART_HandleTypeDef, UART *, HALUP_UARTS> instances;
+
+    /**
+     * @brief Start transmission of first message in TX buffer
+     */
+    void Transmit_front();
+
+    /**
+     * @brief Start transmission of message added to end of TX buffer if UART is idle
+     *
+     * @return int  Length of started message or size of TX buffer if UART is busy
+     */
+    int Queued();
+
+    /**
+     * @brief Wait for space in TX buffer if overflow policy is Block, waiting is refused inside IRQ
+     *
+     * @return true     Buffer has space or policy does not block
+     * @return false    Timeout expired or called from IRQ
+     */
+    bool Await_space();
+
+    /**
+     * @brief Make space for new message in TX buffer according to overflow policy, called with disabled interrupts
+     *
+     * @return true     Message can be added
+     * @return false    Message is rejected
+     */
+    bool Admit();
+
+    /**
+     * @brief Assert RTS after reading of RX buffer if reception was throttled
+     */
+    virtual void Consumed() override final;
+
 public:
     /**
      * @brief Construct a new UART object
@@ -73,18 +199,50 @@ public:
      * @brief Construct a new UART object
      *
      * @param UART_Handler_set Pointer to HAL Handler structure generated by CubeMX
+     * @param index            Index of UART in records of Bus_trace
+     */
+    UART(UART_HandleTypeDef *UART_Handler_set, uint8_t index = 0);
+
+    /**
+     * @brief   Remove UART from routing of HAL callbacks
      */
-    UART(UART_HandleTypeDef *UART_Handler_set);
+    ~UART();
+
+    // HAL callbacks keep address of object, IRQ transfer uses TX buffer of object
+    UART(const UART &) = delete;
+    UART &operator=(const UART &) = delete;
+
+    /**
+     * @brief   Return UART object of HAL handle, used by HAL callbacks
+     *
+     * @param handle    Handle which triggered callback
+     * @return UART*    Object constructed with handle, null if there is no such object
+     */
+    static UART *Of(const UART_HandleTypeDef *handle){
+        UART **instance = instances.Find(handle);
+        return instance ? *instance : nullptr;
+    };
 
     /**
      * @brief Transmitt C++ string over UART char by char
      *
      * @param message   Message to send
-     * @return int      Error code
+     * @return int      Error code, -1 if message was rejected due to full TX buffer
      */
-    virtual int Send(string message) override final;
+    virtual int Send(Text message) override final;
 
-    int Send_pool(string message);
+    /**
+     * @brief Transmitt characters over UART, characters are copied directly into TX buffer
+     *
+     * @param data      Characters to send
+     * @param length    Number of characters
+     * @return int      Error code, -1 if message was rejected due to full TX buffer
+     */
+    virtual int Send(const char *data, size_t length) override final;
+
+    using Serial_line::Send;
+
+    int Send_pool(Text message);
 
     /**
      * @brief   After IRQ occurs will copy received character from temporal buffer to internal RX buffer
@@ -97,26 +255,55 @@ public:
      * @brief   Routine which is called when transmittion is done, will check if buffer contains
      *              another content to send, if yes will send it.
      *          Must be public method because is called from HAL IRQ handler HAL_UART_TxCpltCallback,
-     *              which is outside of namespace of this class
+     *              which finds object by UART::Of
      *
      * @return int  Actual size of transmitt buffer
      */
     int Resend();
-};
 
-/**
- * @brief   Callback called by HAL after any receive IRQ occurs
- *          This callback is shared by all UARTs
- *
- * @param huart Reference to handler of UART which triggered the IRQ RX callback
- */
-//void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+    /**
+     * @brief   Return true if transmission is in progress, UART must not enter Stop mode meanwhile
+     *
+     * @return true     Message is transmitted
+     * @return false    UART is idle
+     */
+    virtual bool Busy() const override final { return busy; };
 
-/**
- * @brief   Callback called after buffer is transmitted
- *          This callback is shared by all UARTs
- *          Is used for notification that another transmittion can start now
- *
- * @param huart Reference to handler of UART which triggered the IRQ TX callback
- */
-//void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart); // Callback called after any send
+    /**
+     * @brief   Select behavior of Send when TX buffer is full
+     *
+     * @param policy    Overflow policy
+     * @param timeout   Timeout of policy Block in ms
+     */
+    void Overflow_policy(Overflow policy, uint32_t timeout = 0){ overflow = policy; block_timeout = timeout; };
+
+    /**
+     * @brief   Enable software flow control by GPIO pins, both signals are active low
+     *
+     * @param rts       Output request to send, null if not used
+     * @param cts       Input clear to send, null if not used
+     * @param rx_high   Size of RX buffer at which is RTS deasserted
+     * @param rx_low    Size of RX buffer at which is RTS asserted again
+     */
+    void Flow_control(Pin *rts, Pin *cts, size_t rx_high = HALUP_SERIAL_BUFFER * 3 / 4, size_t rx_low = HALUP_SERIAL_BUFFER / 4);
+
+    /**
+     * @brief   Continue transmission which waits for CTS, must be called from EXTI callback of CTS pin
+     */
+    void Clear_to_send();
+
+    /**
+     * @brief   Return number of messages dropped due to full TX buffer
+     */
+    uint32_t Dropped() const { return dropped; };
+
+    /**
+     * @brief   Return number of messages in TX buffer including transmitted one
+     */
+    size_t Queue_size() const { return TX_buffer.size(); };
+
+    /**
+     * @brief   Return true if RTS is deasserted due to full RX buffer
+     */
+    bool Throttled() const { return throttled; };
+};
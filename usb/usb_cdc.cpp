@@ -0,0 +1,142 @@
+#include "usb_cdc.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "misc/critical_section.hpp"
+#include "misc/probe.hpp"
+
+USB_CDC::USB_CDC(USBD_HandleTypeDef *handle) :
+    handle(handle)
+{
+    instance = this;
+    Critical_section section;
+    Arm_receive();
+}
+
+USB_CDC::~USB_CDC(){
+    if (instance == this) {
+        instance = nullptr;
+    }
+}
+
+int USB_CDC::Send(const char *data, size_t length){
+    HALUP_PROBE("usb.send");
+    if (length == 0) {
+        return 0;
+    }
+    Critical_section section;
+    if (length > HALUP_USB_TX_BUFFER - tx_count) {
+        statistics.rejected++;
+        return -1;
+    }
+    if (tx_count == 0) {
+        pending_since = HAL_GetTick();
+    }
+    size_t first = std::min<size_t>(length, HALUP_USB_TX_BUFFER - tx_head);
+    std::memcpy(tx_ring + tx_head, data, first);
+    std::memcpy(tx_ring, data + first, length - first);
+    tx_head = (tx_head + length) % HALUP_USB_TX_BUFFER;
+    tx_count += length;
+    Transmit_next(flush_timeout == 0);
+    return length;
+}
+
+void USB_CDC::Transmit_next(bool force){
+    if (transmitting || handle == nullptr) {
+        return;
+    }
+
+    if (tx_count == 0) {
+#if HALUP_USB_ZLP
+        // Host completes read only by short packet, stream which stops at end of full packet is terminated by ZLP
+        if (unterminated) {
+            USBD_CDC_SetTxBuffer(handle, transfer, 0);
+            if (USBD_CDC_TransmitPacket(handle) == USBD_OK) {
+                transmitting = true;
+                unterminated = false;
+                statistics.zlps++;
+                statistics.packets++;
+            }
+        }
+#endif
+        return;
+    }
+
+    // Full packets are transmitted immediately, rest waits for more data until flush timeout
+    size_t length = std::min<size_t>(tx_count, HALUP_USB_TRANSFER);
+    if (length >= packet_size) {
+        length -= length % packet_size;
+    } else if (!force && (HAL_GetTick() - pending_since) < flush_timeout) {
+        return;
+    }
+
+    size_t first = std::min<size_t>(length, HALUP_USB_TX_BUFFER - tx_tail);
+    std::memcpy(transfer, tx_ring + tx_tail, first);
+    std::memcpy(transfer + first, tx_ring, length - first);
+    USBD_CDC_SetTxBuffer(handle, transfer, length);
+    // Device is not configured or endpoint is busy, data stay in buffer for next attempt
+    if (USBD_CDC_TransmitPacket(handle) != USBD_OK) {
+        return;
+    }
+
+    tx_tail = (tx_tail + length) % HALUP_USB_TX_BUFFER;
+    tx_count -= length;
+    transmitting = true;
+    unterminated = (length % packet_size == 0);
+    statistics.transfers++;
+    statistics.packets += (length + packet_size - 1) / packet_size;
+    if (length < packet_size) {
+        statistics.flushes++;
+    }
+}
+
+void USB_CDC::Flush(){
+    Critical_section section;
+    Transmit_next(true);
+}
+
+void USB_CDC::Tick(){
+    Critical_section section;
+    Transmit_next(false);
+}
+
+void USB_CDC::Packet_transmitted(){
+    {
+        Critical_section section;
+        transmitting = false;
+        Transmit_next(false);
+    }
+    if (!Busy()) {
+        Transmitted();
+    }
+}
+
+void USB_CDC::Arm_receive(){
+    if (receiving || handle == nullptr) {
+        return;
+    }
+    // Packet which would not fit into RX buffer is NAKed by endpoint until buffer is read
+    if (RX_buffer.size() + packet_size > HALUP_SERIAL_BUFFER) {
+        return;
+    }
+    USBD_CDC_SetRxBuffer(handle, rx_packet);
+    if (USBD_CDC_ReceivePacket(handle) == USBD_OK) {
+        receiving = true;
+    }
+}
+
+void USB_CDC::Packet_received(const uint8_t *data, uint32_t length){
+    HALUP_PROBE("usb.receive");
+    receiving = false;
+    RX_buffer.append(reinterpret_cast<const char *>(data), length);
+    statistics.received++;
+    Received();
+    Critical_section section;
+    Arm_receive();
+}
+
+void USB_CDC::Consumed(){
+    Critical_section section;
+    Arm_receive();
+}
@@ -0,0 +1,260 @@
+/**
+ * @file usb_cdc.hpp
+ * @author Petr Malaník (TheColonelYoung(at)gmail(dot)com)
+ * @version 0.1
+ * @date 18.10.2026
+ */
+
+#pragma once
+
+#include "global_includes.hpp"
+
+#ifndef MCU_FAMILY_HOST
+# include "usbd_cdc.h"
+#endif
+
+#include <cstdint>
+
+#include "uart/serial_line.hpp"
+
+/**
+ * @brief   Size of TX buffer of USB CDC in bytes, messages are batched in it into packets
+ */
+#ifndef HALUP_USB_TX_BUFFER
+#define HALUP_USB_TX_BUFFER 1024
+#endif
+
+/**
+ * @brief   Maximal length of one transfer to host in bytes, multiple of packet size
+ */
+#ifndef HALUP_USB_TRANSFER
+#define HALUP_USB_TRANSFER 512
+#endif
+
+/**
+ * @brief   Time in ms after which incomplete packet is transmitted
+ */
+#ifndef HALUP_USB_FLUSH_TIMEOUT
+#define HALUP_USB_FLUSH_TIMEOUT 1
+#endif
+
+/**
+ * @brief   Transfer which ends by full packet is terminated by ZLP sent by library
+ *          Set to 0 if CDC class of USB device library sends ZLP by itself (newer versions of middleware)
+ */
+#ifndef HALUP_USB_ZLP
+#define HALUP_USB_ZLP 1
+#endif
+
+/**
+ * @brief   Serial line over USB CDC (virtual COM port), uses CDC class of USB device library generated by CubeMX
+ *          Sent messages are collected in TX buffer and transmitted as transfers of full packets of 64 bytes,
+ *              incomplete packet is transmitted after flush timeout, Flush() or when endpoint becomes idle after timeout
+ *          Host completes its read after short packet, so transfer which ends by full packet is terminated by ZLP
+ *          Received packets are appended into RX buffer at once, next packet is accepted only if it fits into
+ *              HALUP_SERIAL_BUFFER, otherwise host is NAKed until data are read, so no received data are lost
+ *          Callbacks of CDC interface in usbd_cdc_if.c must forward events to object:
+ *              static int8_t CDC_Receive_FS(uint8_t *Buf, uint32_t *Len){
+ *                  if (USB_CDC *cdc = USB_CDC::Of(&hUsbDeviceFS)) cdc->Packet_received(Buf, *Len);
+ *                  return USBD_OK;
+ *              }
+ *              static int8_t CDC_TransmitCplt_FS(uint8_t *Buf, uint32_t *Len, uint8_t epnum){
+ *                  if (USB_CDC *cdc = USB_CDC::Of(&hUsbDeviceFS)) cdc->Packet_transmitted();
+ *                  return USBD_OK;
+ *              }
+ *          Flush timeout is checked by Tick(), which is called periodically, for example from HAL_SYSTICK_Callback
+ */
+class USB_CDC: public Serial_line {
+public:
+    /**
+     * @brief   Maximal size of bulk packet of full speed device
+     */
+    static constexpr uint16_t packet_size = 64;
+
+    static_assert(HALUP_USB_TRANSFER % packet_size == 0, "Transfer must consist of full packets");
+    static_assert(HALUP_USB_TRANSFER <= HALUP_USB_TX_BUFFER, "Transfer must fit into TX buffer");
+
+    /**
+     * @brief   Counters of USB CDC activity
+     */
+    struct Statistics {
+        uint32_t transfers  = 0;
+        uint32_t packets    = 0;    // Packets of transfers including ZLP
+        uint32_t zlps       = 0;
+        uint32_t flushes    = 0;    // Transfers of incomplete packet
+        uint32_t rejected   = 0;    // Messages which did not fit into TX buffer
+        uint32_t received   = 0;    // Received packets
+    };
+
+private:
+    /**
+     * @brief   Handle of USB device
+     */
+    USBD_HandleTypeDef *handle = nullptr;
+
+    /**
+     * @brief   Ring buffer of bytes waiting for transmission
+     */
+    uint8_t tx_ring[HALUP_USB_TX_BUFFER];
+    size_t tx_head = 0;
+    size_t tx_tail = 0;
+    size_t tx_count = 0;
+
+    /**
+     * @brief   Data of running transfer, endpoint reads them during transfer
+     */
+    uint8_t transfer[HALUP_USB_TRANSFER];
+
+    /**
+     * @brief   Transfer or ZLP is in progress
+     */
+    volatile bool transmitting = false;
+
+    /**
+     * @brief   Last transfer ended by full packet, host waits for short packet or ZLP
+     */
+    bool unterminated = false;
+
+    /**
+     * @brief   Tick at which oldest byte waiting for transmission was sent
+     */
+    uint32_t pending_since = 0;
+
+    /**
+     * @brief   Time in ms after which incomplete packet is transmitted
+     */
+    uint32_t flush_timeout = HALUP_USB_FLUSH_TIMEOUT;
+
+    /**
+     * @brief   Buffer of received packet
+     */
+    uint8_t rx_packet[packet_size];
+
+    /**
+     * @brief   Reception of packet is armed
+     */
+    volatile bool receiving = false;
+
+    Statistics statistics;
+
+    /**
+     * @brief   Object which receives callbacks of CDC interface
+     */
+    static inline USB_CDC *instance = nullptr;
+
+    /**
+     * @brief   Start next transfer if endpoint is idle, must be called in critical section
+     *          Full packets are transmitted immediately, incomplete packet after flush timeout or if forced
+     *
+     * @param force     Transmit incomplete packet without waiting for timeout
+     */
+    void Transmit_next(bool force);
+
+    /**
+     * @brief   Arm reception of next packet if it fits into RX buffer, must be called in critical section
+     */
+    void Arm_receive();
+
+    /**
+     * @brief   Continue reception which was stopped due to full RX buffer
+     */
+    virtual void Consumed() override final;
+
+public:
+    /**
+     * @brief Construct a new USB_CDC object, reception is armed
+     *
+     * @param handle    Handle of USB device generated by CubeMX (hUsbDeviceFS)
+     */
+    USB_CDC(USBD_HandleTypeDef *handle);
+
+    /**
+     * @brief   Remove object from routing of CDC callbacks
+     */
+    ~USB_CDC();
+
+    // Callbacks of CDC interface keep address of object, endpoint reads buffer of object
+    USB_CDC(const USB_CDC &) = delete;
+    USB_CDC &operator=(const USB_CDC &) = delete;
+
+    /**
+     * @brief   Return object of USB device handle, used by callbacks of CDC interface
+     *
+     * @param handle    Handle of USB device
+     * @return USB_CDC* Object constructed with handle, null if there is no such object
+     */
+    static USB_CDC *Of(const USBD_HandleTypeDef *handle){
+        return (instance && instance->handle == handle) ? instance : nullptr;
+    };
+
+    /**
+     * @brief   Copy message into TX buffer, transmission starts when full packet is collected or after flush timeout
+     *
+     * @param message   Message to send
+     * @return int      Length of message, -1 if message does not fit into TX buffer
+     */
+    virtual int Send(Text message) override final { return Send(message.data(), message.size()); };
+
+    /**
+     * @brief   Copy characters into TX buffer, transmission starts when full packet is collected or after flush timeout
+     *
+     * @param data      Characters to send
+     * @param length    Number of characters
+     * @return int      Number of characters, -1 if characters do not fit into TX buffer
+     */
+    virtual int Send(const char *data, size_t length) override final;
+
+    using Serial_line::Send;
+
+    /**
+     * @brief   Received packets are added into RX buffer by Packet_received
+     *
+     * @return int  Actual size of RX buffer
+     */
+    virtual int Receive() override final { return RX_buffer.size(); };
+
+    /**
+     * @brief   Return true if transfer is in progress or data wait for transmission
+     */
+    virtual bool Busy() const override final { return transmitting || tx_count > 0; };
+
+    /**
+     * @brief   Transmit incomplete packet without waiting for flush timeout
+     */
+    void Flush();
+
+    /**
+     * @brief   Transmit incomplete packet if flush timeout expired, must be called periodically
+     */
+    void Tick();
+
+    /**
+     * @brief   Set time after which incomplete packet is transmitted
+     *
+     * @param timeout   Timeout in ms, 0 transmits every message as soon as endpoint is idle
+     */
+    void Flush_timeout(uint32_t timeout){ flush_timeout = timeout; };
+
+    /**
+     * @brief   Append received packet into RX buffer, called from CDC_Receive_FS
+     *
+     * @param data      Received data
+     * @param length    Length of packet
+     */
+    void Packet_received(const uint8_t *data, uint32_t length);
+
+    /**
+     * @brief   Continue with next transfer, called from CDC_TransmitCplt_FS
+     */
+    void Packet_transmitted();
+
+    /**
+     * @brief   Return number of bytes waiting for transmission
+     */
+    size_t Queued() const { return tx_count; };
+
+    /**
+     * @brief   Return counters of USB CDC activity
+     */
+    const Statistics &Stats() const { return statistics; };
+};